@@ -13,16 +13,31 @@
 #include <time.h> 
 #include "Globals/Font.h"
 #include "Globals/Display.h"
+#include "Globals/Worker.h"
+#include "Globals/TextRenderer.h"
+#include "Globals/TexturePool.h"
+#include "Globals/Animation.h"
+#include "Globals/TextureCache.h"
 
 #include "Music/MusicLoader/MusicLoader.h"
 #include "Music/MusicPlayer/MusicPlayer.h"
 #include "Interactables/Interactables.h"
 #include "Interactables/ListInteractables.h"
-#include "Music/MusicDisplayer/MusicDisplayer.h"    //Displaying music
+#include "Interactables/Layout.h"
+#include "Interactables/WidgetPool.h"
+#include "Music/MusicDisplayer/PlayerInterface.h"    //The UI
 #include "MouseController/MouseController.h"    //Mouse events
+#include "Instrumentation/FrameProfiler.h"    //Frame timings
+#include "Benchmark/Benchmark.h"    //Benchmarks
 
+//How often the player is polled while a song plays (ms)
+#define PLAYING_FRAME_MS 20
+
+int main(int argc, char* argv[]) {
+    //Runs a benchmark instead of the player, "--benchmark <name>"
+    if (argc >= 2 && SDL_strcmp(argv[1], "--benchmark") == 0)
+        return Benchmark::run(argc >= 3 ? argv[2] : "all", std::vector<std::string>(argv + SDL_min(argc, 3), argv + argc));
 
-int main() {
     //Initializing SDL and it's subsets
     if (SDL_Init(SDL_INIT_EVERYTHING) != 0)
         std::cout << "Error initializing SDL2 " << SDL_GetError();
@@ -49,6 +64,18 @@ int main() {
     //Sets the minimum window size
     SDL_SetWindowMinimumSize(Display::getWindow(), 400, 400);
 
+    //Lays the UI out in the window
+    Layout::beginFrame(Display::getWidth(), Display::getHeight());
+
+    //Starts the background worker (prefetching, loading)
+    Worker::init();
+
+    //Decodes the button images while everything else loads
+    TextureCache::preload("Images/pauseButton.png");
+    TextureCache::preload("Images/playButton.png");
+    TextureCache::preload("Images/skipButton.png");
+    TextureCache::preload("Images/backButton.png");
+
     //Initializing the MusicPlayer
     MusicPlayer::init();
     MusicPlayer::setVolumeLinear(0.3);
@@ -57,96 +84,15 @@ int main() {
     MusicLoader::init();
     MusicLoader::getMusicListFromFolder("Music");
 
-    //Interupt to delete music whenever it finishs playing
-    Mix_HookMusicFinished(MusicPlayer::deleteMusicTrack);
-
     //Initializing the Font
     Font::init();
     Font::loadFont("Fonts/OpenSans-Bold.ttf", FontName::UIFont);
 
-    //The interactable manager
-    InteractableManager* interactableManager = new InteractableManager();
-
-    /// Bottom Audio Controls Container
-
-    ContainerInteractable* container = new ContainerInteractable();
-
-    //Sets the Color
-    container->setPrimaryColor(50, 50, 50, 255);
-    container->setX(CordType::PercentageWidth, 0.5f);
-    container->setY(CordType::PixelFromBottomEdge, 75);
-    container->setW(CordType::Pixel, 400);
-    container->setH(CordType::Pixel, 125);
-    //Centers the Container
-    container->setRenderStyle(RenderStyle::Centered);
-
-    interactableManager->addInteractable(container);
-
-    ///Play / Pause button   
-
-    //Makes the pauseButton
-    PlayPauseInteractable* pauseButton = new PlayPauseInteractable();
-
-    //Sets the position of the pauseButton
-    pauseButton->setX(CordType::PercentageWidth, 0.5);
-    pauseButton->setY(CordType::Pixel, 40);
-    pauseButton->setW(CordType::Pixel, 50);
-    pauseButton->setH(CordType::Pixel, 50);
-
-    container->addInteractable(pauseButton);
-
-    /// Skip forward button
-
-    SkipForwardInteractable* skipForwardButton = new SkipForwardInteractable();
-
-    //Sets the position of the Skip forward
-    skipForwardButton->setX(CordType::PercentageWidth, 0.75);
-    skipForwardButton->setY(CordType::Pixel, 40);
-    skipForwardButton->setW(CordType::Pixel, 50);
-    skipForwardButton->setH(CordType::Pixel, 50);
-
-    container->addInteractable(skipForwardButton);
-
-    /// Skip backward button
+    //Initializes the glyph atlas text is drawn from
+    TextRenderer::init();
 
-    SkipBackwardInteractable* skipBackwardButton = new SkipBackwardInteractable();
-
-    //Sets the position of the Skip forward
-    skipBackwardButton->setX(CordType::PercentageWidth, 0.25);
-    skipBackwardButton->setY(CordType::Pixel, 40);
-    skipBackwardButton->setW(CordType::Pixel, 50);
-    skipBackwardButton->setH(CordType::Pixel, 50);
-
-    container->addInteractable(skipBackwardButton);
-
-    /// Volume Interactable
-
-    //Makes the Volume interactable
-    VolumeInteractable* volume = new VolumeInteractable();
-
-    //Sets the position of the volume
-    volume->setX(CordType::PercentageWidth, 0.5);
-    volume->setY(CordType::Pixel, 100);
-    volume->setW(CordType::Pixel, 300);
-    volume->setH(CordType::Pixel, 40);
-    //Centers the volume
-    volume->setRenderStyle(RenderStyle::Centered);
-
-    container->addInteractable(volume);
-
-    /// Music List
-
-    MusicListInteractable* musicList = new MusicListInteractable();
-    
-    musicList->setX(CordType::PercentageWidth, 0);
-    musicList->setY(CordType::PercentageHeight, 0);
-    musicList->setW(CordType::PercentageWidth, 1);
-    musicList->setH(CordType::PixelFromBottomEdge, 150);
-
-    musicList->setRenderStyle(RenderStyle::None);
-    musicList->addMusic(MusicLoader::getSongData());
-
-    interactableManager->addInteractable(musicList);
+    //Builds the UI
+    InteractableManager* interactableManager = PlayerInterface::build(MusicLoader::getSongData());
 
     //Sets the window Icon
     SDL_Surface* icon = IMG_Load("Clef.png");
@@ -154,30 +100,86 @@ int main() {
 
     //Main loop
     while (!Input::getExit()) {
-        //Clears the window
-        Display::clear();
+        //Sleeps until there's an event, or something asked for a frame
+        Display::waitForFrame();
+        FrameProfiler::beginFrame();
+
+        //Reads the window's size once, the layout is redone if it changed
+        int displayWidth, displayHeight;
+        Display::getSize(displayWidth, displayHeight);
+        Layout::beginFrame(displayWidth, displayHeight);
+
+        //Steps the animations that are due
+        Animation::update();
 
         //Updates the input handler
-        Input::update(interactableManager);
+        {
+            ScopeTimer timer(ProfilePhase::Input);
+            Input::update(interactableManager);
+        }
 
-        //Updates the UI
-        interactableManager->updateInteractables();
-        interactableManager->render();
+        //Updates the music player
+        MusicPlayer::update();
+
+        //Keeps polling the player while a song plays, so it can move on when the song ends
+        if (MusicPlayer::getPlayingSongID() != -1 && !MusicPlayer::getPaused())
+            Display::requestFrame(PLAYING_FRAME_MS);
 
-        //Displays the window
-        Display::render();
+        //Updates the UI
+        {
+            ScopeTimer timer(ProfilePhase::Update);
+            interactableManager->updateInteractables();
+        }
+
+        //Redraws only what changed
+        SDL_Rect dirtyArea;
+        if (interactableManager->getDirtyArea(dirtyArea))
+            Display::invalidateArea(dirtyArea);
+
+        if (Display::getDirtyArea(dirtyArea)) {
+            {
+                ScopeTimer timer(ProfilePhase::Render);
+                //Clears the area being redrawn
+                Display::clear();
+
+                interactableManager->renderDirty(dirtyArea);
+            }
+
+            //Displays the window
+            ScopeTimer timer(ProfilePhase::Present);
+            Display::render();
+        }
+        else {
+            Display::skipFrame();
+        }
+
+        FrameProfiler::endFrame();
+
+        //Keeps a steady frame rate while anything animates
+        Animation::endFrame();
     }
 
 
     //Properly destroys all UI elements
     interactableManager->clear();
     delete interactableManager;
+    //Destroys the render targets the containers gave back
+    TexturePool::clear();
+    //Frees the memory the UI elements were made in
+    WidgetPool::clear();
 
+    //Stops the background worker, before the music player as it may still be loading tracks
+    Worker::close();
     //Close the music player
     MusicPlayer::close();
     //Closes the musicLoader
     MusicLoader::close();
 
+    //Destroys the images, once the worker can't be decoding any
+    TextureCache::clear();
+
+    //Frees the glyph atlas, before the fonts it was rasterized from
+    TextRenderer::close();
     //Close the font librrary
     Font::close();
     //Closes the display
@@ -0,0 +1,1260 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <memory_resource>
+#include <random>
+#include <vector>
+
+#include "SDL.h"
+#include "SDL_image.h"
+#include "SDL_mixer.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#include "Globals/Display.h"
+#include "Globals/Font.h"
+#include "Globals/TextRenderer.h"
+#include "Globals/TexturePool.h"
+#include "Globals/TextureCache.h"
+#include "Globals/Animation.h"
+#include "Globals/Worker.h"
+
+#include "Music/MusicPlayer/MusicPlayer.h"
+#include "Music/MusicPlayer/TimeStretcher.h"
+#include "Music/MusicPlayer/SilenceAnalyzer.h"
+#include "Music/MusicDecoder/Decoder.h"
+#include "Interactables/Interactables.h"
+#include "Interactables/Layout.h"
+#include "Interactables/Components.h"
+#include "Interactables/WidgetPool.h"
+#include "Music/MusicLoader/MusicLoader.h"
+#include "Music/MusicDisplayer/PlayerInterface.h"
+#include "Music/MusicDisplayer/MusicDisplayer.h"
+
+//The format of the generated audio
+#define SAMPLE_RATE 44100
+#define CHANNELS 2
+//The length of the generated audio (seconds)
+#define AUDIO_SECONDS 30
+//The frames read from a decoder in one go, like the pipeline's feeder
+#define DECODE_FRAMES 4096
+//The amount of random seeks timed per song
+#define SEEK_COUNT 20
+//The samples summed when checking the silence scan
+#define SILENCE_SAMPLES (1 << 20)
+//The times the samples are summed with each path
+#define SILENCE_RUNS 50
+//Where the generated song is written when no songs are given
+#define GENERATED_SONG "benchmark.wav"
+//The amount of widgets laid out
+#define LAYOUT_WIDGETS 10000
+//The frames timed for each layout case
+#define LAYOUT_FRAMES 100
+//The size of the display the widgets are laid out in
+#define LAYOUT_WIDTH 1280
+#define LAYOUT_HEIGHT 720
+//The height of each row in the laid out list
+#define LAYOUT_ROW_HEIGHT 75
+//The amount of widgets traversed
+#define TRAVERSE_WIDGETS 10000
+//The frames timed for each way of traversing
+#define TRAVERSE_FRAMES 200
+//The most bytes allocated between widgets, so they're spread over the heap like in a running player
+#define TRAVERSE_SCATTER 512
+//The rows in the list being edited
+#define CHURN_ROWS 10000
+//The rows removed, added and looked up each frame
+#define CHURN_CHANGES 2000
+//The frames timed while editing the list
+#define CHURN_FRAMES 100
+//The frames run for each scripted UI sequence
+#define UI_FRAMES 240
+//The size of the headless window the UI runs in, and the most it's resized to
+#define UI_WIDTH 500
+#define UI_HEIGHT 500
+#define UI_MAX_WIDTH 900
+#define UI_MAX_HEIGHT 700
+//The length of the song every synthetic song plays (seconds)
+#define UI_SONG_SECONDS 5
+//The time a frame has at 60 fps (ms)
+#define FRAME_BUDGET_MS (1000.0 / 60)
+//The widgets built when counting allocations
+#define ALLOC_WIDGETS 100000
+//The times the widgets are built and deleted, like the UI being rebuilt
+#define ALLOC_REBUILDS 5
+//The songs listed when counting allocations
+#define ALLOC_SONGS 100000
+
+//The sizes of the synthetic catalogs the UI is run with
+static const int UI_CATALOGS[] = { 1000, 10000, 100000 };
+
+/*
+* A benchmark that can be run by name
+*/
+struct BenchmarkEntry {
+	const char* name;
+	//Returns 0 if the benchmark passed, given the arguments after its name
+	int (*run)(const std::vector<std::string>& arguments);
+	//If "all" passes it the arguments too, the others run with their defaults
+	bool sharesArguments;
+};
+
+
+/*
+* Converts performance counter ticks to milliseconds
+*
+* @param ticks, The amount of ticks
+* @return double, The ticks in milliseconds
+*/
+static double ticksToMilliseconds(Uint64 ticks) {
+	return ticks * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+/*
+* Generates audio that resembles music, a chord with vibrato over some noise
+*
+* @param seconds, The length of the audio
+* @return std::vector<float>, The interleaved frames
+*/
+static std::vector<float> generateAudio(int seconds) {
+	int frames = SAMPLE_RATE * seconds;
+	std::vector<float> audio((size_t)frames * CHANNELS);
+
+	const float notes[] = { 220.0f, 277.2f, 329.6f, 440.0f };
+	Uint32 noise = 12345;
+	for (int frame = 0; frame < frames; frame++) {
+		float time = (float)frame / SAMPLE_RATE;
+		float vibrato = 1 + 0.003f * sinf(2 * (float)M_PI * 5 * time);
+
+		float sample = 0;
+		for (float note : notes)
+			sample += 0.15f * sinf(2 * (float)M_PI * note * vibrato * time);
+
+		//Cheap white noise
+		noise = noise * 1664525 + 1013904223;
+		sample += ((noise >> 9) / 8388608.0f - 1) * 0.02f;
+
+		for (int c = 0; c < CHANNELS; c++)
+			audio[(size_t)frame * CHANNELS + c] = sample;
+	}
+	return audio;
+}
+
+/*
+* Stretches the audio, like the pipeline does, timing how long it takes
+*
+* @param audio, The interleaved frames to stretch
+* @param speed, The speed to stretch at
+* @param pitch, The pitch to shift by
+* @param outputFrames, Set to the amount of frames produced
+* @return double, The time taken (ms)
+*/
+static double timeStretch(const std::vector<float>& audio, float speed, float pitch, int& outputFrames) {
+	TimeStretcher stretcher(CHANNELS, SAMPLE_RATE);
+	stretcher.setRate(speed, pitch);
+
+	std::vector<float> block((size_t)TimeStretcher::MAX_PUT_FRAMES * CHANNELS);
+	int frames = (int)(audio.size() / CHANNELS);
+	int position = 0;
+	outputFrames = 0;
+
+	Uint64 start = SDL_GetPerformanceCounter();
+	while (true) {
+		int count = SDL_min(stretcher.getInputSpace(), frames - position);
+		if (count > 0) {
+			stretcher.putSamples(audio.data() + (size_t)position * CHANNELS, count);
+			position += count;
+		}
+
+		int received = stretcher.receiveSamples(block.data(), TimeStretcher::MAX_PUT_FRAMES);
+		outputFrames += received;
+		if (position >= frames && received == 0) break;
+	}
+	return ticksToMilliseconds(SDL_GetPerformanceCounter() - start);
+}
+
+/*
+* Benchmarks the time-stretcher, with and without SIMD
+* Passes if every rate runs faster than real time on one core
+*
+* @return int, 0 if it kept up
+*/
+static int benchmarkStretch(const std::vector<std::string>&) {
+	std::vector<float> audio = generateAudio(AUDIO_SECONDS);
+
+	const PlaybackRate rates[] = { { 0.5f, 1 }, { 1.5f, 1 }, { 2, 1 }, { 2, 0.5f }, { 2, 2 } };
+	bool simdAvailable = SDL_HasSSE();
+
+	std::cout << "Time-stretch, " << AUDIO_SECONDS << " s of " << SAMPLE_RATE << " Hz stereo" << std::endl;
+	printf("%-6s %-6s %-7s %10s %10s %10s\n", "speed", "pitch", "simd", "out (s)", "time (ms)", "realtime");
+
+	int failed = 0;
+	for (const PlaybackRate& rate : rates) {
+		for (int simd = 0; simd <= (simdAvailable ? 1 : 0); simd++) {
+			TimeStretcher::setUseSIMD(simd == 1);
+
+			int outputFrames;
+			double time = timeStretch(audio, rate.speed, rate.pitch, outputFrames);
+			double outputSeconds = (double)outputFrames / SAMPLE_RATE;
+			//How many times faster than the audio plays
+			double realtime = outputSeconds * 1000 / SDL_max(time, 0.001);
+
+			printf("%-6.2f %-6.2f %-7s %10.2f %10.1f %9.1fx\n",
+				rate.speed, rate.pitch, (simd == 1 ? "on" : "off"), outputSeconds, time, realtime);
+
+			if (realtime < 1)
+				failed++;
+		}
+	}
+
+	TimeStretcher::setUseSIMD(true);
+	std::cout << (failed == 0 ? "Keeps up with real time" : "Falls behind real time") << std::endl;
+	return failed;
+}
+
+
+/*
+* Checks the silence scan's SIMD path against the scalar one, then times both
+* The samples include runs at full scale, the most a sum of squares can be
+* Passes if both paths give the same sums and the same bounds
+*
+* @return int, 0 if the paths agree
+*/
+static int benchmarkSilence(const std::vector<std::string>&) {
+	std::vector<Sint16> samples(SILENCE_SAMPLES);
+	Uint32 random = 12345;
+	for (size_t i = 0; i < samples.size(); i++) {
+		random = random * 1664525 + 1013904223;
+		samples[i] = (Sint16)(random >> 16);
+		//Every so often a run of full scale samples
+		if ((i / 64) % 16 == 0)
+			samples[i] = ((i & 1) != 0 ? 32767 : -32768);
+	}
+	//Quiet at the start and end, so the bounds have something to find
+	for (size_t i = 0; i < samples.size() / 8; i++) {
+		samples[i] /= 4096;
+		samples[samples.size() - 1 - i] /= 4096;
+	}
+
+	bool simdAvailable = SilenceAnalyzer::getUseSIMD();
+	std::cout << "Silence scan, " << SILENCE_SAMPLES << " samples summed " << SILENCE_RUNS << " times" << std::endl;
+	printf("%-7s %10s %22s %12s %12s\n", "simd", "time (ms)", "sum", "start (ms)", "end (ms)");
+
+	//Every short length and offset, so the leftovers and unaligned loads are covered
+	std::vector<Uint64> shortSums;
+	Uint64 sums[2] = { 0, 0 };
+	SilenceResult bounds[2];
+	bool agree = true;
+	for (int simd = 0; simd <= (simdAvailable ? 1 : 0); simd++) {
+		SilenceAnalyzer::setUseSIMD(simd == 1);
+
+		for (int offset = 0; offset < 8; offset++) {
+			for (int count = 0; count <= 64; count++) {
+				Uint64 sum = SilenceAnalyzer::sumSquares(samples.data() + (64 * 15 + offset), count);
+				size_t index = (size_t)offset * 65 + count;
+				if (simd == 0)
+					shortSums.push_back(sum);
+				else if (shortSums[index] != sum)
+					agree = false;
+			}
+		}
+
+		Uint64 start = SDL_GetPerformanceCounter();
+		for (int run = 0; run < SILENCE_RUNS; run++)
+			sums[simd] = SilenceAnalyzer::sumSquares(samples.data(), (int)samples.size());
+		double time = ticksToMilliseconds(SDL_GetPerformanceCounter() - start);
+
+		bounds[simd] = SilenceAnalyzer::findSoundBounds(samples.data(), (int)samples.size() / CHANNELS, CHANNELS, SAMPLE_RATE);
+		printf("%-7s %10.2f %22llu %12d %12d\n", (simd == 1 ? "on" : "off"), time, (unsigned long long)sums[simd],
+			bounds[simd].soundStartMs, bounds[simd].soundEndMs);
+	}
+
+	if (simdAvailable) {
+		agree = agree && sums[0] == sums[1] &&
+			bounds[0].soundStartMs == bounds[1].soundStartMs && bounds[0].soundEndMs == bounds[1].soundEndMs;
+	}
+
+	SilenceAnalyzer::setUseSIMD(true);
+	std::cout << (agree ? "SIMD and scalar scans agree" : "SIMD and scalar scans disagree") << std::endl;
+	return (agree ? 0 : 1);
+}
+
+
+/*
+* Writes audio to a 16 bit WAV file
+*
+* @param path, Where to write the file
+* @param audio, The interleaved frames
+* @return bool, true if the file was written
+*/
+static bool writeWav(std::string path, const std::vector<float>& audio) {
+	SDL_RWops* file = SDL_RWFromFile(path.c_str(), "wb");
+	if (file == nullptr) return false;
+
+	Uint32 dataSize = (Uint32)(audio.size() * sizeof(Sint16));
+	SDL_RWwrite(file, "RIFF", 1, 4);
+	SDL_WriteLE32(file, 36 + dataSize);
+	SDL_RWwrite(file, "WAVEfmt ", 1, 8);
+	SDL_WriteLE32(file, 16);
+	SDL_WriteLE16(file, 1);	//PCM
+	SDL_WriteLE16(file, CHANNELS);
+	SDL_WriteLE32(file, SAMPLE_RATE);
+	SDL_WriteLE32(file, SAMPLE_RATE * CHANNELS * sizeof(Sint16));
+	SDL_WriteLE16(file, CHANNELS * sizeof(Sint16));
+	SDL_WriteLE16(file, 16);
+	SDL_RWwrite(file, "data", 1, 4);
+	SDL_WriteLE32(file, dataSize);
+
+	for (float sample : audio)
+		SDL_WriteLE16(file, (Uint16)(Sint16)(SDL_min(SDL_max(sample, -1.0f), 1.0f) * 32767));
+
+	return SDL_RWclose(file) == 0;
+}
+
+/*
+* Times a backend opening, decoding and seeking through a song
+*
+* @param decoder, The backend to time
+* @param path, The song to decode
+* @return int, 0 if it decodes faster than real time
+*/
+static int timeDecoder(Decoder* decoder, std::string path) {
+	int frequency, channels;
+	Uint16 format;
+	Mix_QuerySpec(&frequency, &format, &channels);
+	std::vector<Sint16> block((size_t)DECODE_FRAMES * channels);
+
+	Uint64 start = SDL_GetPerformanceCounter();
+	if (!decoder->open(path)) {
+		printf("%-6s %s can't decode it\n", decoder->getName(), path.c_str());
+		return 0;
+	}
+	double openTime = ticksToMilliseconds(SDL_GetPerformanceCounter() - start);
+
+	//Reads the whole song like the feeder does
+	Sint64 frames = 0;
+	int got;
+	start = SDL_GetPerformanceCounter();
+	while ((got = decoder->readFrames(block.data(), DECODE_FRAMES)) > 0)
+		frames += got;
+	double decodeTime = ticksToMilliseconds(SDL_GetPerformanceCounter() - start);
+
+	//Seeks somewhere and reads a block, like skipping around the song
+	Uint32 random = 12345;
+	start = SDL_GetPerformanceCounter();
+	for (int i = 0; i < SEEK_COUNT; i++) {
+		random = random * 1664525 + 1013904223;
+		decoder->seek((Sint64)((random >> 8) % (Uint32)SDL_max(frames, (Sint64)1)));
+		decoder->readFrames(block.data(), DECODE_FRAMES);
+	}
+	double seekTime = ticksToMilliseconds(SDL_GetPerformanceCounter() - start) / SEEK_COUNT;
+
+	double seconds = (double)frames / frequency;
+	//How many times faster than the song plays, counting the open
+	double realtime = seconds * 1000 / SDL_max(openTime + decodeTime, 0.001);
+	printf("%-6s %10.2f %10.2f %10.1f %9.1fx %10.3f\n", decoder->getName(), seconds, openTime, decodeTime, realtime, seekTime);
+
+	decoder->close();
+	return (realtime < 1 ? 1 : 0);
+}
+
+/*
+* Benchmarks every backend that can decode the songs given, against SDL_mixer's decoders
+* A song is generated when none are given
+*
+* @param arguments, The songs to decode
+* @return int, 0 if every backend decodes faster than real time
+*/
+static int benchmarkDecode(const std::vector<std::string>& arguments) {
+	//The decoders convert to the device format, so a device has to be open
+	SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+	if (SDL_Init(SDL_INIT_AUDIO) != 0 || Mix_OpenAudio(SAMPLE_RATE, MIX_DEFAULT_FORMAT, CHANNELS, 4096) == -1) {
+		std::cout << "Can't open audio " << SDL_GetError() << std::endl;
+		return 1;
+	}
+	Mix_Init(MIX_INIT_MP3 | MIX_INIT_FLAC | MIX_INIT_OGG);
+
+	std::vector<std::string> songs = arguments;
+	bool generated = songs.empty();
+	if (generated) {
+		if (!writeWav(GENERATED_SONG, generateAudio(AUDIO_SECONDS))) {
+			std::cout << "Can't write " << GENERATED_SONG << std::endl;
+			Mix_CloseAudio();
+			return 1;
+		}
+		songs.push_back(GENERATED_SONG);
+	}
+
+	int failed = 0;
+	for (const std::string& song : songs) {
+		DecoderFormat sniffed = Decoders::sniff(song);
+		std::cout << song << " (" << Decoders::getFormatName(sniffed) << ")" << std::endl;
+		printf("%-6s %10s %10s %10s %10s %10s\n", "codec", "song (s)", "open (ms)", "read (ms)", "realtime", "seek (ms)");
+
+		//The backend picked for the format, then SDL_mixer's for comparison
+		Decoder* decoder = Decoders::create(sniffed);
+		failed += timeDecoder(decoder, song);
+		delete decoder;
+
+		if (sniffed == DecoderFormat::WAV) {
+			decoder = Decoders::create(DecoderFormat::Unknown);
+			failed += timeDecoder(decoder, song);
+			delete decoder;
+		}
+	}
+
+	if (generated)
+		remove(GENERATED_SONG);
+
+	Mix_CloseAudio();
+	Mix_Quit();
+	std::cout << (failed == 0 ? "Decodes faster than real time" : "Decodes slower than real time") << std::endl;
+	return failed;
+}
+
+
+/*
+* Times laying out widgets over a number of frames
+* Each widget's rect is read 3 times a frame, like updating, hit testing and rendering do
+*
+* @param widgets, The widgets
+* @param prepareFrame, Run before each frame with the frame's index (moves widgets, ...)
+* @param invalidateReads, Makes every read resolve the rect, like getRect did before it was cached
+* @param resolves, Set to the average amount of rects resolved per frame
+* @return double, The average time per frame (ms)
+*/
+static double timeLayout(const std::vector<Interactable*>& widgets, std::function<void(int)> prepareFrame,
+	bool invalidateReads, double& resolves) {
+	Uint32 startResolves = Layout::getResolves();
+	Sint64 checksum = 0;
+
+	Uint64 start = SDL_GetPerformanceCounter();
+	for (int frame = 0; frame < LAYOUT_FRAMES; frame++) {
+		prepareFrame(frame);
+
+		for (int read = 0; read < 3; read++) {
+			if (invalidateReads)
+				Layout::invalidateAll();
+			for (const Interactable* widget : widgets) {
+				SDL_Rect rect = widget->getRect();
+				checksum += rect.x + rect.y + rect.w + rect.h;
+			}
+		}
+	}
+	double time = ticksToMilliseconds(SDL_GetPerformanceCounter() - start) / LAYOUT_FRAMES;
+
+	//Keeps the reads from being optimized away
+	if (checksum == 0)
+		std::cout << "";
+
+	resolves = (double)(Layout::getResolves() - startResolves) / LAYOUT_FRAMES;
+	return time;
+}
+
+/*
+* Benchmarks the layout of a large UI
+* Half the widgets are laid out in the display by percentage, the other half are rows bound to a list
+* Passes if reading the cached rects is faster than resolving them on every read
+*
+* @param arguments, Optionally the amount of widgets
+* @return int, 0 if caching the layout paid off
+*/
+static int benchmarkLayout(const std::vector<std::string>& arguments) {
+	int count = (arguments.empty() ? LAYOUT_WIDGETS : SDL_max(SDL_atoi(arguments[0].c_str()), 1));
+	Layout::beginFrame(LAYOUT_WIDTH, LAYOUT_HEIGHT);
+
+	SDL_Rect listArea = { 0, 0, LAYOUT_WIDTH, LAYOUT_HEIGHT };
+	std::vector<Interactable*> widgets;
+	for (int i = 0; i < count; i++) {
+		Interactable* widget = new Interactable();
+		if (i % 2 == 0) {
+			widget->setX(CordType::PercentageWidth, (i % 100) / 100.0f);
+			widget->setY(CordType::PixelFromBottomEdge, (float)(i % LAYOUT_HEIGHT));
+			widget->setW(CordType::Pixel, 50);
+			widget->setH(CordType::PercentageSmallest, 0.1f);
+			widget->setRenderStyle(RenderStyle::Centered);
+		}
+		else {
+			widget->setX(CordType::Percentage, 0);
+			widget->setY(CordType::Pixel, (float)(i / 2) * LAYOUT_ROW_HEIGHT);
+			widget->setW(CordType::PercentageWidth, 1);
+			widget->setH(CordType::Pixel, LAYOUT_ROW_HEIGHT);
+			widget->bindToArea(listArea);
+		}
+		widgets.push_back(widget);
+	}
+
+	std::cout << "Layout, " << count << " widgets, " << LAYOUT_FRAMES << " frames, 3 reads per widget per frame" << std::endl;
+	printf("%-10s %12s %12s %14s\n", "case", "frame (ms)", "per widget", "resolves/frame");
+
+	double resolves;
+	auto print = [&](const char* name, double time) {
+		printf("%-10s %12.3f %9.1f ns %14.0f\n", name, time, time * 1000000 / count, resolves);
+	};
+
+	//Every read resolves the rect, like before the layout was cached
+	double uncached = timeLayout(widgets, [](int) {}, true, resolves);
+	print("uncached", uncached);
+
+	//The display is resized every frame, so everything is resolved once
+	double resized = timeLayout(widgets, [](int frame) {
+		Layout::beginFrame(LAYOUT_WIDTH + frame % 2, LAYOUT_HEIGHT);
+	}, false, resolves);
+	print("resize", resized);
+	Layout::beginFrame(LAYOUT_WIDTH, LAYOUT_HEIGHT);
+
+	//A percent of the rows move each frame, like a list being scrolled
+	double scrolled = timeLayout(widgets, [&](int frame) {
+		for (int i = 1; i < count; i += 200)
+			widgets[i]->setY(CordType::Pixel, (float)((i / 2 + frame) * LAYOUT_ROW_HEIGHT));
+	}, false, resolves);
+	print("scroll", scrolled);
+
+	//Nothing changes
+	double steady = timeLayout(widgets, [](int) {}, false, resolves);
+	print("steady", steady);
+
+	for (Interactable* widget : widgets)
+		delete widget;
+
+	bool faster = steady < uncached;
+	std::cout << (faster ? "Cached layout is faster" : "Cached layout is no faster") << std::endl;
+	return (faster ? 0 : 1);
+}
+
+
+/*
+* Walks the widgets one object at a time like the tree used to, each update checking if it moved through its virtual functions
+*
+* @param widgets, The widgets
+* @param area, Filled with the dirty area
+* @param toRender, Filled with the indices of the widgets to render
+*/
+static void traverseTree(const std::vector<Interactable*>& widgets, SDL_Rect& area, std::vector<int>& toRender) {
+	for (Interactable* widget : widgets) {
+		widget->update();
+		Components::updateMoved(widget->getSlot());
+	}
+
+	area = { 0, 0, 0, 0 };
+	for (Interactable* widget : widgets) {
+		if (!widget->getUpdated()) continue;
+		SDL_Rect currentArea = widget->getRect();
+		SDL_Rect renderedArea = widget->getRenderedRect();
+		SDL_UnionRect(&area, &currentArea, &area);
+		SDL_UnionRect(&area, &renderedArea, &area);
+	}
+
+	toRender.clear();
+	for (size_t i = 0; i < widgets.size(); i++) {
+		SDL_Rect currentArea = widgets[i]->getRect();
+		SDL_Rect renderedArea = widgets[i]->getRenderedRect();
+		if (widgets[i]->getUpdated() || SDL_HasIntersection(&currentArea, &area) || SDL_HasIntersection(&renderedArea, &area))
+			toRender.push_back((int)i);
+	}
+}
+
+/*
+* Updates the widgets through the manager like the main loop, then walks the component arrays once per system
+*
+* @param manager, The manager holding the widgets
+* @param slots, The widgets' slots
+* @param area, Filled with the dirty area
+* @param toRender, Filled with the indices of the widgets to render
+*/
+static void traverseComponents(InteractableManager& manager, const std::vector<int>& slots, SDL_Rect& area, std::vector<int>& toRender) {
+	manager.updateInteractables();
+	Components::getDirtyArea(slots, area);
+	Components::getRenderList(slots, area, toRender);
+}
+
+/*
+* Times traversing the widgets over a number of frames
+* A row in every hundred moves each frame, and everything is revalidated after, like rendering does
+*
+* @param widgets, The widgets
+* @param traverse, Traverses the widgets for a frame
+* @param rendered, Set to the average amount of widgets found to render per frame
+* @return double, The average time per frame (ms)
+*/
+static double timeTraversal(const std::vector<Interactable*>& widgets, std::function<void(SDL_Rect&, std::vector<int>&)> traverse,
+	double& rendered) {
+	std::vector<int> toRender;
+	Uint64 total = 0;
+	Sint64 renderedTotal = 0;
+
+	//Starts where the widgets were made, so each way of traversing sees the same frames
+	for (size_t i = 0; i < widgets.size(); i++) {
+		widgets[i]->setY(CordType::Pixel, (float)(i % 1000) * LAYOUT_ROW_HEIGHT);
+		Components::updateMoved(widgets[i]->getSlot());
+		widgets[i]->revalidate();
+	}
+
+	for (int frame = 0; frame < TRAVERSE_FRAMES; frame++) {
+		for (size_t i = frame % 100; i < widgets.size(); i += 100)
+			widgets[i]->setY(CordType::Pixel, (float)((i + frame) % 1000) * LAYOUT_ROW_HEIGHT);
+
+		SDL_Rect area;
+		Uint64 start = SDL_GetPerformanceCounter();
+		traverse(area, toRender);
+		total += SDL_GetPerformanceCounter() - start;
+		renderedTotal += toRender.size();
+
+		for (Interactable* widget : widgets)
+			widget->revalidate();
+	}
+
+	rendered = (double)renderedTotal / TRAVERSE_FRAMES;
+	return ticksToMilliseconds(total) / TRAVERSE_FRAMES;
+}
+
+/*
+* Benchmarks the per frame traversal of a large UI, object by object against the manager's component systems
+* The widgets are allocated between other allocations, so the objects are spread out like in a running player
+* Passes if the systems are faster
+*
+* @param arguments, Optionally the amount of widgets
+* @return int, 0 if the systems were faster
+*/
+static int benchmarkTraverse(const std::vector<std::string>& arguments) {
+	int count = (arguments.empty() ? TRAVERSE_WIDGETS : SDL_max(SDL_atoi(arguments[0].c_str()), 1));
+	Layout::beginFrame(LAYOUT_WIDTH, LAYOUT_HEIGHT);
+
+	SDL_Rect listArea = { 0, 0, LAYOUT_WIDTH, LAYOUT_HEIGHT };
+	std::vector<Interactable*> widgets;
+	std::vector<int> slots;
+	std::vector<std::vector<char>> scatter;
+	Uint32 random = 12345;
+	for (int i = 0; i < count; i++) {
+		random = random * 1664525 + 1013904223;
+		scatter.emplace_back((random >> 8) % TRAVERSE_SCATTER + 1);
+
+		Interactable* widget = new Interactable();
+		widget->setX(CordType::Percentage, 0);
+		widget->setY(CordType::Pixel, (float)(i % 1000) * LAYOUT_ROW_HEIGHT);
+		widget->setW(CordType::PercentageWidth, 1);
+		widget->setH(CordType::Pixel, LAYOUT_ROW_HEIGHT);
+		widget->bindToArea(listArea);
+
+		widgets.push_back(widget);
+		slots.push_back(widget->getSlot());
+	}
+	//Owns the widgets, deleting them when it goes
+	InteractableManager manager;
+	for (Interactable* widget : widgets)
+		manager.addInteractable(widget);
+
+	std::cout << "Traversal, " << count << " widgets, " << TRAVERSE_FRAMES << " frames, update + dirty area + render list" << std::endl;
+	printf("%-10s %12s %12s %14s\n", "case", "frame (ms)", "per widget", "rendered/frame");
+
+	double rendered;
+	auto print = [&](const char* name, double time) {
+		printf("%-10s %12.3f %9.1f ns %14.0f\n", name, time, time * 1000000 / count, rendered);
+	};
+
+	double tree = timeTraversal(widgets, [&](SDL_Rect& area, std::vector<int>& toRender) {
+		traverseTree(widgets, area, toRender);
+	}, rendered);
+	print("tree", tree);
+
+	double systems = timeTraversal(widgets, [&](SDL_Rect& area, std::vector<int>& toRender) {
+		traverseComponents(manager, slots, area, toRender);
+	}, rendered);
+	print("systems", systems);
+
+	bool faster = systems < tree;
+	std::cout << (faster ? "Component systems are faster" : "Component systems are no faster") << std::endl;
+	return (faster ? 0 : 1);
+}
+
+
+/*
+* Benchmarks editing a large list, like search results changing or a queue being rearranged
+* Each frame rows are looked up by ID, removed by handle and added, then the manager collects the removed ones
+* Passes if a frame's edits fit in a 60 fps frame
+*
+* @param arguments, Optionally the amount of rows and the amount changed per frame
+* @return int, 0 if the edits kept up
+*/
+static int benchmarkChurn(const std::vector<std::string>& arguments) {
+	int count = (arguments.size() >= 1 ? SDL_max(SDL_atoi(arguments[0].c_str()), 1) : CHURN_ROWS);
+	int changes = (arguments.size() >= 2 ? SDL_max(SDL_atoi(arguments[1].c_str()), 1) : CHURN_CHANGES);
+	changes = SDL_min(changes, count);
+	Layout::beginFrame(LAYOUT_WIDTH, LAYOUT_HEIGHT);
+
+	InteractableManager manager;
+	std::vector<int> IDs;
+	auto addRow = [&](int index) {
+		Interactable* row = new Interactable();
+		row->setX(CordType::Percentage, 0);
+		row->setY(CordType::Pixel, (float)index * LAYOUT_ROW_HEIGHT);
+		row->setW(CordType::PercentageWidth, 1);
+		row->setH(CordType::Pixel, LAYOUT_ROW_HEIGHT);
+		manager.addInteractable(row);
+		return row->getID();
+	};
+	for (int i = 0; i < count; i++)
+		IDs.push_back(addRow(i));
+
+	Uint64 lookupTicks = 0, removeTicks = 0, addTicks = 0, collectTicks = 0;
+	int found = 0, edited = 0;
+	Uint32 random = 12345;
+	for (int frame = 0; frame < CHURN_FRAMES; frame++) {
+		//Picks the rows to edit
+		std::vector<size_t> picked;
+		for (int i = 0; i < changes; i++) {
+			random = random * 1664525 + 1013904223;
+			picked.push_back((random >> 8) % IDs.size());
+		}
+		//Each row is only edited once a frame, in random order
+		std::sort(picked.begin(), picked.end());
+		picked.erase(std::unique(picked.begin(), picked.end()), picked.end());
+		std::shuffle(picked.begin(), picked.end(), std::minstd_rand(random));
+		edited += (int)picked.size();
+
+		Uint64 start = SDL_GetPerformanceCounter();
+		std::vector<InteractableHandle> handles;
+		for (size_t index : picked) {
+			handles.push_back(manager.getHandle(IDs[index]));
+			found += (manager.getInteractableMut(handles.back()) != nullptr);
+		}
+		lookupTicks += SDL_GetPerformanceCounter() - start;
+
+		start = SDL_GetPerformanceCounter();
+		for (InteractableHandle handle : handles)
+			manager.removeInteractable(handle);
+		removeTicks += SDL_GetPerformanceCounter() - start;
+
+		start = SDL_GetPerformanceCounter();
+		for (size_t index : picked)
+			IDs[index] = addRow((int)index);
+		addTicks += SDL_GetPerformanceCounter() - start;
+
+		start = SDL_GetPerformanceCounter();
+		manager.updateInteractables();
+		collectTicks += SDL_GetPerformanceCounter() - start;
+	}
+
+	std::cout << "Churn, " << count << " rows, up to " << changes << " looked up, removed and added per frame, "
+		<< CHURN_FRAMES << " frames" << std::endl;
+	printf("%-10s %12s %12s\n", "step", "frame (ms)", "per row");
+
+	double total = 0;
+	auto print = [&](const char* name, Uint64 ticks) {
+		double time = ticksToMilliseconds(ticks) / CHURN_FRAMES;
+		total += time;
+		printf("%-10s %12.3f %9.1f ns\n", name, time, time * 1000000 * CHURN_FRAMES / SDL_max(edited, 1));
+	};
+	print("lookup", lookupTicks);
+	print("remove", removeTicks);
+	print("add", addTicks);
+	print("update", collectTicks);
+	printf("%-10s %12.3f\n", "total", total);
+
+	//Every row picked is found, and the list keeps its size
+	bool kept = found == edited && manager.getCount() == count && total < FRAME_BUDGET_MS;
+	std::cout << (kept ? "Edits fit in a 60 fps frame" : "Edits don't fit in a 60 fps frame") << std::endl;
+	return (kept ? 0 : 1);
+}
+
+
+/*
+* The timings of the frames in a scripted UI sequence
+*/
+struct FrameTimes {
+	//The time the UI took handling each frame's input (ms)
+	std::vector<double> input;
+	//The time updating each frame took (ms)
+	std::vector<double> update;
+	//The time rendering and presenting each frame took (ms), only for frames that had something to draw
+	std::vector<double> render;
+};
+
+/*
+* A scripted UI sequence, feeding the UI input before each frame
+*/
+struct UISequence {
+	const char* name;
+	//Given the manager, the frame's index and the window's size
+	void (*input)(InteractableManager* manager, int frame, int width, int height);
+};
+
+/*
+* Gets a percentile of some times
+*
+* @param times, The times
+* @param percentile, From 0 to 100
+* @return double, The time at the percentile, 0 if there are none
+*/
+static double getPercentile(std::vector<double> times, double percentile) {
+	if (times.empty()) return 0;
+
+	//Nearest rank
+	size_t rank = (size_t)ceil(percentile / 100 * times.size());
+	rank = SDL_min(SDL_max(rank, (size_t)1), times.size()) - 1;
+	std::nth_element(times.begin(), times.begin() + rank, times.end());
+	return times[rank];
+}
+
+/*
+* Gets the most memory the process has held
+*
+* @return double, The peak working set (MB), -1 if it couldn't be read
+*/
+static double getPeakMemory() {
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return counters.PeakWorkingSetSize / (1024.0 * 1024.0);
+#else
+	//Kilobytes on Linux
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0)
+		return usage.ru_maxrss / 1024.0;
+#endif
+	return -1;
+}
+
+/*
+* Gets the memory the process holds right now, the same measure as the peak
+* Unlike the peak, the difference before and after something is what it's holding
+*
+* @return double, The working set (MB), -1 if it couldn't be read
+*/
+static double getCurrentMemory() {
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return counters.WorkingSetSize / (1024.0 * 1024.0);
+#else
+	//The resident set, in pages
+	long size, resident;
+	FILE* statm = fopen("/proc/self/statm", "r");
+	if (statm != nullptr) {
+		bool read = fscanf(statm, "%ld %ld", &size, &resident) == 2;
+		fclose(statm);
+		if (read)
+			return resident * (double)sysconf(_SC_PAGESIZE) / (1024.0 * 1024.0);
+	}
+#endif
+	return -1;
+}
+
+/*
+* Runs a frame of the UI like the main loop, without waiting for events or the frame rate
+*
+* @param manager, The UI
+* @param times, Given the frame's update time, and render time if it drew anything
+*/
+static void runUIFrame(InteractableManager* manager, FrameTimes& times) {
+	//Nothing reads the events, so they're dropped instead of piling up
+	SDL_PumpEvents();
+	SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+	int displayWidth, displayHeight;
+	Display::getSize(displayWidth, displayHeight);
+	Layout::beginFrame(displayWidth, displayHeight);
+
+	Animation::update();
+	MusicPlayer::update();
+
+	Uint64 start = SDL_GetPerformanceCounter();
+	manager->updateInteractables();
+	times.update.push_back(ticksToMilliseconds(SDL_GetPerformanceCounter() - start));
+
+	SDL_Rect dirtyArea;
+	if (manager->getDirtyArea(dirtyArea))
+		Display::invalidateArea(dirtyArea);
+
+	if (Display::getDirtyArea(dirtyArea)) {
+		start = SDL_GetPerformanceCounter();
+		Display::clear();
+		manager->renderDirty(dirtyArea);
+		Display::render();
+		times.render.push_back(ticksToMilliseconds(SDL_GetPerformanceCounter() - start));
+	}
+	else {
+		Display::skipFrame();
+	}
+}
+
+/*
+* Scrolls down through the list in bursts, then flicks back up
+*/
+static void scrollSequence(InteractableManager* manager, int frame, int width, int height) {
+	int x = width / 2;
+	int y = (height - 150) / 2;
+	manager->mouseHover(x, y);
+
+	//A notch down every other frame, like a wheel being spun
+	if (frame < UI_FRAMES * 3 / 4) {
+		if (frame % 2 == 0)
+			manager->mouseScroll(x, y, 10);
+	}
+	//Flicks back up
+	else if (frame % 8 == 0) {
+		manager->mouseScroll(x, y, -40);
+	}
+}
+
+/*
+* Moves down the rows, clicking a song every so often, and drags the volume
+*/
+static void clickSequence(InteractableManager* manager, int frame, int width, int height) {
+	int rowY = 10 + (frame * 3) % SDL_max(height - 160, 1);
+	manager->mouseHover(width / 2, rowY);
+
+	if (frame % 30 == 0)
+		manager->click(width / 2, rowY);
+
+	//The volume bar runs across the middle of the controls
+	if (frame % 10 == 5) {
+		int volumeX = width / 2 - 140 + (frame * 7) % 280;
+		int volumeY = height - 75 - 62 + 100;
+		manager->mouseDown(volumeX, volumeY);
+		manager->click(volumeX, volumeY);
+	}
+}
+
+/*
+* Drags the window bigger and back, a few pixels a frame
+*/
+static void resizeSequence(InteractableManager*, int frame, int, int) {
+	int half = UI_FRAMES / 2;
+	float progress = (frame < half ? (float)frame / half : (float)(UI_FRAMES - frame) / half);
+
+	SDL_SetWindowSize(Display::getWindow(), UI_WIDTH + (int)((UI_MAX_WIDTH - UI_WIDTH) * progress),
+		UI_HEIGHT + (int)((UI_MAX_HEIGHT - UI_HEIGHT) * progress));
+	//Like the resize event does
+	Display::invalidate();
+}
+
+//The scripted sequences, run in order
+static const UISequence uiSequences[] = {
+	{ "scroll", scrollSequence },
+	{ "click", clickSequence },
+	{ "resize", resizeSequence },
+};
+
+/*
+* Fills the music loader with a synthetic catalog, every song playing the same generated file
+*
+* @param count, The amount of songs
+* @param path, The song every entry plays
+*/
+static void generateCatalog(int count, std::string path) {
+	std::vector<std::string>* titles = MusicLoader::getMusicTitlesMut();
+	std::vector<std::string>* paths = MusicLoader::getMusicPathsMut();
+	std::vector<SongData>* songs = MusicLoader::getSongDataMut();
+
+	for (int i = 0; i < count; i++) {
+		std::string title = "Synthetic Song " + std::to_string(i);
+		titles->push_back(title);
+		paths->push_back(path);
+		songs->push_back(SongData(title, path));
+	}
+}
+
+/*
+* Benchmarks the player's UI in a headless window, with synthetic catalogs of increasing size
+* Each catalog is generated in its own run, then runs scripted scroll, click and resize sequences
+* Timing the input handling, update and render of every frame, the memory the catalog and its UI hold, and the process' peak
+* Passes if the 95th percentile frame fits in a 60 fps frame
+*
+* @param arguments, Optionally the sizes of the catalogs
+* @return int, The amount of sequences that went over the frame budget
+*/
+static int benchmarkInterface(const std::vector<std::string>& arguments) {
+	std::vector<int> catalogs(std::begin(UI_CATALOGS), std::end(UI_CATALOGS));
+	if (!arguments.empty()) {
+		catalogs.clear();
+		for (const std::string& argument : arguments)
+			catalogs.push_back(SDL_max(SDL_atoi(argument.c_str()), 1));
+	}
+
+	//No window is shown and nothing is heard, the software renderer keeps the timings the same across machines
+	SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+	SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+	SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+	if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) != 0) {
+		std::cout << "Can't initialize SDL " << SDL_GetError() << std::endl;
+		return 1;
+	}
+	IMG_Init(IMG_INIT_PNG);
+
+	if (!Display::init(UI_WIDTH, UI_HEIGHT)) {
+		std::cout << "Can't create the headless display " << SDL_GetError() << std::endl;
+		return 1;
+	}
+	SDL_SetRenderDrawBlendMode(Display::getRenderer(), SDL_BLENDMODE_BLEND);
+	Layout::beginFrame(UI_WIDTH, UI_HEIGHT);
+
+	//Clicked songs really play, so the rows showing the playing song are part of the work
+	if (!writeWav(GENERATED_SONG, generateAudio(UI_SONG_SECONDS))) {
+		std::cout << "Can't write " << GENERATED_SONG << std::endl;
+		Display::quit();
+		return 1;
+	}
+	//The player's background work (snippets, speculation, silence, preloads) runs like it does in the app
+	Worker::init();
+	MusicPlayer::init();
+
+	Font::init();
+	Font::loadFont("Fonts/OpenSans-Bold.ttf", FontName::UIFont);
+	TextRenderer::init();
+
+	SDL_RendererInfo info;
+	SDL_GetRendererInfo(Display::getRenderer(), &info);
+	std::cout << "UI, headless " << UI_WIDTH << "x" << UI_HEIGHT << " (" << info.name << " renderer), "
+		<< UI_FRAMES << " frames per sequence" << std::endl;
+	printf("%-8s %-7s %10s %7s %9s %9s %9s %9s %9s %9s %9s %9s %9s %9s %9s %9s %9s\n", "songs", "seq", "build (ms)", "drawn",
+		"evt p50", "evt p95", "evt max", "upd p50", "upd p95", "upd p99", "upd max", "rnd p50", "rnd p95", "rnd p99", "rnd max", "mem (MB)", "peak (MB)");
+
+	int failed = 0;
+	for (int count : catalogs) {
+		//Each catalog is generated fresh, so what it holds isn't hidden by a bigger one made before it
+		double startMemory = getCurrentMemory();
+		MusicLoader::init();
+		generateCatalog(count, GENERATED_SONG);
+
+		//Building the tree and its first full frame
+		FrameTimes firstFrame;
+		Uint64 start = SDL_GetPerformanceCounter();
+		InteractableManager* manager = PlayerInterface::build(MusicLoader::getSongData());
+		runUIFrame(manager, firstFrame);
+		double buildTime = ticksToMilliseconds(SDL_GetPerformanceCounter() - start);
+
+		for (const UISequence& sequence : uiSequences) {
+			FrameTimes times;
+			for (int frame = 0; frame < UI_FRAMES; frame++) {
+				int width, height;
+				Display::getSize(width, height);
+
+				//The hovers, clicks and scrolls the MouseController would hand the manager
+				start = SDL_GetPerformanceCounter();
+				sequence.input(manager, frame, width, height);
+				times.input.push_back(ticksToMilliseconds(SDL_GetPerformanceCounter() - start));
+
+				runUIFrame(manager, times);
+			}
+
+			double inputP95 = getPercentile(times.input, 95);
+			double updateP95 = getPercentile(times.update, 95);
+			double renderP95 = getPercentile(times.render, 95);
+			double memory = (startMemory >= 0 ? getCurrentMemory() - startMemory : -1);
+			printf("%-8d %-7s %10.1f %7d %9.3f %9.3f %9.3f %9.3f %9.3f %9.3f %9.3f %9.3f %9.3f %9.3f %9.3f %9.1f %9.1f\n", count, sequence.name,
+				buildTime, (int)times.render.size(),
+				getPercentile(times.input, 50), inputP95, getPercentile(times.input, 100),
+				getPercentile(times.update, 50), updateP95, getPercentile(times.update, 99), getPercentile(times.update, 100),
+				getPercentile(times.render, 50), renderP95, getPercentile(times.render, 99), getPercentile(times.render, 100),
+				memory, getPeakMemory());
+
+			if (inputP95 + updateP95 + renderP95 > FRAME_BUDGET_MS)
+				failed++;
+		}
+
+		//Stops the clicked song before its catalog goes
+		MusicPlayer::haltMusic();
+		manager->clear();
+		delete manager;
+		MusicLoader::close();
+		SDL_SetWindowSize(Display::getWindow(), UI_WIDTH, UI_HEIGHT);
+	}
+
+	//Before the music player, as it may still be loading tracks
+	Worker::close();
+	MusicPlayer::close();
+	TexturePool::clear();
+	TextureCache::clear();
+	TextRenderer::close();
+	Font::close();
+	Display::quit();
+	remove(GENERATED_SONG);
+	IMG_Quit();
+
+	std::cout << (failed == 0 ? "Fits in a 60 fps frame" : "Goes over a 60 fps frame") << std::endl;
+	return failed;
+}
+
+
+/*
+* Counts the allocations made through it, passing them on to the heap
+*/
+class CountingResource : public std::pmr::memory_resource {
+private:
+	std::pmr::memory_resource* upstream = std::pmr::new_delete_resource();
+	unsigned int allocations = 0;
+
+	void* do_allocate(size_t bytes, size_t alignment) override {
+		allocations++;
+		return upstream->allocate(bytes, alignment);
+	}
+	void do_deallocate(void* block, size_t bytes, size_t alignment) override {
+		upstream->deallocate(block, bytes, alignment);
+	}
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+public:
+	//Gets the amount of allocations made
+	unsigned int getAllocations() const { return allocations; }
+};
+
+/*
+* Times building and deleting widgets, from the pool or straight from the heap
+*
+* @param count, The amount of widgets
+* @param pooled, true to build them from the pool
+* @param heapAllocations, Set to the allocations made on the heap
+* @return double, The time each build and delete took (ms)
+*/
+static double timeWidgets(int count, bool pooled, unsigned int& heapAllocations) {
+	WidgetPool::setEnabled(pooled);
+	unsigned int heapBefore = WidgetPool::getHeapAllocations();
+
+	std::vector<Interactable*> widgets(count);
+	Uint64 start = SDL_GetPerformanceCounter();
+	for (int rebuild = 0; rebuild < ALLOC_REBUILDS; rebuild++) {
+		for (Interactable*& widget : widgets)
+			widget = new Interactable();
+		for (Interactable* widget : widgets)
+			delete widget;
+	}
+	double time = ticksToMilliseconds(SDL_GetPerformanceCounter() - start) / ALLOC_REBUILDS;
+
+	heapAllocations = WidgetPool::getHeapAllocations() - heapBefore;
+	WidgetPool::setEnabled(true);
+	return time;
+}
+
+/*
+* Times listing songs and dropping the list, each string on the heap or every song in an arena
+* Lists songs the way MusicListInteractable does
+*
+* @param count, The amount of songs
+* @param inArena, true to list them in an arena
+* @param heapAllocations, Set to the allocations made on the heap
+* @return double, The time listing and dropping them took (ms)
+*/
+static double timeCatalog(int count, bool inArena, unsigned int& heapAllocations) {
+	CountingResource heap;
+
+	Uint64 start = SDL_GetPerformanceCounter();
+	{
+		std::pmr::monotonic_buffer_resource arena(&heap);
+		std::pmr::memory_resource* resource = (inArena ? (std::pmr::memory_resource*)&arena : &heap);
+
+		std::pmr::vector<ListedSong> catalog(resource);
+		catalog.reserve(count);
+		for (int i = 0; i < count; i++) {
+			std::string title = "Synthetic Song " + std::to_string(i);
+			catalog.push_back({ i, std::pmr::string(title, resource), std::pmr::string("Music/" + title + ".mp3", resource) });
+		}
+	}
+	double time = ticksToMilliseconds(SDL_GetPerformanceCounter() - start);
+
+	heapAllocations = heap.getAllocations();
+	return time;
+}
+
+/*
+* Benchmarks the allocations behind building the UI, before and after pooling them
+* Widgets are built one by one on the heap then from the widget pool,
+* songs are listed with every string on the heap then in an arena
+* Passes if pooling makes fewer heap allocations
+*
+* @param arguments, Optionally the amount of widgets and the amount of songs
+* @return int, 0 if pooling made fewer heap allocations
+*/
+static int benchmarkAllocations(const std::vector<std::string>& arguments) {
+	int count = (arguments.size() >= 1 ? SDL_max(SDL_atoi(arguments[0].c_str()), 1) : ALLOC_WIDGETS);
+	int songs = (arguments.size() >= 2 ? SDL_max(SDL_atoi(arguments[1].c_str()), 1) : ALLOC_SONGS);
+
+	//Widgets can't exist while the pool is switched
+	if (WidgetPool::getLiveCount() != 0) {
+		std::cout << "Widgets already exist, can't switch the pool" << std::endl;
+		return 1;
+	}
+
+	//The component arrays grow on the first build, so it's left out
+	unsigned int heapAllocations;
+	timeWidgets(count, false, heapAllocations);
+
+	std::cout << "Allocations, " << count << " widgets built " << ALLOC_REBUILDS << " times, "
+		<< songs << " songs listed" << std::endl;
+	printf("%-10s %-6s %12s %17s\n", "case", "memory", "time (ms)", "heap allocations");
+
+	unsigned int widgetHeap, widgetPooled, catalogHeap, catalogArena;
+	double time = timeWidgets(count, false, widgetHeap);
+	printf("%-10s %-6s %12.3f %17u\n", "widgets", "heap", time, widgetHeap);
+	time = timeWidgets(count, true, widgetPooled);
+	printf("%-10s %-6s %12.3f %17u\n", "widgets", "pool", time, widgetPooled);
+
+	time = timeCatalog(songs, false, catalogHeap);
+	printf("%-10s %-6s %12.3f %17u\n", "catalog", "heap", time, catalogHeap);
+	time = timeCatalog(songs, true, catalogArena);
+	printf("%-10s %-6s %12.3f %17u\n", "catalog", "arena", time, catalogArena);
+
+	bool fewer = widgetPooled < widgetHeap && catalogArena < catalogHeap;
+	std::cout << (fewer ? "Pooling makes fewer heap allocations" : "Pooling makes no fewer heap allocations") << std::endl;
+	return (fewer ? 0 : 1);
+}
+
+
+//Every benchmark that can be run
+static const BenchmarkEntry benchmarks[] = {
+	{ "stretch", benchmarkStretch, false },
+	{ "silence", benchmarkSilence, false },
+	{ "decode", benchmarkDecode, true },
+	{ "layout", benchmarkLayout, false },
+	{ "traverse", benchmarkTraverse, false },
+	{ "churn", benchmarkChurn, false },
+	{ "ui", benchmarkInterface, false },
+	{ "alloc", benchmarkAllocations, false },
+};
+
+
+/*
+* Runs the benchmark with the name given
+*
+* @param name, The name of the benchmark, "all" runs every benchmark
+* @param arguments, Passed on to the benchmark (the songs to decode, ...), under "all" only to the ones sharing them
+* @return int, 0 if every benchmark passed
+*/
+int Benchmark::run(std::string name, std::vector<std::string> arguments) {
+	int failed = 0;
+	bool found = false;
+	const std::vector<std::string> defaults;
+
+	for (const BenchmarkEntry& benchmark : benchmarks) {
+		if (name != "all" && name != benchmark.name) continue;
+
+		//The songs to decode aren't counts, so the rest run with their defaults under "all"
+		bool given = name != "all" || benchmark.sharesArguments;
+		found = true;
+		std::cout << "== " << benchmark.name << std::endl;
+		failed += (benchmark.run(given ? arguments : defaults) != 0);
+	}
+
+	if (!found) {
+		std::cout << "Unknown benchmark " << name << ", available:";
+		for (const BenchmarkEntry& benchmark : benchmarks)
+			std::cout << " " << benchmark.name;
+		std::cout << std::endl;
+		return 1;
+	}
+	return failed;
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/*
+* Measures the performance critical parts of the player in isolation
+* Run with "--benchmark <name> [files...]", results are printed to the console
+*/
+namespace Benchmark {
+	//Runs the benchmark with the name given, "all" runs every benchmark
+	int run(std::string name, std::vector<std::string> arguments);
+};
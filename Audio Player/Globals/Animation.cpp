@@ -0,0 +1,211 @@
+#include "Animation.h"
+
+#include <vector>
+#include <algorithm>
+
+#include "SDL_assert.h"
+
+#include "GFX/SDL2_framerate.h"
+#include "Display.h"
+
+//The rate animations are stepped at (Hz)
+#define STEP_RATE 60
+//The most steps run in one frame, the rest are dropped so a slow frame doesn't snowball
+#define MAX_STEPS_PER_FRAME 4
+
+//The animations being stepped
+static std::vector<Animated*> active;
+
+//Paces frames while animating, and measures the time between them
+static FPSmanager clock;
+static bool clockRunning = false;
+
+//Time the steps haven't caught up with (ms)
+static float pendingMs = 0;
+
+static Uint32 steps = 0;
+static Uint32 droppedSteps = 0;
+
+
+/*
+* Destructor, stops animating
+*/
+Animated::~Animated() {
+	Animation::stop(this);
+}
+
+
+/*
+* Constructor, settled at a value
+*
+* @param value, The value
+*/
+Tween::Tween(float value) {
+	set(value);
+}
+
+/*
+* Starts easing from the current value to a target
+*
+* @param target, The value to end at
+* @param durationMs, How long the transition takes
+*/
+void Tween::start(float target, float durationMs) {
+	from = getValue();
+	to = target;
+	duration = SDL_max(durationMs / 1000.0f, 0.001f);
+	elapsed = 0;
+}
+
+/*
+* Jumps straight to a value
+*
+* @param value, The value
+*/
+void Tween::set(float value) {
+	from = to = value;
+	duration = 1;
+	elapsed = 1;
+}
+
+/*
+* Advances the transition
+*
+* @param seconds, How much time passed
+* @return bool, true while it's still moving, false once it has settled
+*/
+bool Tween::step(float seconds) {
+	elapsed = SDL_min(elapsed + seconds, duration);
+	return !getSettled();
+}
+
+/*
+* Gets the current value
+*
+* @return float, The eased value between where it started and its target
+*/
+float Tween::getValue() const {
+	return from + (to - from) * Animation::easeOutCubic(elapsed / duration);
+}
+
+/*
+* Gets whether the transition has finished
+*
+* @return bool, true if it's at its target
+*/
+bool Tween::getSettled() const { return elapsed >= duration; }
+
+
+/*
+* Starts stepping an animation
+* The first step runs next frame
+*
+* @param animated, The animation
+*/
+void Animation::start(Animated* animated) {
+	SDL_assert(animated != nullptr);
+	if (animated == nullptr) return;
+	if (std::find(active.begin(), active.end(), animated) != active.end()) return;
+
+	//Restarts the clock if everything was idle, so the idle time isn't stepped through
+	if (!clockRunning) {
+		SDL_initFramerate(&clock);
+		SDL_setFramerate(&clock, STEP_RATE);
+		clockRunning = true;
+		pendingMs = 1000.0f / STEP_RATE;
+	}
+
+	active.push_back(animated);
+	Display::requestFrame();
+}
+
+/*
+* Stops stepping an animation
+*
+* @param animated, The animation
+*/
+void Animation::stop(Animated* animated) {
+	auto found = std::find(active.begin(), active.end(), animated);
+	if (found != active.end())
+		active.erase(found);
+}
+
+/*
+* Runs the fixed steps that are due
+* Animations that settle are stopped
+*/
+void Animation::update() {
+	if (!clockRunning) return;
+
+	const float stepMs = 1000.0f / STEP_RATE;
+	int due = (int)(pendingMs / stepMs);
+	pendingMs -= due * stepMs;
+
+	//Keeps within the frame budget
+	if (due > MAX_STEPS_PER_FRAME) {
+		droppedSteps += due - MAX_STEPS_PER_FRAME;
+		due = MAX_STEPS_PER_FRAME;
+	}
+
+	for (int s = 0; s < due; s++) {
+		for (size_t i = 0; i < active.size();) {
+			if (active[i]->step(stepMs / 1000.0f))
+				i++;
+			else
+				active.erase(active.begin() + i);
+		}
+		steps++;
+	}
+}
+
+/*
+* Paces the frame to the step rate while anything is animating
+* Stops the clock once everything has settled, so the main loop can wait for events again
+*/
+void Animation::endFrame() {
+	if (!clockRunning) return;
+
+	if (active.empty()) {
+		clockRunning = false;
+		pendingMs = 0;
+		return;
+	}
+
+	//Waits out the rest of the step, and adds the time the frame took
+	pendingMs += (float)SDL_framerateDelay(&clock);
+	Display::requestFrame();
+}
+
+/*
+* Eases a fraction, fast at the start and slow at the end
+*
+* @param t, The fraction (0 - 1)
+* @return float, The eased fraction (0 - 1)
+*/
+float Animation::easeOutCubic(float t) {
+	t = SDL_min(SDL_max(t, 0.0f), 1.0f);
+	float remaining = 1 - t;
+	return 1 - remaining * remaining * remaining;
+}
+
+
+/*
+* Gets the amount of animations running
+*
+* @return int, The amount of animations
+*/
+int Animation::getActiveCount() { return (int)active.size(); }
+
+/*
+* Gets the amount of fixed steps run
+*
+* @return Uint32, The amount of steps
+*/
+Uint32 Animation::getSteps() { return steps; }
+
+/*
+* Gets the amount of steps dropped to stay within the frame budget
+*
+* @return Uint32, The amount of dropped steps
+*/
+Uint32 Animation::getDroppedSteps() { return droppedSteps; }
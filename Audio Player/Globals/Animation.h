@@ -0,0 +1,84 @@
+#pragma once
+
+#include "SDL.h"
+
+/*
+* Something that moves on the animation clock
+* Started with Animation::start, then stepped each fixed step until it settles
+*/
+class Animated {
+public:
+	//Stops animating once it's destroyed
+	virtual ~Animated();
+
+	//Advances by one fixed step, false once it has settled
+	virtual bool step(float seconds) = 0;
+};
+
+/*
+* A value eased from where it is to a target over a time
+* Stepped by the Animated that owns it
+*/
+class Tween {
+private:
+	//The value it started from, and is going to
+	float from;
+	float to;
+
+	//How long the transition takes, and how far along it is (seconds)
+	float duration;
+	float elapsed;
+public:
+	//Constructor, settled at a value
+	Tween(float value = 0);
+
+	//Starts easing from the current value to a target
+	void start(float target, float durationMs);
+
+	//Jumps straight to a value
+	void set(float value);
+
+	//Advances the transition, false once it has settled
+	bool step(float seconds);
+
+	/// Getters
+
+	//Gets the current value
+	float getValue() const;
+
+	//Gets whether the transition has finished
+	bool getSettled() const;
+};
+
+/*
+* Steps animations on a fixed timestep, paced by a framerate manager
+* The clock only runs while something is animating, so the main loop can go idle once they all settle
+* NOTE: Main thread only
+*/
+namespace Animation {
+	//Starts stepping an animation, if it isn't already
+	void start(Animated*);
+
+	//Stops stepping an animation
+	void stop(Animated*);
+
+	//Runs the fixed steps that are due, call once per frame
+	void update();
+
+	//Paces the frame while animating, call once the frame is rendered
+	void endFrame();
+
+	//Eases a fraction (0 - 1), fast at the start and slow at the end
+	float easeOutCubic(float);
+
+	/// Getters
+
+	//Gets the amount of animations running
+	int getActiveCount();
+
+	//Gets the amount of fixed steps run
+	Uint32 getSteps();
+
+	//Gets the amount of steps dropped to stay within the frame budget
+	Uint32 getDroppedSteps();
+};
@@ -6,6 +6,8 @@
 #include <SDL.h>
 #include <SDL_assert.h>
 
+#include "DrawQueue.h"
+
 static bool displayReady = false;
 static SDL_Window* window = nullptr;
 static SDL_Renderer* renderer = nullptr;
@@ -15,6 +17,41 @@ static int prevWidth;
 static int prevHeight;
 static bool sizeChanged;
 
+//The longest the main loop sleeps when nothing asked for a frame (ms)
+#define IDLE_WAIT_MS 250
+
+//The UI is kept in this texture between frames, so only the areas that changed have to be redrawn
+static SDL_Texture* frameTexture = nullptr;
+
+//The area of the frame that has to be redrawn
+static SDL_Rect dirtyArea = { 0, 0, 0, 0 };
+static bool redrawAll = true;
+
+//When the next frame has to run by, if one was requested
+static bool frameRequested = false;
+static Uint32 frameDeadline = 0;
+
+static unsigned int renderedFrames = 0;
+static unsigned int skippedFrames = 0;
+
+/*
+* Creates the texture the frame is kept in, at the size of the display
+* The whole display has to be redrawn into it
+*/
+static void createFrameTexture(int width, int height) {
+    if (frameTexture != nullptr) {
+        SDL_DestroyTexture(frameTexture);
+        frameTexture = nullptr;
+    }
+
+    frameTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, width, height);
+    //The frame covers the whole display, so it's copied without blending
+    if (frameTexture != nullptr)
+        SDL_SetTextureBlendMode(frameTexture, SDL_BLENDMODE_NONE);
+
+    redrawAll = true;
+}
+
 /**
  * @brief Initializes the display
  */
@@ -36,6 +73,10 @@ bool Display::init(unsigned int width, unsigned int height) {
     //The size just changed
     sizeChanged = true;
 
+    //Creates the frame the UI is drawn into
+    if (renderer != nullptr)
+        createFrameTexture(width, height);
+
     displayReady = (window != nullptr && renderer != nullptr);
     return displayReady;
 }
@@ -47,6 +88,12 @@ void Display::quit() {
     //Ensures the display is ready before closing
     SDL_assert(displayReady);
 
+    //Destroys the frame before the renderer it belongs to
+    if (frameTexture != nullptr) {
+        SDL_DestroyTexture(frameTexture);
+        frameTexture = nullptr;
+    }
+
     //Destroys the renderer
     if (renderer != nullptr) {
         SDL_DestroyRenderer(renderer);
@@ -136,12 +183,109 @@ int Display::getHeight() {
 */
 bool Display::getSizeChanged() { return sizeChanged; }
 
-/// Updating
+/*
+* Gets the area of the display that has to be redrawn
+* 
+* @param area, Filled with the area
+* @return true, Part of the display has to be redrawn
+* @return false, Nothing changed
+*/
+bool Display::getDirtyArea(SDL_Rect& area) {
+    if (redrawAll) {
+        area.x = 0;
+        area.y = 0;
+        getSize(area.w, area.h);
+        return true;
+    }
+
+    area = dirtyArea;
+    return !SDL_RectEmpty(&dirtyArea);
+}
+
+/*
+* Gets the amount of frames rendered
+* 
+* @return unsigned int, The amount of frames presented to the screen
+*/
+unsigned int Display::getRenderedFrames() { return renderedFrames; }
+
+/*
+* Gets the amount of frames skipped as nothing changed
+* 
+* @return unsigned int, The amount of frames that weren't redrawn
+*/
+unsigned int Display::getSkippedFrames() { return skippedFrames; }
+
+/// Idling
+
+/*
+* Asks for a frame to be run within a time, even if no events arrive
+* Used by anything that changes over time (timers, animations, ...)
+* 
+* @param withinMs, How long until the frame is needed, 0 for the next frame
+*/
+void Display::requestFrame(unsigned int withinMs) {
+    Uint32 deadline = SDL_GetTicks() + withinMs;
+
+    //Keeps the earliest request
+    if (!frameRequested || SDL_TICKS_PASSED(frameDeadline, deadline))
+        frameDeadline = deadline;
+    frameRequested = true;
+}
+
+/*
+* Waits for an event, or until a requested frame is due
+* Returns straight away if part of the display has to be redrawn
+*/
+void Display::waitForFrame() {
+    //Requests only last for the frame they were made in
+    bool requested = frameRequested;
+    frameRequested = false;
+
+    SDL_Rect area;
+    if (getDirtyArea(area)) return;
+
+    Uint32 timeout = IDLE_WAIT_MS;
+    if (requested) {
+        Uint32 now = SDL_GetTicks();
+        timeout = (SDL_TICKS_PASSED(now, frameDeadline) ? 0 : SDL_min(frameDeadline - now, (Uint32)IDLE_WAIT_MS));
+    }
+
+    //Leaves the event in the queue for the input handler
+    if (timeout > 0)
+        SDL_WaitEventTimeout(NULL, timeout);
+}
 
 /// Rendering
 
 /*
-* Clears the display (Defaults to a grey for this project)
+* Marks an area of the display to be redrawn
+* 
+* @param area, The area that changed
+*/
+void Display::invalidateArea(const SDL_Rect& area) {
+    SDL_UnionRect(&dirtyArea, &area, &dirtyArea);
+}
+
+/*
+* Marks the whole display to be redrawn
+*/
+void Display::invalidate() { redrawAll = true; }
+
+/*
+* Rebuilds the kept frame after the renderer lost its textures (SDL_RENDER_TARGETS_RESET / SDL_RENDER_DEVICE_RESET)
+* The whole display is redrawn into the new frame
+*/
+void Display::resetFrame() {
+    SDL_assert(displayReady);
+    if (!displayReady) return;
+
+    createFrameTexture(getWidth(), getHeight());
+}
+
+/*
+* Clears the area of the display being redrawn (Defaults to a grey for this project)
+* Drawing is clipped to that area until the display is rendered
 * 
 * @return int, 0 on success, otherwise an error occured
 */
@@ -150,8 +294,15 @@ int Display::clear() {
     SDL_assert(displayReady);
     if (!displayReady) return -1;
 
-    SDL_SetRenderDrawColor(Display::getRenderer(), 100, 100, 100, SDL_ALPHA_OPAQUE);
-    SDL_RenderClear(Display::getRenderer());
+    SDL_Rect area;
+    getDirtyArea(area);
+
+    //Draws into the kept frame, the screen is drawn to directly if it couldn't be made
+    DrawQueue::setTarget(frameTexture);
+    DrawQueue::setClipRect(&area);
+
+    //SDL_RenderClear ignores the clip rect
+    DrawQueue::fillRect(area, { 100, 100, 100, SDL_ALPHA_OPAQUE });
 
     return 0;
 }
@@ -166,6 +317,10 @@ int Display::render() {
     SDL_assert(displayReady);
     if (!displayReady) return -1;
 
+    //Draws what was queued for the frame, then goes back to drawing on the screen
+    DrawQueue::setClipRect(NULL);
+    DrawQueue::setTarget(NULL);
+
     //The size just changed
     sizeChanged = false;
 
@@ -181,10 +336,32 @@ int Display::render() {
     prevHeight = currHeight;
 
     //If the size changed exit as everything may be rendered incorrectly!
-    if (sizeChanged) return 0;
+    if (sizeChanged) {
+        createFrameTexture(currWidth, currHeight);
+        DrawQueue::endFrame();
+        return 0;
+    }
+
+    //Puts the frame on the screen
+    if (frameTexture != nullptr) {
+        SDL_Rect screen = { 0, 0, currWidth, currHeight };
+        DrawQueue::copy(frameTexture, NULL, screen);
+        DrawQueue::flush();
+    }
+    DrawQueue::endFrame();
 
     //Renders the current Renderer
     SDL_RenderPresent(Display::getRenderer());
+    renderedFrames++;
+
+    //Everything is up to date, unless there's no frame to keep it in
+    dirtyArea = { 0, 0, 0, 0 };
+    redrawAll = (frameTexture == nullptr);
 
     return 0;
-}
\ No newline at end of file
+}
+
+/*
+* Counts a frame that had nothing to redraw
+*/
+void Display::skipFrame() { skippedFrames++; }
@@ -3,6 +3,7 @@
 
 struct SDL_Renderer;
 struct SDL_Window;
+struct SDL_Rect;
 
 namespace Display {
     //Creates the display
@@ -30,11 +31,40 @@ namespace Display {
     //Gets whether or not the size of the display just changed
     bool getSizeChanged();
 
+    //Gets the area that has to be redrawn, false if nothing changed
+    bool getDirtyArea(SDL_Rect&);
+
+    //Gets the amount of frames rendered
+    unsigned int getRenderedFrames();
+
+    //Gets the amount of frames skipped as nothing changed
+    unsigned int getSkippedFrames();
+
+    /// Idling
+
+    //Asks for a frame to be run within a time, even if no events arrive
+    void requestFrame(unsigned int withinMs = 0);
+
+    //Waits for an event or a requested frame when nothing has to be redrawn
+    void waitForFrame();
+
     /// Rendering
 
-    //Clears the display
+    //Marks an area of the display to be redrawn
+    void invalidateArea(const SDL_Rect&);
+
+    //Marks the whole display to be redrawn
+    void invalidate();
+
+    //Rebuilds the kept frame after the renderer lost its textures
+    void resetFrame();
+
+    //Clears the area of the display being redrawn
     int clear();
 
     //Renders the display to the screen
     int render();
+
+    //Counts a frame that had nothing to redraw
+    void skipFrame();
 }
\ No newline at end of file
@@ -0,0 +1,272 @@
+#include "DrawQueue.h"
+
+#include <vector>
+
+#include "SDL_assert.h"
+
+#include "Display.h"
+
+//How far ahead a draw is looked for to join a batch
+#define BATCH_LOOKAHEAD 256
+
+/*
+* A queued draw
+*/
+struct DrawCommand {
+	//The texture copied from, nullptr for a fill
+	SDL_Texture* texture;
+	//The part of the texture copied, the whole texture if there's none
+	SDL_Rect source;
+	bool hasSource;
+	//Where it's drawn
+	SDL_FRect destination;
+	//The fill color, or the texture's tint
+	SDL_Color color;
+	//How a fill is blended
+	SDL_BlendMode blend;
+};
+
+static std::vector<DrawCommand> commands;
+
+//Reused by each flush
+static std::vector<bool> flushed;
+static std::vector<SDL_FRect> fillRects;
+static std::vector<SDL_FRect> skipped;
+
+//This frame's counts, and last frame's
+static int drawCalls = 0;
+static int batches = 0;
+static int queued = 0;
+static int lastDrawCalls = 0;
+static int lastBatches = 0;
+static int lastQueued = 0;
+
+
+/*
+* Checks that two draws can be made in the same batch
+*
+* @param a, The first draw
+* @param b, The second draw
+* @return bool, true if they use the same texture and color
+*/
+static bool sameBatch(const DrawCommand& a, const DrawCommand& b) {
+	return a.texture == b.texture && a.blend == b.blend &&
+		a.color.r == b.color.r && a.color.g == b.color.g && a.color.b == b.color.b && a.color.a == b.color.a;
+}
+
+/*
+* Checks that two areas overlap
+*
+* @param a, The first area
+* @param b, The second area
+* @return bool, true if they overlap
+*/
+static bool overlaps(const SDL_FRect& a, const SDL_FRect& b) {
+	return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+/*
+* Draws a batch
+*
+* @param batch, The indices of the draws, all in the same batch
+*/
+static void drawBatch(const std::vector<int>& batch) {
+	SDL_Renderer* renderer = Display::getRenderer();
+	const DrawCommand& first = commands[batch.front()];
+	batches++;
+
+	//Fills are all made in one call
+	if (first.texture == nullptr) {
+		fillRects.clear();
+		for (int i : batch)
+			fillRects.push_back(commands[i].destination);
+
+		SDL_SetRenderDrawBlendMode(renderer, first.blend);
+		SDL_SetRenderDrawColor(renderer, first.color.r, first.color.g, first.color.b, first.color.a);
+		SDL_RenderFillRectsF(renderer, fillRects.data(), (int)fillRects.size());
+		drawCalls++;
+		return;
+	}
+
+	//Copies share the tint, the renderer batches them on its side
+	SDL_SetTextureColorMod(first.texture, first.color.r, first.color.g, first.color.b);
+	SDL_SetTextureAlphaMod(first.texture, first.color.a);
+	for (int i : batch) {
+		const DrawCommand& command = commands[i];
+		SDL_RenderCopyF(renderer, command.texture, (command.hasSource ? &command.source : NULL), &command.destination);
+		drawCalls++;
+	}
+}
+
+
+/*
+* Queues a filled rect
+*
+* @param area, The area to fill
+* @param color, The color to fill with
+* @param blend, How it's blended with what's under it
+*/
+void DrawQueue::fillRect(const SDL_Rect& area, SDL_Color color, SDL_BlendMode blend) {
+	DrawCommand command;
+	command.texture = nullptr;
+	command.source = { 0, 0, 0, 0 };
+	command.hasSource = false;
+	command.destination = { (float)area.x, (float)area.y, (float)area.w, (float)area.h };
+	command.color = color;
+	command.blend = blend;
+	commands.push_back(command);
+}
+
+/*
+* Queues a copy of a texture
+* NOTE: The texture has to stay alive until the queue is flushed
+*
+* @param texture, The texture
+* @param source, The part to copy, NULL for all of it
+* @param destination, Where to draw it
+* @param tint, The color and alpha it's tinted by
+*/
+void DrawQueue::copy(SDL_Texture* texture, const SDL_Rect* source, const SDL_FRect& destination, SDL_Color tint) {
+	SDL_assert(texture != nullptr);
+	if (texture == nullptr) return;
+
+	DrawCommand command;
+	command.texture = texture;
+	command.source = (source != NULL ? *source : SDL_Rect{ 0, 0, 0, 0 });
+	command.hasSource = (source != NULL);
+	command.destination = destination;
+	command.color = tint;
+	command.blend = SDL_BLENDMODE_BLEND;
+	commands.push_back(command);
+}
+
+/*
+* Queues a copy of a texture to a pixel area
+*
+* @param texture, The texture
+* @param source, The part to copy, NULL for all of it
+* @param destination, Where to draw it
+*/
+void DrawQueue::copy(SDL_Texture* texture, const SDL_Rect* source, const SDL_Rect& destination) {
+	SDL_FRect area = { (float)destination.x, (float)destination.y, (float)destination.w, (float)destination.h };
+	copy(texture, source, area);
+}
+
+/*
+* Draws everything queued
+* Each draw starts a batch, later draws in the same batch join it if they don't overlap anything drawn in between
+*
+* @return int, 0 on success
+*/
+int DrawQueue::flush() {
+	if (commands.empty()) return 0;
+
+	queued += (int)commands.size();
+	flushed.assign(commands.size(), false);
+
+	std::vector<int> batch;
+	for (size_t i = 0; i < commands.size(); i++) {
+		if (flushed[i]) continue;
+
+		batch.clear();
+		batch.push_back((int)i);
+		skipped.clear();
+
+		size_t end = SDL_min(commands.size(), i + BATCH_LOOKAHEAD);
+		for (size_t j = i + 1; j < end; j++) {
+			if (flushed[j]) continue;
+
+			//Joins the batch if nothing it would jump ahead of is under it
+			bool blocked = false;
+			if (sameBatch(commands[i], commands[j])) {
+				for (const SDL_FRect& area : skipped) {
+					if (overlaps(area, commands[j].destination)) {
+						blocked = true;
+						break;
+					}
+				}
+				if (!blocked) {
+					batch.push_back((int)j);
+					flushed[j] = true;
+					continue;
+				}
+			}
+			skipped.push_back(commands[j].destination);
+		}
+
+		drawBatch(batch);
+	}
+
+	//Everything else expects blended draws
+	SDL_SetRenderDrawBlendMode(Display::getRenderer(), SDL_BLENDMODE_BLEND);
+	commands.clear();
+	return 0;
+}
+
+/*
+* Fills the whole render target with a color, ignoring the clip rect
+*
+* @param color, The color
+* @return int, 0 on success, otherwise an error occured
+*/
+int DrawQueue::clear(SDL_Color color) {
+	flush();
+
+	SDL_SetRenderDrawColor(Display::getRenderer(), color.r, color.g, color.b, color.a);
+	drawCalls++;
+	return SDL_RenderClear(Display::getRenderer());
+}
+
+/*
+* Changes the render target
+*
+* @param target, The texture to draw to, NULL for the screen
+* @return int, 0 on success, otherwise an error occured
+*/
+int DrawQueue::setTarget(SDL_Texture* target) {
+	flush();
+	return SDL_SetRenderTarget(Display::getRenderer(), target);
+}
+
+/*
+* Changes the clip rect
+*
+* @param area, The area to clip to, NULL for none
+* @return int, 0 on success, otherwise an error occured
+*/
+int DrawQueue::setClipRect(const SDL_Rect* area) {
+	flush();
+	return SDL_RenderSetClipRect(Display::getRenderer(), area);
+}
+
+/*
+* Finishes counting the frame's calls, the getters report them until the next frame ends
+*/
+void DrawQueue::endFrame() {
+	lastDrawCalls = drawCalls;
+	lastBatches = batches;
+	lastQueued = queued;
+	drawCalls = batches = queued = 0;
+}
+
+
+/*
+* Gets the amount of renderer draw calls made last frame
+*
+* @return int, The amount of draw calls
+*/
+int DrawQueue::getDrawCalls() { return lastDrawCalls; }
+
+/*
+* Gets the amount of batches last frame
+*
+* @return int, The amount of batches
+*/
+int DrawQueue::getBatches() { return lastBatches; }
+
+/*
+* Gets the amount of draws queued last frame
+*
+* @return int, The amount of draws
+*/
+int DrawQueue::getCommands() { return lastQueued; }
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "SDL.h"
+
+/*
+* Collects the frame's draws, then issues them in as few renderer calls as it can
+* Draws with the same texture / color are grouped together, fills become one SDL_RenderFillRectsF each,
+* a draw is only moved ahead of the ones it doesn't overlap so the picture stays the same
+* NOTE: Main thread only, the queue is flushed whenever the render target or clip rect changes
+*/
+namespace DrawQueue {
+	//Queues a filled rect
+	void fillRect(const SDL_Rect&, SDL_Color, SDL_BlendMode = SDL_BLENDMODE_BLEND);
+
+	//Queues a copy of (part of) a texture, tinted by a color
+	void copy(SDL_Texture*, const SDL_Rect* source, const SDL_FRect& destination, SDL_Color tint = { 255, 255, 255, 255 });
+
+	//Queues a copy of (part of) a texture to a pixel area
+	void copy(SDL_Texture*, const SDL_Rect* source, const SDL_Rect& destination);
+
+	//Draws everything queued onto the current render target
+	int flush();
+
+	//Fills the whole render target with a color, ignoring the clip rect
+	int clear(SDL_Color);
+
+	//Changes the render target, after drawing what was queued for the old one
+	int setTarget(SDL_Texture*);
+
+	//Changes the clip rect, after drawing what was queued inside the old one
+	int setClipRect(const SDL_Rect*);
+
+	//Finishes counting the frame's calls
+	void endFrame();
+
+	/// Getters
+
+	//Gets the amount of renderer draw calls made last frame
+	int getDrawCalls();
+
+	//Gets the amount of batches (texture / color changes) last frame
+	int getBatches();
+
+	//Gets the amount of draws queued last frame
+	int getCommands();
+};
@@ -0,0 +1,116 @@
+#include "SkylinePacker.h"
+
+#include "SDL_assert.h"
+
+
+/*
+* Constructor
+*
+* @param width, The width of the area
+* @param height, The height of the area
+*/
+SkylinePacker::SkylinePacker(int width, int height) : width(width), height(height) {
+	SDL_assert(width > 0 && height > 0);
+	clear();
+}
+
+/*
+* Empties the area, leaving a flat skyline
+*/
+void SkylinePacker::clear() {
+	skyline.clear();
+	skyline.push_back({ 0, 0, width });
+	usedArea = 0;
+}
+
+/*
+* Finds how high a rectangle would sit if its left edge was placed at a segment
+* It rests on the highest segment it spans
+*
+* @param segment, The index of the segment
+* @param w, The width of the rectangle
+* @param h, The height of the rectangle
+* @return int, The top of the rectangle, -1 if it doesn't fit
+*/
+int SkylinePacker::getFitY(size_t segment, int w, int h) const {
+	if (skyline[segment].x + w > width) return -1;
+
+	int y = 0;
+	int widthLeft = w;
+	for (size_t i = segment; widthLeft > 0; i++) {
+		y = SDL_max(y, skyline[i].y);
+		if (y + h > height) return -1;
+		widthLeft -= skyline[i].w;
+	}
+	return y;
+}
+
+/*
+* Finds a place for a rectangle
+* Picks the position that leaves the lowest top edge, then the narrowest segment
+*
+* @param w, The width of the rectangle
+* @param h, The height of the rectangle
+* @param position, Set to the top left of the rectangle
+* @return bool, true if the rectangle was packed, false if the area is full
+*/
+bool SkylinePacker::pack(int w, int h, SDL_Point& position) {
+	SDL_assert(w > 0 && h > 0);
+	if (w <= 0 || h <= 0) return false;
+
+	int bestIndex = -1;
+	int bestTop = height + 1;
+	int bestWidth = width + 1;
+	for (size_t i = 0; i < skyline.size(); i++) {
+		int y = getFitY(i, w, h);
+		if (y < 0) continue;
+
+		if (y + h < bestTop || (y + h == bestTop && skyline[i].w < bestWidth)) {
+			bestIndex = (int)i;
+			bestTop = y + h;
+			bestWidth = skyline[i].w;
+		}
+	}
+
+	if (bestIndex < 0) return false;
+
+	position.x = skyline[bestIndex].x;
+	position.y = bestTop - h;
+
+	//Raises the skyline over the rectangle
+	skyline.insert(skyline.begin() + bestIndex, { position.x, bestTop, w });
+
+	//Cuts back the segments it now covers
+	int right = position.x + w;
+	for (size_t i = bestIndex + 1; i < skyline.size();) {
+		if (skyline[i].x >= right) break;
+
+		int covered = right - skyline[i].x;
+		if (covered >= skyline[i].w) {
+			skyline.erase(skyline.begin() + i);
+			continue;
+		}
+		skyline[i].x += covered;
+		skyline[i].w -= covered;
+		break;
+	}
+
+	//Merges neighbours at the same height
+	for (size_t i = 0; i + 1 < skyline.size();) {
+		if (skyline[i].y == skyline[i + 1].y) {
+			skyline[i].w += skyline[i + 1].w;
+			skyline.erase(skyline.begin() + i + 1);
+		}
+		else i++;
+	}
+
+	usedArea += w * h;
+	return true;
+}
+
+/*
+* Gets the fraction of the area that has been packed
+*
+* @return float, From 0 (empty) to 1 (full)
+*/
+float SkylinePacker::getOccupancy() const { return (float)usedArea / ((float)width * height); }
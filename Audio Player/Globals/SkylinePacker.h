@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+
+#include "SDL_rect.h"
+
+/*
+* Packs rectangles into a fixed size area, bottom-left first
+* Only the top edge (the skyline) of what's been packed is kept, so packing is O(segments)
+*/
+class SkylinePacker {
+private:
+	//A horizontal segment of the skyline
+	struct Segment {
+		int x;
+		int y;
+		int w;
+	};
+
+	//The size of the area
+	int width;
+	int height;
+
+	//The skyline from left to right
+	std::vector<Segment> skyline;
+
+	//The area covered by packed rectangles
+	int usedArea;
+
+	//Finds how high a rectangle would sit if placed at a segment, -1 if it doesn't fit
+	int getFitY(size_t segment, int w, int h) const;
+public:
+	//Constructor
+	SkylinePacker(int width, int height);
+
+	//Finds a place for a rectangle, false if the area is full
+	bool pack(int w, int h, SDL_Point& position);
+
+	//Empties the area
+	void clear();
+
+	/// Getters
+
+	//Gets the fraction of the area that has been packed (0 - 1)
+	float getOccupancy() const;
+};
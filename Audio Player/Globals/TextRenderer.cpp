@@ -0,0 +1,345 @@
+#include "TextRenderer.h"
+
+#include <unordered_map>
+#include <vector>
+
+#include "SDL_ttf.h"
+#include "SDL_assert.h"
+
+#include "Display.h"
+#include "DrawQueue.h"
+#include "SkylinePacker.h"
+
+//The size of each atlas texture
+#define PAGE_SIZE 1024
+//The empty space kept around each glyph so neighbours don't bleed in when scaled
+#define GLYPH_PADDING 1
+//Drawn in place of characters the atlas can't hold
+#define REPLACEMENT_CHARACTER '?'
+
+/*
+* A glyph in the atlas
+*/
+struct Glyph {
+	//The atlas texture holding the glyph, -1 if it has nothing to draw (spaces)
+	int page;
+	//Where the glyph is in the atlas texture
+	SDL_Rect source;
+	//Where the glyph is drawn from, relative to the pen
+	int offsetX;
+	//How far the pen moves after the glyph
+	int advance;
+};
+
+/*
+* An atlas texture and the space left in it
+*/
+struct AtlasPage {
+	SDL_Texture* texture;
+	SkylinePacker packer;
+};
+
+static bool rendererInitialized = false;
+
+static std::vector<AtlasPage> pages;
+
+//Every rasterized glyph by font and character
+static std::unordered_map<Uint64, Glyph> glyphs;
+
+
+/*
+* Decodes the character starting at an index of a UTF-8 string
+* Malformed bytes decode as the replacement character
+*
+* @param text, The UTF-8 string
+* @param index, The index of the character, moved past it
+* @return Uint32, The character
+*/
+static Uint32 nextCharacter(const std::string& text, size_t& index) {
+	Uint8 lead = (Uint8)text[index++];
+	if (lead < 0x80) return lead;
+
+	int length = (lead >= 0xF0 ? 3 : (lead >= 0xE0 ? 2 : (lead >= 0xC0 ? 1 : -1)));
+	if (length < 0) return REPLACEMENT_CHARACTER;
+
+	Uint32 character = lead & (0x3F >> length);
+	for (int i = 0; i < length; i++) {
+		if (index >= text.size() || ((Uint8)text[index] & 0xC0) != 0x80)
+			return REPLACEMENT_CHARACTER;
+		character = (character << 6) | ((Uint8)text[index++] & 0x3F);
+	}
+	return character;
+}
+
+/*
+* Encodes a character of the Basic Multilingual Plane as UTF-8
+*
+* @param character, The character
+* @param utf8, Filled with the null terminated bytes
+*/
+static void encodeCharacter(Uint16 character, char utf8[4]) {
+	if (character < 0x80) {
+		utf8[0] = (char)character;
+		utf8[1] = 0;
+	}
+	else if (character < 0x800) {
+		utf8[0] = (char)(0xC0 | (character >> 6));
+		utf8[1] = (char)(0x80 | (character & 0x3F));
+		utf8[2] = 0;
+	}
+	else {
+		utf8[0] = (char)(0xE0 | (character >> 12));
+		utf8[1] = (char)(0x80 | ((character >> 6) & 0x3F));
+		utf8[2] = (char)(0x80 | (character & 0x3F));
+		utf8[3] = 0;
+	}
+}
+
+/*
+* Creates an empty atlas texture
+*
+* @return int, The index of the page, -1 if it couldn't be created
+*/
+static int addPage() {
+	SDL_Texture* texture = SDL_CreateTexture(Display::getRenderer(), SDL_PIXELFORMAT_ARGB8888,
+		SDL_TEXTUREACCESS_STATIC, PAGE_SIZE, PAGE_SIZE);
+	if (texture == nullptr) return -1;
+
+	//New textures aren't cleared, and the padding around glyphs has to be transparent
+	std::vector<Uint32> transparent((size_t)PAGE_SIZE * PAGE_SIZE, 0);
+	SDL_UpdateTexture(texture, NULL, transparent.data(), PAGE_SIZE * sizeof(Uint32));
+	SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+	pages.push_back({ texture, SkylinePacker(PAGE_SIZE, PAGE_SIZE) });
+	return (int)pages.size() - 1;
+}
+
+/*
+* Rasterizes a glyph into the atlas
+* Glyphs are rendered white so any color can be applied when drawing
+*
+* @param font, The font to render with
+* @param character, The character to render
+* @return Glyph, The glyph, with no page if it has nothing to draw
+*/
+static Glyph rasterize(TTF_Font* font, Uint16 character) {
+	Glyph glyph = { -1, { 0, 0, 0, 0 }, 0, 0 };
+
+	int minX, maxX, minY, maxY;
+	if (TTF_GlyphMetrics(font, character, &minX, &maxX, &minY, &maxY, &glyph.advance) != 0)
+		return glyph;
+
+	//Rendered like a one character string, which starts at the further left of the pen and the glyph
+	char utf8[4];
+	encodeCharacter(character, utf8);
+	SDL_Color white = { 255, 255, 255, 255 };
+	SDL_Surface* rendered = TTF_RenderUTF8_Blended(font, utf8, white);
+	if (rendered == nullptr) return glyph;
+
+	SDL_Surface* surface = SDL_ConvertSurfaceFormat(rendered, SDL_PIXELFORMAT_ARGB8888, 0);
+	SDL_FreeSurface(rendered);
+	if (surface == nullptr) return glyph;
+
+	int paddedW = surface->w + GLYPH_PADDING * 2;
+	int paddedH = surface->h + GLYPH_PADDING * 2;
+	SDL_assert(paddedW <= PAGE_SIZE && paddedH <= PAGE_SIZE);
+
+	//Packs into the newest page, starting another once it's full
+	SDL_Point position;
+	int page = (int)pages.size() - 1;
+	if (page < 0 || !pages[page].packer.pack(paddedW, paddedH, position)) {
+		page = addPage();
+		if (page < 0 || !pages[page].packer.pack(paddedW, paddedH, position)) {
+			SDL_FreeSurface(surface);
+			return glyph;
+		}
+	}
+
+	glyph.page = page;
+	glyph.source = { position.x + GLYPH_PADDING, position.y + GLYPH_PADDING, surface->w, surface->h };
+	glyph.offsetX = SDL_min(minX, 0);
+	SDL_UpdateTexture(pages[page].texture, &glyph.source, surface->pixels, surface->pitch);
+
+	SDL_FreeSurface(surface);
+	return glyph;
+}
+
+/*
+* Gets a glyph, rasterizing it the first time
+*
+* @param name, The font
+* @param font, The loaded font
+* @param character, The character
+* @return const Glyph&, The glyph
+*/
+static const Glyph& getGlyph(FontName name, TTF_Font* font, Uint32 character) {
+	//TTF only handles the Basic Multilingual Plane
+	if (character > 0xFFFF)
+		character = REPLACEMENT_CHARACTER;
+
+	Uint64 key = ((Uint64)name << 32) | character;
+	auto found = glyphs.find(key);
+	if (found != glyphs.end())
+		return found->second;
+
+	return glyphs.emplace(key, rasterize(font, (Uint16)character)).first->second;
+}
+
+/*
+* Gets the kerning between two characters
+*
+* @param font, The loaded font
+* @param previous, The character before, 0 at the start of the string
+* @param character, The character
+* @return int, The adjustment to the pen
+*/
+static int getKerning(TTF_Font* font, Uint32 previous, Uint32 character) {
+	if (previous == 0 || previous > 0xFFFF || character > 0xFFFF) return 0;
+	return TTF_GetFontKerningSizeGlyphs(font, (Uint16)previous, (Uint16)character);
+}
+
+
+/*
+* Initializes the text renderer
+* NOTE: The display and fonts have to be initialized first
+*
+* @return bool, true if the text renderer was initialized
+*/
+bool TextRenderer::init() {
+	SDL_assert(!loaded());
+	if (loaded()) return true;
+
+	SDL_assert(Display::getRenderer() != nullptr && Font::loaded());
+	if (Display::getRenderer() == nullptr || !Font::loaded()) return false;
+
+	rendererInitialized = true;
+	return true;
+}
+
+/*
+* Closes the text renderer, freeing the atlas
+*/
+void TextRenderer::close() {
+	SDL_assert(loaded());
+	if (!loaded()) return;
+
+	clear();
+	rendererInitialized = false;
+}
+
+/*
+* Checks that the text renderer is loaded
+*
+* @return bool, true if the text renderer is loaded
+*/
+bool TextRenderer::loaded() { return rendererInitialized; }
+
+/*
+* Drops every glyph and atlas texture
+* Glyphs are rasterized again when they're next drawn
+*/
+void TextRenderer::clear() {
+	for (AtlasPage& page : pages)
+		SDL_DestroyTexture(page.texture);
+	pages.clear();
+	glyphs.clear();
+}
+
+
+/*
+* Gets the size a string is drawn at (unscaled)
+*
+* @param name, The font to measure with
+* @param text, The UTF-8 string
+* @param w, Set to the width of the string
+* @param h, Set to the height of the string
+* @return int, 0 on success
+*/
+int TextRenderer::measure(FontName name, const std::string& text, int& w, int& h) {
+	w = h = 0;
+	SDL_assert(loaded());
+	if (!loaded()) return -1;
+
+	TTF_Font* font = Font::getFontByNameMut(name);
+	h = TTF_FontHeight(font);
+
+	int pen = 0;
+	Uint32 previous = 0;
+	for (size_t i = 0; i < text.size();) {
+		Uint32 character = nextCharacter(text, i);
+		const Glyph& glyph = getGlyph(name, font, character);
+
+		pen += getKerning(font, previous, character);
+		//Glyphs can reach past their advance (italics, ...)
+		w = SDL_max(w, pen + glyph.offsetX + glyph.source.w);
+		pen += glyph.advance;
+		previous = character;
+	}
+	w = SDL_max(w, pen);
+	return 0;
+}
+
+/*
+* Draws a string from the atlas
+* Each glyph is a copy from an atlas texture, queued so glyphs on the same page are drawn together
+*
+* @param name, The font to draw with
+* @param text, The UTF-8 string
+* @param x, The left of the string
+* @param y, The top of the string
+* @param color, The color of the string
+* @param scale, The size relative to the font's size
+* @return int, 0 on success
+*/
+int TextRenderer::draw(FontName name, const std::string& text, int x, int y, SDL_Color color, float scale) {
+	SDL_assert(loaded());
+	if (!loaded()) return -1;
+
+	TTF_Font* font = Font::getFontByNameMut(name);
+
+	int pen = 0;
+	Uint32 previous = 0;
+	for (size_t i = 0; i < text.size();) {
+		Uint32 character = nextCharacter(text, i);
+		const Glyph& glyph = getGlyph(name, font, character);
+		pen += getKerning(font, previous, character);
+		previous = character;
+
+		if (glyph.page >= 0) {
+			SDL_FRect renderArea = { x + (pen + glyph.offsetX) * scale, (float)y,
+				glyph.source.w * scale, glyph.source.h * scale };
+			DrawQueue::copy(pages[glyph.page].texture, &glyph.source, renderArea, color);
+		}
+		pen += glyph.advance;
+	}
+	return 0;
+}
+
+
+/*
+* Gets the amount of glyphs in the atlas
+*
+* @return int, The amount of glyphs
+*/
+int TextRenderer::getGlyphCount() { return (int)glyphs.size(); }
+
+/*
+* Gets the amount of atlas textures
+*
+* @return int, The amount of textures
+*/
+int TextRenderer::getPageCount() { return (int)pages.size(); }
+
+/*
+* Gets the fraction of the atlas that's been packed
+*
+* @return float, From 0 (empty) to 1 (full)
+*/
+float TextRenderer::getOccupancy() {
+	if (pages.empty()) return 0;
+
+	float occupancy = 0;
+	for (const AtlasPage& page : pages)
+		occupancy += page.packer.getOccupancy();
+	return occupancy / pages.size();
+}
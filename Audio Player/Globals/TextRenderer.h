@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string>
+
+#include "SDL.h"
+
+#include "Font.h"
+
+/*
+* Draws text from a shared glyph atlas
+* Glyphs are rasterized the first time they're drawn and packed into a few atlas textures,
+* so any string is drawn without rendering a texture for it
+*/
+namespace TextRenderer {
+	//Initializes the text renderer, after the display and fonts
+	bool init();
+
+	//Closes the text renderer, freeing the atlas
+	void close();
+
+	//Checks that the text renderer is loaded
+	bool loaded();
+
+	//Gets the size a string is drawn at
+	int measure(FontName, const std::string& text, int& w, int& h);
+
+	//Draws a string with its top left at x, y, scaled from the font's size
+	int draw(FontName, const std::string& text, int x, int y, SDL_Color color, float scale = 1);
+
+	//Drops every glyph, they're rasterized again when next drawn
+	void clear();
+
+	/// Getters
+
+	//Gets the amount of glyphs in the atlas
+	int getGlyphCount();
+
+	//Gets the amount of atlas textures
+	int getPageCount();
+
+	//Gets the fraction of the atlas that's been packed (0 - 1)
+	float getOccupancy();
+};
@@ -0,0 +1,361 @@
+#include "TextureCache.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "SDL_image.h"
+#include "SDL_assert.h"
+
+#include "Display.h"
+#include "Worker.h"
+
+//The default budget for unreferenced textures (bytes)
+#define DEFAULT_BUDGET (64 * 1024 * 1024)
+
+/*
+* A texture loaded from an image
+*/
+struct CachedTexture {
+	SDL_Texture* texture;
+	//The amount of holders
+	int references;
+	//The memory the texture takes (bytes)
+	Sint64 bytes;
+	//When it was last acquired / released, to evict the least recently used
+	Uint32 lastUsed;
+};
+
+//The textures by path, and the paths by texture
+static std::unordered_map<std::string, CachedTexture> textures;
+static std::unordered_map<SDL_Texture*, std::string> texturePaths;
+
+//The images decoded in the background waiting to be uploaded, and the ones still decoding
+static std::unordered_map<std::string, SDL_Surface*> decoded;
+static std::unordered_set<std::string> decoding;
+//The ones still decoding that were acquired first, they're freed when they land
+static std::unordered_set<std::string> superseded;
+//The memory the decoded images take (bytes)
+static Sint64 decodedBytes = 0;
+static std::mutex decodedMutex;
+
+static Sint64 budget = DEFAULT_BUDGET;
+static Sint64 cachedBytes = 0;
+
+//Counts up each use
+static Uint32 useClock = 0;
+
+static Uint32 hits = 0;
+static Uint32 loads = 0;
+static Uint32 preloads = 0;
+static Uint32 evictions = 0;
+
+
+/*
+* Gets the memory an image takes once it's a texture
+*
+* @param surface, The image
+* @return Sint64, The memory (bytes)
+*/
+static Sint64 getImageBytes(const SDL_Surface* surface) {
+	return (Sint64)surface->w * surface->h * 4;
+}
+
+/*
+* Destroys the least recently used unreferenced textures until the cache is within budget
+* The decoded images waiting to be uploaded count too, and are freed once there are no textures left to evict
+* Referenced textures are never evicted, so the budget can be exceeded by what's in use
+*/
+static void evict() {
+	std::lock_guard<std::mutex> lock(decodedMutex);
+	while (cachedBytes + decodedBytes > budget) {
+		auto oldest = textures.end();
+		for (auto it = textures.begin(); it != textures.end(); it++) {
+			if (it->second.references == 0 && (oldest == textures.end() || it->second.lastUsed < oldest->second.lastUsed))
+				oldest = it;
+		}
+
+		if (oldest != textures.end()) {
+			cachedBytes -= oldest->second.bytes;
+			texturePaths.erase(oldest->second.texture);
+			SDL_DestroyTexture(oldest->second.texture);
+			textures.erase(oldest);
+		}
+		//They can be decoded again if they're acquired
+		else if (!decoded.empty()) {
+			auto image = decoded.begin();
+			decodedBytes -= getImageBytes(image->second);
+			SDL_FreeSurface(image->second);
+			decoded.erase(image);
+		}
+		else return;
+		evictions++;
+	}
+}
+
+/*
+* Destroys every unreferenced texture
+*/
+static void dropUnreferenced() {
+	for (auto it = textures.begin(); it != textures.end();) {
+		if (it->second.references == 0) {
+			cachedBytes -= it->second.bytes;
+			texturePaths.erase(it->second.texture);
+			SDL_DestroyTexture(it->second.texture);
+			it = textures.erase(it);
+		}
+		else it++;
+	}
+}
+
+/*
+* Takes an image decoded in the background
+*
+* @param path, The path to the image
+* @return SDL_Surface*, The image owned by the caller, nullptr if it wasn't decoded
+*/
+static SDL_Surface* takeDecoded(const std::string& path) {
+	std::lock_guard<std::mutex> lock(decodedMutex);
+	auto found = decoded.find(path);
+	if (found == decoded.end()) return nullptr;
+
+	SDL_Surface* surface = found->second;
+	decodedBytes -= getImageBytes(surface);
+	decoded.erase(found);
+	return surface;
+}
+
+/*
+* Marks an image still being preloaded as no longer needed, as it's being decoded on the main thread
+* Its surface is freed when it lands, instead of waiting to be uploaded next to the texture
+*
+* @param path, The path to the image
+*/
+static void supersedeDecoding(const std::string& path) {
+	std::lock_guard<std::mutex> lock(decodedMutex);
+	if (decoding.count(path))
+		superseded.insert(path);
+}
+
+
+/*
+* Gets the texture for an image
+* Uses the image decoded by preload if it's ready, otherwise decodes it now and drops the preload
+*
+* @param path, The path to the image
+* @return SDL_Texture*, The texture, nullptr if it couldn't be loaded
+*/
+SDL_Texture* TextureCache::acquire(const std::string& path) {
+	auto found = textures.find(path);
+	if (found != textures.end()) {
+		found->second.references++;
+		found->second.lastUsed = ++useClock;
+		hits++;
+		return found->second.texture;
+	}
+
+	SDL_Surface* surface = takeDecoded(path);
+	if (surface != nullptr)
+		preloads++;
+	else {
+		supersedeDecoding(path);
+		surface = IMG_Load(path.c_str());
+		loads++;
+	}
+	if (surface == nullptr) return nullptr;
+
+	SDL_Texture* texture = SDL_CreateTextureFromSurface(Display::getRenderer(), surface);
+	Sint64 bytes = getImageBytes(surface);
+	SDL_FreeSurface(surface);
+	if (texture == nullptr) return nullptr;
+
+	textures[path] = { texture, 1, bytes, ++useClock };
+	texturePaths[texture] = path;
+	cachedBytes += bytes;
+
+	evict();
+	return texture;
+}
+
+/*
+* Drops a reference to a texture
+* The texture stays cached, it's only destroyed once the budget needs the space
+*
+* @param texture, The texture from acquire
+*/
+void TextureCache::release(SDL_Texture* texture) {
+	if (texture == nullptr) return;
+
+	auto path = texturePaths.find(texture);
+	SDL_assert(path != texturePaths.end());
+	if (path == texturePaths.end()) return;
+
+	CachedTexture& cached = textures[path->second];
+	SDL_assert(cached.references > 0);
+	if (cached.references > 0)
+		cached.references--;
+	cached.lastUsed = ++useClock;
+
+	evict();
+}
+
+/*
+* Decodes an image on the worker thread
+* Only the decoding is in the background, the texture is made when it's acquired
+*
+* @param path, The path to the image
+* @return bool, true if the image is (or will be) ready
+*/
+bool TextureCache::preload(const std::string& path) {
+	if (path.empty() || !Worker::loaded()) return false;
+	if (textures.find(path) != textures.end()) return true;
+
+	{
+		std::lock_guard<std::mutex> lock(decodedMutex);
+		//Wanted again before the one still decoding lands
+		if (decoding.count(path)) {
+			superseded.erase(path);
+			return true;
+		}
+		if (decoded.count(path)) return true;
+		decoding.insert(path);
+	}
+
+	return Worker::submit([path]() {
+		SDL_Surface* surface = IMG_Load(path.c_str());
+
+		std::lock_guard<std::mutex> lock(decodedMutex);
+		decoding.erase(path);
+		//Acquired while it was decoding, the texture was made from a decode of its own
+		if (superseded.erase(path)) {
+			SDL_FreeSurface(surface);
+			return;
+		}
+		if (surface != nullptr) {
+			decoded[path] = surface;
+			decodedBytes += getImageBytes(surface);
+		}
+	});
+}
+
+/*
+* Destroys every unreferenced texture and decoded image
+* NOTE: Must be called before the display quits
+*/
+void TextureCache::clear() {
+	dropUnreferenced();
+
+	std::lock_guard<std::mutex> lock(decodedMutex);
+	for (auto& image : decoded)
+		SDL_FreeSurface(image.second);
+	decoded.clear();
+	decodedBytes = 0;
+}
+
+
+/*
+* Loads the referenced textures again after the renderer lost them (SDL_RENDER_DEVICE_RESET)
+* The unreferenced ones are dropped, they're loaded again if they're acquired
+* NOTE: Holders have to swap their texture for the one from getTexture
+*/
+void TextureCache::reload() {
+	dropUnreferenced();
+
+	for (auto it = textures.begin(); it != textures.end();) {
+		texturePaths.erase(it->second.texture);
+		SDL_DestroyTexture(it->second.texture);
+
+		SDL_Surface* surface = IMG_Load(it->first.c_str());
+		SDL_Texture* texture = (surface != nullptr ? SDL_CreateTextureFromSurface(Display::getRenderer(), surface) : nullptr);
+		SDL_FreeSurface(surface);
+		loads++;
+
+		//Holders find nothing cached, and render nothing until they set their texture again
+		if (texture == nullptr) {
+			cachedBytes -= it->second.bytes;
+			it = textures.erase(it);
+			continue;
+		}
+
+		it->second.texture = texture;
+		texturePaths[texture] = it->first;
+		it++;
+	}
+}
+
+
+/*
+* Sets how much texture memory unreferenced textures are kept within
+*
+* @param bytes, The budget
+*/
+void TextureCache::setBudget(Sint64 bytes) {
+	SDL_assert(bytes >= 0);
+	if (bytes < 0) return;
+
+	budget = bytes;
+	evict();
+}
+
+/*
+* Gets the texture cached for an image, without taking a reference
+*
+* @param path, The path to the image
+* @return SDL_Texture*, The texture, nullptr if it isn't cached
+*/
+SDL_Texture* TextureCache::getTexture(const std::string& path) {
+	auto found = textures.find(path);
+	return (found != textures.end() ? found->second.texture : nullptr);
+}
+
+/*
+* Gets the memory budget
+*
+* @return Sint64, The budget (bytes)
+*/
+Sint64 TextureCache::getBudget() { return budget; }
+
+/*
+* Gets the memory held by the cached textures, referenced or not, and the decoded images waiting to be uploaded
+*
+* @return Sint64, The memory (bytes)
+*/
+Sint64 TextureCache::getBytes() {
+	std::lock_guard<std::mutex> lock(decodedMutex);
+	return cachedBytes + decodedBytes;
+}
+
+/*
+* Gets the amount of cached textures
+*
+* @return int, The amount of textures
+*/
+int TextureCache::getCount() { return (int)textures.size(); }
+
+/*
+* Gets the amount of acquires that found the texture cached
+*
+* @return Uint32, The amount of hits
+*/
+Uint32 TextureCache::getHits() { return hits; }
+
+/*
+* Gets the amount of images decoded on the main thread
+*
+* @return Uint32, The amount of loads
+*/
+Uint32 TextureCache::getLoads() { return loads; }
+
+/*
+* Gets the amount of images decoded in the background
+*
+* @return Uint32, The amount of preloads used
+*/
+Uint32 TextureCache::getPreloads() { return preloads; }
+
+/*
+* Gets the amount of textures evicted to stay in budget
+*
+* @return Uint32, The amount of evictions
+*/
+Uint32 TextureCache::getEvictions() { return evictions; }
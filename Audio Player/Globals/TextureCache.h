@@ -0,0 +1,58 @@
+#pragma once
+
+#include <string>
+
+#include "SDL.h"
+
+/*
+* Shares the textures loaded from image files, each file is decoded once however many Interactables show it
+* Textures are reference counted, unreferenced ones stay cached until the memory budget needs the space
+* NOTE: Main thread only, except the decoding started by preload
+*/
+namespace TextureCache {
+	//Gets the texture for an image, loading it the first time, the caller holds a reference
+	SDL_Texture* acquire(const std::string& path);
+
+	//Drops a reference to a texture from acquire
+	void release(SDL_Texture*);
+
+	//Decodes an image in the background, so acquiring it later doesn't read the disk
+	bool preload(const std::string& path);
+
+	//Destroys every unreferenced texture and decoded image
+	void clear();
+
+	//Loads the referenced textures again after the renderer lost them
+	void reload();
+
+	/// Setters
+
+	//Sets how much texture memory unreferenced textures are kept within (bytes)
+	void setBudget(Sint64);
+
+	/// Getters
+
+	//Gets the texture cached for an image without taking a reference, nullptr if it isn't cached
+	SDL_Texture* getTexture(const std::string& path);
+
+	//Gets the memory budget (bytes)
+	Sint64 getBudget();
+
+	//Gets the memory held by the cached textures and decoded images (bytes)
+	Sint64 getBytes();
+
+	//Gets the amount of cached textures
+	int getCount();
+
+	//Gets the amount of acquires that found the texture cached
+	Uint32 getHits();
+
+	//Gets the amount of images decoded on the main thread
+	Uint32 getLoads();
+
+	//Gets the amount of images decoded in the background
+	Uint32 getPreloads();
+
+	//Gets the amount of textures evicted to stay in budget
+	Uint32 getEvictions();
+};
@@ -0,0 +1,171 @@
+#include "TexturePool.h"
+
+#include <unordered_map>
+#include <vector>
+
+#include "SDL_assert.h"
+
+#include "Display.h"
+
+//Sizes are rounded up to a multiple of this (pixels)
+#define BUCKET_SIZE 64
+//The most textures kept waiting in the pool, any more are destroyed
+#define MAX_POOLED_TEXTURES 16
+
+//The released textures by bucket
+static std::unordered_map<Uint64, std::vector<SDL_Texture*>> pooled;
+static int pooledCount = 0;
+
+static unsigned int created = 0;
+static unsigned int reused = 0;
+
+//Creations are counted over whole seconds
+static Uint32 secondStart = 0;
+static unsigned int createdThisSecond = 0;
+static unsigned int createdLastSecond = 0;
+
+
+/*
+* Rounds a size up to its bucket
+*
+* @param size, The size in pixels
+* @return int, The size of the bucket
+*/
+static int roundToBucket(int size) {
+	size = SDL_max(size, 1);
+	return (size + BUCKET_SIZE - 1) / BUCKET_SIZE * BUCKET_SIZE;
+}
+
+/*
+* Gets the key of a bucket
+*
+* @param w, The rounded width
+* @param h, The rounded height
+* @return Uint64, The key
+*/
+static Uint64 getBucketKey(int w, int h) {
+	return ((Uint64)w << 32) | (Uint32)h;
+}
+
+/*
+* Moves the creation count on to the current second
+*/
+static void rollSecond() {
+	Uint32 now = SDL_GetTicks();
+	if (now - secondStart < 1000) return;
+
+	//Nothing was created in the last full second if more than one passed
+	createdLastSecond = (now - secondStart < 2000 ? createdThisSecond : 0);
+	createdThisSecond = 0;
+	secondStart = now;
+}
+
+
+/*
+* Gets a render target texture at least the size given, reusing a released one when it can
+*
+* @param w, The width needed
+* @param h, The height needed
+* @return SDL_Texture*, The texture, nullptr if it couldn't be created
+*/
+SDL_Texture* TexturePool::acquire(int w, int h) {
+	int bucketW = roundToBucket(w);
+	int bucketH = roundToBucket(h);
+
+	auto found = pooled.find(getBucketKey(bucketW, bucketH));
+	if (found != pooled.end() && !found->second.empty()) {
+		SDL_Texture* texture = found->second.back();
+		found->second.pop_back();
+		pooledCount--;
+		reused++;
+		return texture;
+	}
+
+	SDL_Texture* texture = SDL_CreateTexture(Display::getRenderer(), SDL_PIXELFORMAT_ARGB8888,
+		SDL_TEXTUREACCESS_TARGET, bucketW, bucketH);
+	if (texture == nullptr) return nullptr;
+
+	rollSecond();
+	created++;
+	createdThisSecond++;
+	return texture;
+}
+
+/*
+* Gives a texture back to the pool, destroying it if the pool is full
+*
+* @param texture, The texture from acquire
+*/
+void TexturePool::release(SDL_Texture* texture) {
+	if (texture == nullptr) return;
+
+	int w, h;
+	if (pooledCount >= MAX_POOLED_TEXTURES || SDL_QueryTexture(texture, NULL, NULL, &w, &h) != 0) {
+		SDL_DestroyTexture(texture);
+		return;
+	}
+
+	pooled[getBucketKey(w, h)].push_back(texture);
+	pooledCount++;
+}
+
+/*
+* Checks that a texture is the one the pool would give for a size, so it can be kept for that size
+*
+* @param texture, The texture from acquire
+* @param w, The width needed
+* @param h, The height needed
+* @return bool, true if the texture is in the size's bucket
+*/
+bool TexturePool::fits(SDL_Texture* texture, int w, int h) {
+	int textureW, textureH;
+	if (texture == nullptr || SDL_QueryTexture(texture, NULL, NULL, &textureW, &textureH) != 0)
+		return false;
+
+	return textureW == roundToBucket(w) && textureH == roundToBucket(h);
+}
+
+/*
+* Destroys every texture waiting in the pool
+* NOTE: Must be called before the display quits
+*/
+void TexturePool::clear() {
+	for (auto& bucket : pooled) {
+		for (SDL_Texture* texture : bucket.second)
+			SDL_DestroyTexture(texture);
+	}
+	pooled.clear();
+	pooledCount = 0;
+}
+
+
+/*
+* Gets the amount of textures created
+*
+* @return unsigned int, The amount of textures created
+*/
+unsigned int TexturePool::getCreated() { return created; }
+
+/*
+* Gets the amount of textures handed out again instead of created
+*
+* @return unsigned int, The amount of textures reused
+*/
+unsigned int TexturePool::getReused() { return reused; }
+
+/*
+* Gets the amount of textures created in the last full second
+*
+* @return unsigned int, The creations per second
+*/
+unsigned int TexturePool::getCreationsPerSecond() {
+	rollSecond();
+	return createdLastSecond;
+}
+
+/*
+* Gets the amount of textures waiting in the pool
+*
+* @return int, The amount of pooled textures
+*/
+int TexturePool::getPooledCount() { return pooledCount; }
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "SDL.h"
+
+/*
+* Keeps render target textures around once they're released, so they can be reused instead of recreated
+* Sizes are rounded up into buckets, so a texture fits any size in its bucket
+* NOTE: Main thread only, textures returned may be bigger than asked for
+*/
+namespace TexturePool {
+	//Gets a render target texture at least the size given
+	SDL_Texture* acquire(int w, int h);
+
+	//Gives a texture back to the pool
+	void release(SDL_Texture*);
+
+	//Checks that a texture is the one the pool would give for a size
+	bool fits(SDL_Texture*, int w, int h);
+
+	//Destroys every texture waiting in the pool
+	void clear();
+
+	/// Getters
+
+	//Gets the amount of textures created
+	unsigned int getCreated();
+
+	//Gets the amount of textures handed out again instead of created
+	unsigned int getReused();
+
+	//Gets the amount of textures created in the last full second
+	unsigned int getCreationsPerSecond();
+
+	//Gets the amount of textures waiting in the pool
+	int getPooledCount();
+};
@@ -0,0 +1,132 @@
+#include "Worker.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "SDL_assert.h"
+
+static std::thread* workerThread = nullptr;
+
+//The jobs waiting to run, one queue per priority
+static std::deque<std::function<void()>> jobs[(int)JobPriority::Low + 1];
+static std::mutex jobsMutex;
+static std::condition_variable jobsChanged;
+
+//Should the worker thread stop
+static bool stopping = false;
+
+
+/*
+* Counts the jobs waiting to run
+* NOTE: Hold the jobs mutex
+*
+* @return int, The amount of jobs across every priority
+*/
+static int getWaiting() {
+	int waiting = 0;
+	for (const std::deque<std::function<void()>>& queue : jobs)
+		waiting += (int)queue.size();
+	return waiting;
+}
+
+/*
+* The worker threads loop, runs jobs until it's told to stop
+*/
+static void run() {
+	while (true) {
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> lock(jobsMutex);
+			jobsChanged.wait(lock, [] { return stopping || getWaiting() > 0; });
+
+			if (stopping) return;
+
+			//Takes from the highest priority that has a job
+			for (std::deque<std::function<void()>>& queue : jobs) {
+				if (queue.empty()) continue;
+
+				job = std::move(queue.front());
+				queue.pop_front();
+				break;
+			}
+		}
+		//Runs the job outside of the lock so more can be submitted
+		job();
+	}
+}
+
+
+/*
+* Starts the worker thread
+*
+* @return bool, true if the worker thread is running
+*/
+bool Worker::init() {
+	SDL_assert(!loaded());
+	if (loaded()) return true;
+
+	stopping = false;
+	workerThread = new std::thread(run);
+
+	return loaded();
+}
+
+/*
+* Stops the worker thread
+* Waits for the running job to finish, jobs that haven't started are dropped
+*/
+void Worker::close() {
+	SDL_assert(loaded());
+	if (!loaded()) return;
+
+	{
+		std::lock_guard<std::mutex> lock(jobsMutex);
+		stopping = true;
+		for (std::deque<std::function<void()>>& queue : jobs)
+			queue.clear();
+	}
+	jobsChanged.notify_all();
+
+	workerThread->join();
+	delete workerThread;
+	workerThread = nullptr;
+}
+
+/*
+* Checks if the worker thread is running
+*
+* @return bool, true if the worker is running
+*/
+bool Worker::loaded() { return workerThread != nullptr; }
+
+/*
+* Submits a job to be run on the worker thread
+*
+* @param job, The job to run
+* @param priority, How soon it runs compared to the other waiting jobs
+* @return bool, true if the job was submitted
+*/
+bool Worker::submit(std::function<void()> job, JobPriority priority) {
+	SDL_assert(loaded());
+	if (!loaded() || !job) return false;
+
+	{
+		std::lock_guard<std::mutex> lock(jobsMutex);
+		jobs[(int)priority].push_back(std::move(job));
+	}
+	jobsChanged.notify_one();
+
+	return true;
+}
+
+/*
+* Gets the amount of jobs waiting to run
+*
+* @return int, The amount of jobs that haven't started
+*/
+int Worker::getPending() {
+	std::lock_guard<std::mutex> lock(jobsMutex);
+	return getWaiting();
+}
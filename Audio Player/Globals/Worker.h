@@ -0,0 +1,35 @@
+#pragma once
+
+#include <functional>
+
+/*
+* How soon a job runs, higher priority jobs skip ahead of lower ones that haven't started
+*/
+enum class JobPriority {
+	//Work the user is about to wait on (snippets)
+	High,
+	Normal,
+	//Work that may never be needed (speculation)
+	Low,
+};
+
+/*
+* Runs jobs on a background thread so slow work (disk, decoding) stays off the main thread
+* Jobs are run one at a time, by priority then in the order they were submitted
+*/
+namespace Worker {
+	//Starts the worker thread
+	bool init();
+
+	//Stops the worker thread, jobs that haven't started are dropped
+	void close();
+
+	//Checks if the worker thread is running
+	bool loaded();
+
+	//Submits a job to be run on the worker thread
+	bool submit(std::function<void()> job, JobPriority priority = JobPriority::Normal);
+
+	//Gets the amount of jobs waiting to run
+	int getPending();
+};
@@ -0,0 +1,147 @@
+#include "DebugOverlay.h"
+
+#include "Globals/Display.h"
+#include "Globals/DrawQueue.h"
+#include "Globals/TextRenderer.h"
+#include "Globals/TexturePool.h"
+#include "Globals/Animation.h"
+#include "Globals/TextureCache.h"
+#include "Interactables/WidgetPool.h"
+#include "Music/MusicPlayer/AudioStats.h"
+#include "Music/MusicPlayer/Prefetcher.h"
+#include "Music/MusicPlayer/AudioEvents.h"
+#include "Music/MusicPlayer/MusicPlayer.h"
+#include "Music/MusicPlayer/TimeStretcher.h"
+#include "Music/MusicPlayer/AudioPipeline.h"
+#include "Music/MusicPlayer/SnippetCache.h"
+#include "Music/MusicDecoder/SnippetDecoder.h"
+#include "Music/MusicPlayer/Speculator.h"
+#include "Music/MusicPlayer/SilenceAnalyzer.h"
+
+static bool overlayVisible = false;
+
+
+/*
+* Toggles the overlay on / off
+*/
+void DebugOverlay::toggle() { setVisible(!getVisible()); }
+
+/*
+* Shows / Hides the overlay
+*
+* @param visible, Should the overlay be shown
+*/
+void DebugOverlay::setVisible(bool visible) { overlayVisible = visible; }
+
+/*
+* Checks if the overlay is shown
+*
+* @return bool, true if the overlay is shown
+*/
+bool DebugOverlay::getVisible() { return overlayVisible; }
+
+
+/*
+* Default Constructor
+*/
+DebugOverlayInteractable::DebugOverlayInteractable() : TextPanelInteractable() {}
+
+/*
+* Regenerates the lines of text from the current stats
+*/
+void DebugOverlayInteractable::refreshLines() {
+	//Audio thread health
+	lines.push_back("Audio (F3 to hide)");
+	for (const std::string& line : AudioStats::getSummary())
+		lines.push_back(line);
+
+	//Track prefetching
+	char text[128];
+	SDL_snprintf(text, sizeof(text), "prefetch hits %u late %u misses %u",
+		Prefetcher::getHits(), Prefetcher::getLate(), Prefetcher::getMisses());
+	lines.push_back(text);
+
+	//Audio thread events
+	SDL_snprintf(text, sizeof(text), "position %d ms events dropped %u",
+		(int)MusicPlayer::getPositionMs(), AudioEvents::getDropped());
+	lines.push_back(text);
+
+	//Auto advance
+	SDL_snprintf(text, sizeof(text), "mode %s (M) queued %d advances prepared %u cold %u",
+		MusicPlayer::getPlayModeName(MusicPlayer::getPlayMode()), MusicPlayer::getQueueLength(),
+		MusicPlayer::getPreparedAdvances(), MusicPlayer::getColdAdvances());
+	lines.push_back(text);
+
+	//Time-stretching
+	PlaybackRate rate = MusicPlayer::getSongRate(MusicPlayer::getPlayingSongID());
+	SDL_snprintf(text, sizeof(text), "speed %.2fx pitch %.2fx ([ ] - =) simd %s",
+		rate.speed, rate.pitch, (TimeStretcher::getUseSIMD() ? "on" : "off"));
+	lines.push_back(text);
+
+	//Decoding ahead of the audio thread
+	SDL_snprintf(text, sizeof(text), "pipeline buffered %d frames starved %u",
+		AudioPipeline::getBufferedFrames(), AudioPipeline::getStarvations());
+	lines.push_back(text);
+
+	//Instant starts
+	SDL_snprintf(text, sizeof(text), "snippets %d (%.1f MB) hits %u misses %u splices %u late %u",
+		SnippetCache::getCachedCount(), SnippetCache::getCachedBytes() / (1024.0 * 1024.0), SnippetCache::getHits(),
+		SnippetCache::getMisses(), SnippetDecoder::getSplices(), SnippetDecoder::getLateSplices());
+	lines.push_back(text);
+
+	//Hover speculation
+	SDL_snprintf(text, sizeof(text), "hover %u ms speculated %u hits %u late %u misses %u cancelled %u",
+		Speculator::getDwell(), Speculator::getSpeculated(), Speculator::getHits(),
+		Speculator::getLate(), Speculator::getMisses(), Speculator::getCancelled());
+	lines.push_back(text);
+
+	//Idle frames
+	SDL_snprintf(text, sizeof(text), "frames rendered %u skipped %u",
+		Display::getRenderedFrames(), Display::getSkippedFrames());
+	lines.push_back(text);
+
+	//Silence trimming
+	SDL_snprintf(text, sizeof(text), "silence skipped %.1f s threshold %.0f dBFS",
+		MusicPlayer::getSilenceSkippedMs() / 1000.0, SilenceAnalyzer::getThreshold());
+	lines.push_back(text);
+
+	//Glyph atlas
+	SDL_snprintf(text, sizeof(text), "text atlas %d glyphs %d pages %.0f%% full",
+		TextRenderer::getGlyphCount(), TextRenderer::getPageCount(), TextRenderer::getOccupancy() * 100);
+	lines.push_back(text);
+
+	//Container render targets
+	SDL_snprintf(text, sizeof(text), "render targets created %u (%u/s) reused %u pooled %d",
+		TexturePool::getCreated(), TexturePool::getCreationsPerSecond(), TexturePool::getReused(),
+		TexturePool::getPooledCount());
+	lines.push_back(text);
+
+	//Animation clock
+	SDL_snprintf(text, sizeof(text), "animations %d steps %u dropped %u",
+		Animation::getActiveCount(), Animation::getSteps(), Animation::getDroppedSteps());
+	lines.push_back(text);
+
+	//Draw batching
+	SDL_snprintf(text, sizeof(text), "draw calls %d batches %d draws %d",
+		DrawQueue::getDrawCalls(), DrawQueue::getBatches(), DrawQueue::getCommands());
+	lines.push_back(text);
+
+	//Shared images
+	SDL_snprintf(text, sizeof(text), "images %d (%.1f / %.0f MB) hits %u loads %u preloaded %u evicted %u",
+		TextureCache::getCount(), TextureCache::getBytes() / (1024.0 * 1024.0), TextureCache::getBudget() / (1024.0 * 1024.0),
+		TextureCache::getHits(), TextureCache::getLoads(), TextureCache::getPreloads(), TextureCache::getEvictions());
+	lines.push_back(text);
+
+	//Widget memory
+	SDL_snprintf(text, sizeof(text), "widgets %d allocated %u heap allocations %u (%.1f KB chunks)",
+		WidgetPool::getLiveCount(), WidgetPool::getAllocations(), WidgetPool::getHeapAllocations(),
+		WidgetPool::getChunkBytes() / 1024.0);
+	lines.push_back(text);
+}
+
+/*
+* Checks if the overlay is shown
+*
+* @return bool, true if the overlay is shown
+*/
+bool DebugOverlayInteractable::getVisible() const { return DebugOverlay::getVisible(); }
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "TextPanel.h"
+
+/*
+* Controls whether the debug overlay is shown
+*/
+namespace DebugOverlay {
+	//Toggles the overlay on / off
+	void toggle();
+
+	//Shows / Hides the overlay
+	void setVisible(bool);
+
+	//Checks if the overlay is shown
+	bool getVisible();
+};
+
+/*
+* Displays debug stats on top of the UI
+*/
+class DebugOverlayInteractable : public TextPanelInteractable {
+private:
+	//Regenerates the lines of text
+	void refreshLines() override;
+
+	/// Getters
+
+	//Checks if the overlay is shown
+	bool getVisible() const override;
+public:
+	//Default Constructor
+	DebugOverlayInteractable();
+};
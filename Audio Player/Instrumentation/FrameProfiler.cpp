@@ -0,0 +1,320 @@
+#include "FrameProfiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <typeinfo>
+#include <unordered_map>
+
+//The amount of frames kept in the history
+#define FRAME_HISTORY 600
+//The amount of Interactables listed in the overlay
+#define SLOWEST_SHOWN 8
+
+//The space between the overlay and the edge of the window
+#define MARGIN 5
+
+/*
+* The time spent on an Interactable since profiling started
+*/
+struct InteractableTiming {
+	std::string type;
+	Uint64 updateCounts;
+	Uint64 renderCounts;
+};
+
+/*
+* The time spent in each phase of a frame
+*/
+struct FrameTiming {
+	Uint64 phases[(int)ProfilePhase::Count];
+};
+
+static bool profilerEnabled = false;
+
+//The frame being timed, and the ones before it
+static FrameTiming currentFrame;
+static std::vector<FrameTiming> history;
+static size_t historyNext = 0;
+static Uint32 frameCount = 0;
+
+static std::unordered_map<int, InteractableTiming> interactableTimings;
+
+
+/*
+* Converts performance counts to milliseconds
+*
+* @param counts, The performance counts
+* @return double, The milliseconds
+*/
+static double toMs(Uint64 counts) {
+	return counts * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+
+/*
+* Toggles profiling on / off
+*/
+void FrameProfiler::toggle() { setEnabled(!getEnabled()); }
+
+/*
+* Starts / Stops profiling
+* The history and Interactable times are cleared when it starts
+*
+* @param enabled, Should frames be profiled
+*/
+void FrameProfiler::setEnabled(bool enabled) {
+	if (enabled && !profilerEnabled) {
+		history.clear();
+		historyNext = 0;
+		frameCount = 0;
+		interactableTimings.clear();
+	}
+	profilerEnabled = enabled;
+}
+
+/*
+* Checks if frames are being profiled
+*
+* @return bool, true while profiling
+*/
+bool FrameProfiler::getEnabled() { return profilerEnabled; }
+
+/*
+* Starts a frame
+*/
+void FrameProfiler::beginFrame() {
+	currentFrame = {};
+}
+
+/*
+* Finishes a frame, moving its times into the history
+*/
+void FrameProfiler::endFrame() {
+	if (!profilerEnabled) return;
+
+	if (history.size() < FRAME_HISTORY)
+		history.push_back(currentFrame);
+	else
+		history[historyNext] = currentFrame;
+	historyNext = (historyNext + 1) % FRAME_HISTORY;
+	frameCount++;
+}
+
+/*
+* Adds time to a phase of the current frame
+*
+* @param phase, The phase
+* @param counts, The time in performance counts
+*/
+void FrameProfiler::addPhase(ProfilePhase phase, Uint64 counts) {
+	currentFrame.phases[(int)phase] += counts;
+}
+
+/*
+* Adds time to an Interactable
+*
+* @param interactable, The Interactable
+* @param rendering, true if it was rendering, false if it was updating
+* @param counts, The time in performance counts
+*/
+void FrameProfiler::addInteractable(const Interactable* interactable, bool rendering, Uint64 counts) {
+	InteractableTiming& timing = interactableTimings[interactable->getID()];
+	if (timing.type.empty())
+		timing.type = typeid(*interactable).name();
+
+	if (rendering)
+		timing.renderCounts += counts;
+	else
+		timing.updateCounts += counts;
+}
+
+/*
+* Writes the profile as two CSV files, <prefix>_frames.csv with the phases of each frame in the history (oldest first),
+* and <prefix>_interactables.csv with the mean time of each Interactable per frame
+*
+* @param pathPrefix, The start of the files' paths
+* @return bool, true if both were written
+*/
+bool FrameProfiler::exportCSV(const std::string& pathPrefix) {
+	std::ofstream frames(pathPrefix + "_frames.csv");
+	std::ofstream interactables(pathPrefix + "_interactables.csv");
+	if (!frames.is_open() || !interactables.is_open()) {
+		std::cout << "FrameProfiler: Could not write " << pathPrefix << " CSVs" << std::endl;
+		return false;
+	}
+
+	frames << "frame";
+	for (int phase = 0; phase < (int)ProfilePhase::Count; phase++)
+		frames << "," << getPhaseName((ProfilePhase)phase) << "_ms";
+	frames << ",total_ms\n";
+
+	//The history is a ring, the oldest frame is the next to be replaced once it's full
+	size_t oldest = (history.size() < FRAME_HISTORY ? 0 : historyNext);
+	for (size_t i = 0; i < history.size(); i++) {
+		const FrameTiming& frame = history[(oldest + i) % history.size()];
+		Uint64 total = 0;
+		frames << i;
+		for (int phase = 0; phase < (int)ProfilePhase::Count; phase++) {
+			frames << "," << toMs(frame.phases[phase]);
+			total += frame.phases[phase];
+		}
+		frames << "," << toMs(total) << "\n";
+	}
+
+	interactables << "id,type,update_ms,render_ms\n";
+	for (const ProfiledInteractable& profiled : getSlowest((int)interactableTimings.size()))
+		interactables << profiled.ID << "," << profiled.type << "," << profiled.updateMs << "," << profiled.renderMs << "\n";
+
+	std::cout << "FrameProfiler: Wrote " << pathPrefix << " CSVs" << std::endl;
+	return frames.good() && interactables.good();
+}
+
+
+/*
+* Gets the mean time of a phase over the history
+*
+* @param phase, The phase
+* @return double, The mean time (ms)
+*/
+double FrameProfiler::getPhaseMs(ProfilePhase phase) {
+	if (history.empty()) return 0;
+
+	Uint64 total = 0;
+	for (const FrameTiming& frame : history)
+		total += frame.phases[(int)phase];
+	return toMs(total) / history.size();
+}
+
+/*
+* Gets the amount of frames profiled since profiling started
+*
+* @return Uint32, The amount of frames
+*/
+Uint32 FrameProfiler::getFrameCount() { return frameCount; }
+
+/*
+* Gets the Interactables that take the longest to update and render
+*
+* @param count, The most to get
+* @return std::vector<ProfiledInteractable>, The Interactables with their mean times per frame, slowest first
+*/
+std::vector<ProfiledInteractable> FrameProfiler::getSlowest(int count) {
+	std::vector<ProfiledInteractable> slowest;
+	double frames = SDL_max(frameCount, 1u);
+	for (const auto& timing : interactableTimings) {
+		slowest.push_back({ timing.first, timing.second.type,
+			toMs(timing.second.updateCounts) / frames, toMs(timing.second.renderCounts) / frames });
+	}
+
+	std::sort(slowest.begin(), slowest.end(), [](const ProfiledInteractable& a, const ProfiledInteractable& b) {
+		return a.updateMs + a.renderMs > b.updateMs + b.renderMs;
+	});
+	if ((int)slowest.size() > count)
+		slowest.resize(SDL_max(count, 0));
+	return slowest;
+}
+
+/*
+* Gets the name of a phase
+*
+* @param phase, The phase
+* @return const char*, The name
+*/
+const char* FrameProfiler::getPhaseName(ProfilePhase phase) {
+	switch (phase) {
+	case ProfilePhase::Input: return "input";
+	case ProfilePhase::Update: return "update";
+	case ProfilePhase::Render: return "render";
+	case ProfilePhase::Present: return "present";
+	default: return "unknown";
+	}
+}
+
+
+/*
+* Starts timing a phase of the frame
+*
+* @param phase, The phase
+*/
+ScopeTimer::ScopeTimer(ProfilePhase phase) {
+	this->phase = phase;
+	interactable = nullptr;
+	rendering = false;
+	start = (FrameProfiler::getEnabled() ? SDL_GetPerformanceCounter() : 0);
+}
+
+/*
+* Starts timing an Interactable
+*
+* @param interactable, The Interactable
+* @param rendering, true if it's rendering, false if it's updating
+*/
+ScopeTimer::ScopeTimer(const Interactable* interactable, bool rendering) {
+	phase = ProfilePhase::Count;
+	this->interactable = interactable;
+	this->rendering = rendering;
+	start = (FrameProfiler::getEnabled() ? SDL_GetPerformanceCounter() : 0);
+}
+
+/*
+* Adds the time taken since the timer started
+*/
+ScopeTimer::~ScopeTimer() {
+	if (start == 0) return;
+
+	Uint64 counts = SDL_GetPerformanceCounter() - start;
+	if (interactable != nullptr)
+		FrameProfiler::addInteractable(interactable, rendering, counts);
+	else
+		FrameProfiler::addPhase(phase, counts);
+}
+
+
+/*
+* Default Constructor
+*/
+ProfilerOverlayInteractable::ProfilerOverlayInteractable() : TextPanelInteractable() {}
+
+/*
+* Regenerates the lines of text from the profiled times
+*/
+void ProfilerOverlayInteractable::refreshLines() {
+	char text[128];
+	SDL_snprintf(text, sizeof(text), "Profiler %u frames (F4 to hide, F5 to export)", FrameProfiler::getFrameCount());
+	lines.push_back(text);
+
+	//The phases of the frame
+	double total = 0;
+	for (int phase = 0; phase < (int)ProfilePhase::Count; phase++) {
+		double ms = FrameProfiler::getPhaseMs((ProfilePhase)phase);
+		SDL_snprintf(text, sizeof(text), "%s %.3f ms", FrameProfiler::getPhaseName((ProfilePhase)phase), ms);
+		lines.push_back(text);
+		total += ms;
+	}
+	SDL_snprintf(text, sizeof(text), "frame %.3f ms", total);
+	lines.push_back(text);
+
+	//The slowest Interactables
+	for (const ProfiledInteractable& profiled : FrameProfiler::getSlowest(SLOWEST_SHOWN)) {
+		SDL_snprintf(text, sizeof(text), "#%d %s update %.3f render %.3f ms",
+			profiled.ID, profiled.type.c_str(), profiled.updateMs, profiled.renderMs);
+		lines.push_back(text);
+	}
+}
+
+/*
+* Places the overlay in the top right corner
+*
+* @param width, The width of the overlay
+*/
+void ProfilerOverlayInteractable::place(int width) {
+	setX(CordType::PixelFromRightEdge, (float)(width + MARGIN));
+}
+
+/*
+* Checks if the overlay is shown
+*
+* @return bool, true while profiling
+*/
+bool ProfilerOverlayInteractable::getVisible() const { return FrameProfiler::getEnabled(); }
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "SDL.h"
+
+#include "TextPanel.h"
+
+/*
+* The parts of a frame that are timed
+*/
+enum class ProfilePhase {
+	Input,
+	Update,
+	Render,
+	Present,
+	Count
+};
+
+/*
+* The time an Interactable takes, per profiled frame
+*/
+struct ProfiledInteractable {
+	int ID;
+	//The type of Interactable
+	std::string type;
+	//The mean time spent updating / rendering it each frame (ms)
+	double updateMs;
+	double renderMs;
+};
+
+/*
+* Times each phase of the frame, and each Interactable's update / render
+* Interactable times include the ones they contain
+* NOTE: Only times while enabled, so it costs a branch per scope otherwise
+*/
+namespace FrameProfiler {
+	//Toggles profiling, and the overlay showing it, on / off
+	void toggle();
+
+	//Starts / Stops profiling, the times are cleared when it starts
+	void setEnabled(bool);
+
+	//Checks if frames are being profiled
+	bool getEnabled();
+
+	//Starts a frame
+	void beginFrame();
+
+	//Finishes a frame, moving its times into the history
+	void endFrame();
+
+	//Adds time to a phase of the current frame
+	void addPhase(ProfilePhase, Uint64 counts);
+
+	//Adds time to an Interactable
+	void addInteractable(const Interactable*, bool rendering, Uint64 counts);
+
+	//Writes the frame history and Interactable times as CSV files
+	bool exportCSV(const std::string& pathPrefix);
+
+	/// Getters
+
+	//Gets the mean time of a phase over the history (ms)
+	double getPhaseMs(ProfilePhase);
+
+	//Gets the amount of frames profiled
+	Uint32 getFrameCount();
+
+	//Gets the Interactables that take the longest, slowest first
+	std::vector<ProfiledInteractable> getSlowest(int count);
+
+	//Gets the name of a phase
+	const char* getPhaseName(ProfilePhase);
+};
+
+/*
+* Times the scope it's in, adding it to a phase or an Interactable when it ends
+*/
+class ScopeTimer {
+private:
+	//What's being timed, a phase if there's no Interactable
+	ProfilePhase phase;
+	const Interactable* interactable;
+	bool rendering;
+
+	//When the scope started, 0 while not profiling
+	Uint64 start;
+public:
+	//Times a phase of the frame
+	ScopeTimer(ProfilePhase);
+
+	//Times an Interactable's update / render
+	ScopeTimer(const Interactable*, bool rendering);
+
+	//Adds the time taken
+	~ScopeTimer();
+};
+
+/*
+* Displays the profiled times in the top right corner
+*/
+class ProfilerOverlayInteractable : public TextPanelInteractable {
+private:
+	//Regenerates the lines of text
+	void refreshLines() override;
+
+	//Places the overlay in the top right corner
+	void place(int width) override;
+
+	/// Getters
+
+	//Checks if the overlay is shown
+	bool getVisible() const override;
+public:
+	//Default Constructor
+	ProfilerOverlayInteractable();
+};
@@ -0,0 +1,132 @@
+#include "Histogram.h"
+
+#include "SDL_bits.h"
+#include "SDL_assert.h"
+
+
+/*
+* Gets the bucket a value belongs in
+*
+* @param value, The value to bucket
+* @return int, The index of the bucket
+*/
+int Histogram::getBucketIndex(Uint32 value) {
+	//0 gets its own bucket, everything else is bucketed by its highest bit
+	if (value == 0) return 0;
+	return SDL_MostSignificantBitIndex32(value) + 1;
+}
+
+/*
+* Default Constructor
+*/
+Histogram::Histogram() {
+	reset();
+}
+
+/*
+* Records a value into the histogram
+* NOTE: Lock-free, may be called from the audio thread
+*
+* @param value, The value to record
+*/
+void Histogram::record(Uint32 value) {
+	buckets[getBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+	total.fetch_add(value, std::memory_order_relaxed);
+
+	//Raises the maximum if this value is larger
+	Uint32 currentMax = maximum.load(std::memory_order_relaxed);
+	while (value > currentMax && !maximum.compare_exchange_weak(currentMax, value, std::memory_order_relaxed)) {}
+
+	//Count is released last so readers never see more values than buckets
+	count.fetch_add(1, std::memory_order_release);
+}
+
+/*
+* Clears all recorded values
+*/
+void Histogram::reset() {
+	for (int i = 0; i < BUCKET_COUNT; i++)
+		buckets[i].store(0, std::memory_order_relaxed);
+
+	total.store(0, std::memory_order_relaxed);
+	maximum.store(0, std::memory_order_relaxed);
+	count.store(0, std::memory_order_release);
+}
+
+/*
+* Gets the amount of values recorded
+*
+* @return Uint32, The count of values
+*/
+Uint32 Histogram::getCount() const { return count.load(std::memory_order_acquire); }
+
+/*
+* Gets the largest value recorded
+*
+* @return Uint32, The maximum, 0 if nothing was recorded
+*/
+Uint32 Histogram::getMax() const { return maximum.load(std::memory_order_relaxed); }
+
+/*
+* Gets the mean of the values recorded
+*
+* @return double, The mean, 0 if nothing was recorded
+*/
+double Histogram::getMean() const {
+	Uint32 recorded = getCount();
+	if (recorded == 0) return 0;
+	return (double)total.load(std::memory_order_relaxed) / recorded;
+}
+
+/*
+* Gets the approximate value at a percentile
+* The result is the upper limit of the bucket the percentile falls within
+*
+* @param percentile, The percentile to find (0 - 1)
+* @return Uint32, The value at the percentile, 0 if nothing was recorded
+*/
+Uint32 Histogram::getPercentile(float percentile) const {
+	SDL_assert(0 <= percentile && percentile <= 1);
+
+	Uint32 recorded = getCount();
+	if (recorded == 0) return 0;
+
+	//The amount of values that must be below the result
+	Uint64 target = (Uint64)(percentile * recorded);
+	Uint64 seen = 0;
+
+	for (int i = 0; i < BUCKET_COUNT; i++) {
+		seen += getBucket(i);
+		if (seen > target) {
+			//Never report more than what was actually recorded
+			Uint32 limit = getBucketLimit(i);
+			return (limit < getMax() ? limit : getMax());
+		}
+	}
+	return getMax();
+}
+
+/*
+* Gets the amount of values within a bucket
+*
+* @param index, The index of the bucket
+* @return Uint32, The amount of values, 0 if the index is invalid
+*/
+Uint32 Histogram::getBucket(int index) const {
+	SDL_assert(0 <= index && index < BUCKET_COUNT);
+	if (index < 0 || index >= BUCKET_COUNT) return 0;
+
+	return buckets[index].load(std::memory_order_relaxed);
+}
+
+/*
+* Gets the largest value a bucket can hold
+*
+* @param index, The index of the bucket
+* @return Uint32, The largest value within the bucket
+*/
+Uint32 Histogram::getBucketLimit(int index) {
+	if (index <= 0) return 0;
+	if (index >= 32) return 0xFFFFFFFF;
+	return (1u << index) - 1;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+
+#include "SDL.h"
+
+/*
+* A fixed-size histogram that one thread can record into while another reads it
+* Values are bucketed by powers of two, bucket N holds values in [2^(N-1), 2^N)
+* Recording never locks or allocates so it is safe to use on the audio thread
+*/
+class Histogram {
+public:
+	//The amount of buckets, enough to hold any Uint32
+	static const int BUCKET_COUNT = 33;
+private:
+	//The count of values within each bucket
+	std::atomic<Uint32> buckets[BUCKET_COUNT];
+
+	//The amount of values recorded
+	std::atomic<Uint32> count;
+	//The sum of all the values recorded
+	std::atomic<Uint64> total;
+	//The largest value recorded
+	std::atomic<Uint32> maximum;
+
+	//Gets the bucket a value belongs in
+	static int getBucketIndex(Uint32);
+public:
+	//Default Constructor
+	Histogram();
+
+	//Records a value into the histogram
+	void record(Uint32);
+
+	//Clears all recorded values
+	void reset();
+
+	/// Getters
+
+	//Gets the amount of values recorded
+	Uint32 getCount() const;
+
+	//Gets the largest value recorded
+	Uint32 getMax() const;
+
+	//Gets the mean of the values recorded
+	double getMean() const;
+
+	//Gets the (approximate) value at a percentile (0 - 1)
+	Uint32 getPercentile(float) const;
+
+	//Gets the amount of values within a bucket
+	Uint32 getBucket(int) const;
+
+	//Gets the largest value a bucket can hold
+	static Uint32 getBucketLimit(int);
+};
@@ -0,0 +1,118 @@
+#include "TextPanel.h"
+
+#include "SDL_ttf.h"
+
+#include "Globals/Display.h"
+#include "Globals/DrawQueue.h"
+#include "Globals/Font.h"
+#include "Globals/TextRenderer.h"
+
+//The height each line is drawn at
+#define LINE_HEIGHT 14
+//The space around the text
+#define PADDING 4
+//How often the lines are refreshed (ms)
+#define REFRESH_INTERVAL 500
+
+
+/*
+* Initializes the Text Panel
+*/
+void TextPanelInteractable::init() {
+	//Translucent black background
+	setPrimaryColor(0, 0, 0, 180);
+	wasVisible = false;
+	lastRefresh = 0;
+	//Refreshes its lines
+	setUpdates(true);
+}
+
+/*
+* Default Constructor
+*/
+TextPanelInteractable::TextPanelInteractable() : Interactable() {
+	init();
+}
+
+/*
+* Regenerates the lines, then sizes the panel to fit the widest one scaled down to the line height
+* So the area redrawn covers them
+*/
+void TextPanelInteractable::refresh() {
+	lines.clear();
+	refreshLines();
+
+	int width = 0;
+	for (const std::string& line : lines) {
+		int w, h;
+		TextRenderer::measure(FontName::UIFont, line, w, h);
+		width = SDL_max(width, w * LINE_HEIGHT / (h > 0 ? h : 1));
+	}
+
+	place(width + PADDING * 2);
+	setW(CordType::Pixel, (float)(width + PADDING * 2));
+	setH(CordType::Pixel, (float)((int)lines.size() * LINE_HEIGHT + PADDING * 2));
+}
+
+/*
+* Places the panel once its width is known, it stays where it was put by default
+*/
+void TextPanelInteractable::place(int) {}
+
+/*
+* Updates the Text Panel
+*
+* @return int, 0 on success
+*/
+int TextPanelInteractable::update() {
+	Interactable::update();
+
+	bool visible = getVisible();
+
+	//Re-renders when shown / hidden
+	if (visible != wasVisible) {
+		wasVisible = visible;
+		lastRefresh = 0;
+		invalidate();
+	}
+
+	//Refreshes the lines periodically while shown
+	Uint32 now = SDL_GetTicks();
+	if (visible && (lastRefresh == 0 || now - lastRefresh >= REFRESH_INTERVAL)) {
+		refresh();
+		lastRefresh = now;
+		invalidate();
+	}
+
+	//Wakes the main loop for the next refresh
+	if (visible)
+		Display::requestFrame(REFRESH_INTERVAL - SDL_min(now - lastRefresh, (Uint32)REFRESH_INTERVAL));
+
+	return 0;
+}
+
+/*
+* Renders the Text Panel
+*/
+void TextPanelInteractable::render() {
+	//Nothing is drawn while hidden
+	if (!getVisible()) {
+		revalidate();
+		return;
+	}
+
+	//Sized to fit the widest line when the lines were refreshed
+	SDL_Rect renderArea = getRect();
+	DrawQueue::fillRect(renderArea, getPrimaryColor());
+
+	//Draws each line below the previous, scaled down to the line height
+	SDL_Color white = { 255, 255, 255, 255 };
+	float scale = (float)LINE_HEIGHT / SDL_max(TTF_FontHeight(Font::getFontByNameMut(FontName::UIFont)), 1);
+	for (size_t i = 0; i < lines.size(); i++) {
+		TextRenderer::draw(FontName::UIFont, lines[i], renderArea.x + PADDING,
+			renderArea.y + PADDING + (int)i * LINE_HEIGHT, white, scale);
+	}
+
+	//Revalidates the Interactable as it has been rendered
+	revalidate();
+}
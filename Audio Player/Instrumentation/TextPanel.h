@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Interactables/Interactables.h"
+
+/*
+* A panel of stats drawn as lines of text on top of the UI, refreshed periodically while it's shown
+* Each overlay only generates its lines, the panel sizes, refreshes and draws them
+*/
+class TextPanelInteractable : public Interactable {
+private:
+	//Whether the panel was visible last update
+	bool wasVisible;
+
+	//When the lines were last refreshed
+	Uint32 lastRefresh;
+
+	//Initializes the Text Panel
+	void init();
+
+	//Regenerates the lines and sizes the panel to fit them
+	void refresh();
+protected:
+	//The lines of text displayed
+	std::vector<std::string> lines;
+
+	//Regenerates the lines of text
+	virtual void refreshLines() = 0;
+
+	//Places the panel once its width is known, it stays where it was put by default
+	virtual void place(int width);
+
+	/// Getters
+
+	//Checks if the panel is shown
+	virtual bool getVisible() const = 0;
+public:
+	//Default Constructor
+	TextPanelInteractable();
+
+	//Updates the Text Panel
+	int update();
+
+	/// Rendering
+
+	//Renders the Text Panel
+	void render();
+};
@@ -0,0 +1,234 @@
+#include "Components.h"
+
+#include "SDL_assert.h"
+
+#include "Globals/Display.h"
+#include "Globals/Math.h"
+#include "Layout.h"
+
+//The components, indexed by slot
+static std::vector<LayoutComponent> layouts;
+static std::vector<StyleComponent> styles;
+static std::vector<StateComponent> states;
+static std::vector<TextComponent> texts;
+
+
+/*
+* Resolves a rect from its layout
+*
+* @param layout, The layout
+* @return SDL_Rect, The rectangle where the interactable is rendered
+*/
+static SDL_Rect resolveRect(const LayoutComponent& layout) {
+	SDL_Rect rect;
+
+	//Unbound interactables are laid out in the display
+	int boundWidth = (layout.isBound ? layout.boundRect.w : Layout::getDisplayWidth());
+	int boundHeight = (layout.isBound ? layout.boundRect.h : Layout::getDisplayHeight());
+
+	//Gets the pixel position of the rectangle
+	rect.x = layout.x.getPixelPosEx(true, boundWidth, boundHeight) - layout.boundRect.x;
+	rect.y = layout.y.getPixelPosEx(false, boundWidth, boundHeight) - layout.boundRect.y;
+	rect.w = layout.w.getPixelPosEx(true, boundWidth, boundHeight);
+	rect.h = layout.h.getPixelPosEx(false, boundWidth, boundHeight);
+
+	//Changes the position based off the style
+	if (layout.style == RenderStyle::Centered) {
+		rect.x -= rect.w / 2;
+		rect.y -= rect.h / 2;
+	}
+
+	return rect;
+}
+
+
+/*
+* Reserves a slot for an Interactable
+* The components start out empty, it's up to the Interactable to set them
+*
+* @return int, The slot
+*/
+int Components::allocate() {
+	int slot = Layout::allocate();
+
+	//The slots only ever grow, freed ones are handed out again by the layout
+	if (slot >= (int)layouts.size()) {
+		layouts.resize((size_t)slot + 1);
+		styles.resize((size_t)slot + 1);
+		states.resize((size_t)slot + 1);
+		texts.resize((size_t)slot + 1);
+	}
+
+	layouts[slot] = LayoutComponent();
+	styles[slot] = StyleComponent();
+	states[slot] = { true, { 0, 0, 0, 0 }, { 0, 0, 0, 0 } };
+	texts[slot] = { "", { 255, 255, 255, 255 }, 0, 0 };
+	return slot;
+}
+
+/*
+* Frees a slot for reuse
+*
+* @param slot, The slot
+*/
+void Components::release(int slot) {
+	SDL_assert(slot >= 0 && slot < (int)layouts.size());
+	if (slot < 0 || slot >= (int)layouts.size()) return;
+
+	//Lets go of the text now rather than when the slot is reused
+	std::string().swap(texts[slot].text);
+	Layout::release(slot);
+}
+
+
+/*
+* Gets the layout of a slot
+*
+* @param slot, The slot
+* @return LayoutComponent&, The layout
+*/
+LayoutComponent& Components::getLayout(int slot) {
+	SDL_assert(slot >= 0 && slot < (int)layouts.size());
+	return layouts[slot];
+}
+
+/*
+* Gets the style of a slot
+*
+* @param slot, The slot
+* @return StyleComponent&, The style
+*/
+StyleComponent& Components::getStyle(int slot) {
+	SDL_assert(slot >= 0 && slot < (int)styles.size());
+	return styles[slot];
+}
+
+/*
+* Gets the state of a slot
+*
+* @param slot, The slot
+* @return StateComponent&, The state
+*/
+StateComponent& Components::getState(int slot) {
+	SDL_assert(slot >= 0 && slot < (int)states.size());
+	return states[slot];
+}
+
+/*
+* Gets the text of a slot
+*
+* @param slot, The slot
+* @return TextComponent&, The text
+*/
+TextComponent& Components::getText(int slot) {
+	SDL_assert(slot >= 0 && slot < (int)texts.size());
+	return texts[slot];
+}
+
+
+/*
+* Gets the rect of a slot
+* The rect is only resolved again once it moves, is rebound or the display is resized
+*
+* @param slot, The slot
+* @return SDL_Rect, The rectangle where the interactable is rendered
+*/
+SDL_Rect Components::getRect(int slot) {
+	SDL_Rect rect;
+	if (Layout::getRect(slot, rect))
+		return rect;
+
+	rect = resolveRect(layouts[slot]);
+	Layout::setRect(slot, rect);
+	return rect;
+}
+
+/*
+* Gets the rects of some slots
+*
+* @param slots, The slots
+* @param rects, Filled with the rect of each slot, in the same order
+*/
+void Components::getRects(const std::vector<int>& slots, std::vector<SDL_Rect>& rects) {
+	rects.resize(slots.size());
+	for (size_t i = 0; i < slots.size(); i++)
+		rects[i] = getRect(slots[i]);
+}
+
+/*
+* Marks a slot to be re-rendered if it moved since it last updated, or the display was resized
+*
+* @param slot, The slot
+*/
+void Components::updateMoved(int slot) {
+	SDL_Rect currentArea = getRect(slot);
+	StateComponent& state = states[slot];
+
+	if (!compare(currentArea, state.previousArea) || Display::getSizeChanged()) {
+		state.updated = true;
+		state.previousArea = currentArea;
+	}
+}
+
+/*
+* Marks the slots that moved since they last updated to be re-rendered
+*
+* @param slots, The slots
+*/
+void Components::updateMoved(const std::vector<int>& slots) {
+	for (int slot : slots)
+		updateMoved(slot);
+}
+
+/*
+* Gets the area covered by the slots that have to be re-rendered
+* Covers both where they are and where they were last rendered, so moved interactables leave nothing behind
+*
+* @param slots, The slots
+* @param area, Filled with the area
+* @return bool, true if anything has to be re-rendered
+*/
+bool Components::getDirtyArea(const std::vector<int>& slots, SDL_Rect& area) {
+	bool dirty = false;
+	area = { 0, 0, 0, 0 };
+
+	for (int slot : slots) {
+		const StateComponent& state = states[slot];
+		if (!state.updated) continue;
+
+		SDL_Rect currentArea = getRect(slot);
+		SDL_UnionRect(&area, &currentArea, &area);
+		SDL_UnionRect(&area, &state.renderedArea, &area);
+		dirty = true;
+	}
+
+	return dirty;
+}
+
+/*
+* Finds the slots that have to be rendered to redraw an area
+* Those that changed, and those overlapping the area where they are or were
+*
+* @param slots, The slots
+* @param area, The area being redrawn
+* @param indices, Filled with the indices into slots to render, in order
+*/
+void Components::getRenderList(const std::vector<int>& slots, const SDL_Rect& area, std::vector<int>& indices) {
+	indices.clear();
+
+	for (size_t i = 0; i < slots.size(); i++) {
+		const StateComponent& state = states[slots[i]];
+		SDL_Rect currentArea = getRect(slots[i]);
+
+		if (state.updated || SDL_HasIntersection(&currentArea, &area) || SDL_HasIntersection(&state.renderedArea, &area))
+			indices.push_back((int)i);
+	}
+}
+
+
+/*
+* Gets the amount of slots the arrays hold
+*
+* @return int, The amount of slots, used or not
+*/
+int Components::getCapacity() { return (int)layouts.size(); }
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "SDL.h"
+
+#include "Interactables.h"
+
+/*
+* Where an Interactable is, and the area it's laid out in
+*/
+struct LayoutComponent {
+	//The position of the UI element
+	Coordinate x, y;
+	//The size of the UI element
+	Coordinate w, h;
+
+	//The area it's bound to, the display when it isn't bound
+	bool isBound;
+	SDL_Rect boundRect;
+
+	//The render style of the interactable
+	RenderStyle style;
+};
+
+/*
+* The colors an Interactable is drawn with
+*/
+struct StyleComponent {
+	SDL_Color primaryColor;
+	SDL_Color secondaryColor;
+	SDL_Color tertiaryColor;
+};
+
+/*
+* What an Interactable needs to know to be redrawn
+*/
+struct StateComponent {
+	//If it has to be re-rendered
+	bool updated;
+	//The rect it had when it last updated, to tell when it moved
+	SDL_Rect previousArea;
+	//The area it was last rendered to, redrawn when it changes
+	SDL_Rect renderedArea;
+};
+
+/*
+* The text an Interactable shows, empty for the ones that show none
+*/
+struct TextComponent {
+	std::string text;
+	SDL_Color textColor;
+	//The size of the text when it's drawn
+	int textWidth;
+	int textHeight;
+};
+
+/*
+* Holds the data of every Interactable in contiguous arrays, one per component, indexed by the Interactable's layout slot
+* The Interactable classes are facades reading and writing their slot, and per frame work
+* (updating, finding what's dirty, hit testing) runs down the arrays instead of calling through each object
+* NOTE: Main thread only
+*/
+namespace Components {
+	//Reserves a slot for an Interactable, with its rect in the layout
+	int allocate();
+
+	//Frees a slot for reuse
+	void release(int slot);
+
+	/// Components
+
+	//Gets the layout of a slot
+	LayoutComponent& getLayout(int slot);
+
+	//Gets the style of a slot
+	StyleComponent& getStyle(int slot);
+
+	//Gets the state of a slot
+	StateComponent& getState(int slot);
+
+	//Gets the text of a slot
+	TextComponent& getText(int slot);
+
+	/// Systems
+
+	//Gets the rect of a slot, resolving it from its layout if it's stale
+	SDL_Rect getRect(int slot);
+
+	//Gets the rects of some slots
+	void getRects(const std::vector<int>& slots, std::vector<SDL_Rect>& rects);
+
+	//Marks the slot to be re-rendered if it moved since it last updated, or the display was resized
+	void updateMoved(int slot);
+
+	//Marks the slots that moved since they last updated to be re-rendered
+	void updateMoved(const std::vector<int>& slots);
+
+	//Gets the area covered by the slots that have to be re-rendered
+	bool getDirtyArea(const std::vector<int>& slots, SDL_Rect& area);
+
+	//Finds the slots that have to be rendered to redraw an area
+	void getRenderList(const std::vector<int>& slots, const SDL_Rect& area, std::vector<int>& indices);
+
+	/// Getters
+
+	//Gets the amount of slots the arrays hold, used or not
+	int getCapacity();
+};
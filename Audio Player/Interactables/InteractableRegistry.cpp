@@ -0,0 +1,114 @@
+#include "InteractableRegistry.h"
+
+#include "SDL_assert.h"
+
+#include "Interactables.h"
+
+
+/*
+* Constructor, an empty registry
+*/
+InteractableRegistry::InteractableRegistry() {}
+
+/*
+* Adds an Interactable
+*
+* @param interactable, The Interactable to add
+* @return InteractableHandle, The handle to it, NO_INTERACTABLE on error
+*/
+InteractableHandle InteractableRegistry::add(Interactable* interactable) {
+	SDL_assert(interactable != nullptr);
+	if (interactable == nullptr) return NO_INTERACTABLE;
+
+	//Reuses a free entry before growing
+	Uint32 index;
+	if (!freeEntries.empty()) {
+		index = freeEntries.back();
+		freeEntries.pop_back();
+	}
+	else {
+		index = (Uint32)entries.size();
+		entries.push_back({ nullptr, 0 });
+	}
+
+	entries[index].interactable = interactable;
+	InteractableHandle handle = { index, entries[index].generation };
+	handlesByID[interactable->getID()] = handle;
+	return handle;
+}
+
+/*
+* Removes an Interactable
+* NOTE: The Interactable isn't deleted
+*
+* @param handle, The handle to the Interactable
+* @return bool, true if it was removed, false if the handle refers to nothing
+*/
+bool InteractableRegistry::remove(InteractableHandle handle) {
+	if (!getValid(handle)) return false;
+
+	Entry& entry = entries[handle.index];
+	handlesByID.erase(entry.interactable->getID());
+
+	//Handles to the removed Interactable no longer match the entry
+	entry.interactable = nullptr;
+	entry.generation++;
+	freeEntries.push_back(handle.index);
+	return true;
+}
+
+/*
+* Removes every Interactable
+* The generations are kept, so handles from before find nothing
+*/
+void InteractableRegistry::clear() {
+	freeEntries.clear();
+	for (Uint32 index = 0; index < (Uint32)entries.size(); index++) {
+		if (entries[index].interactable != nullptr) {
+			entries[index].interactable = nullptr;
+			entries[index].generation++;
+		}
+		freeEntries.push_back(index);
+	}
+	handlesByID.clear();
+}
+
+
+/*
+* Gets the Interactable a handle refers to
+*
+* @param handle, The handle
+* @return Interactable*, The Interactable, nullptr if it was removed
+*/
+Interactable* InteractableRegistry::get(InteractableHandle handle) const {
+	return (getValid(handle) ? entries[handle.index].interactable : nullptr);
+}
+
+/*
+* Gets the handle of an Interactable by its ID
+*
+* @param ID, The ID of the Interactable
+* @return InteractableHandle, The handle, NO_INTERACTABLE if it isn't in the registry
+*/
+InteractableHandle InteractableRegistry::find(int ID) const {
+	auto found = handlesByID.find(ID);
+	return (found != handlesByID.end() ? found->second : NO_INTERACTABLE);
+}
+
+/*
+* Checks if a handle still refers to an Interactable
+*
+* @param handle, The handle
+* @return bool, true if the Interactable it was made for is still in the registry
+*/
+bool InteractableRegistry::getValid(InteractableHandle handle) const {
+	return handle.index < entries.size() && entries[handle.index].generation == handle.generation &&
+		entries[handle.index].interactable != nullptr;
+}
+
+/*
+* Gets the amount of Interactables in the registry
+*
+* @return int, The amount of Interactables
+*/
+int InteractableRegistry::getCount() const { return (int)handlesByID.size(); }
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "SDL.h"
+
+class Interactable;
+
+/*
+* Refers to an Interactable in a registry
+* The generation changes once the Interactable is removed, so old handles find nothing rather than whatever reused the entry
+*/
+struct InteractableHandle {
+	//The entry in the registry
+	Uint32 index;
+	//The generation of the entry it was made for
+	Uint32 generation;
+};
+
+//A handle that never refers to an Interactable
+static const InteractableHandle NO_INTERACTABLE = { 0xFFFFFFFF, 0 };
+
+/*
+* A slot map of Interactables, finding and removing them from a handle or ID without searching
+* Removed entries are reused, the generation telling apart the old and new Interactables
+*/
+class InteractableRegistry {
+private:
+	/*
+	* An entry, holding an Interactable or free
+	*/
+	struct Entry {
+		Interactable* interactable;
+		Uint32 generation;
+	};
+
+	std::vector<Entry> entries;
+	//The entries with nothing in them
+	std::vector<Uint32> freeEntries;
+
+	//The handle of each Interactable by its ID
+	std::unordered_map<int, InteractableHandle> handlesByID;
+public:
+	//Constructor, an empty registry
+	InteractableRegistry();
+
+	//Adds an Interactable, giving the handle to it
+	InteractableHandle add(Interactable*);
+
+	//Removes an Interactable, it isn't deleted
+	bool remove(InteractableHandle);
+
+	//Removes every Interactable
+	void clear();
+
+	/// Getters
+
+	//Gets the Interactable a handle refers to, nullptr if it was removed
+	Interactable* get(InteractableHandle) const;
+
+	//Gets the handle of an Interactable by its ID, NO_INTERACTABLE if it isn't in the registry
+	InteractableHandle find(int ID) const;
+
+	//Checks if a handle still refers to an Interactable
+	bool getValid(InteractableHandle) const;
+
+	//Gets the amount of Interactables in the registry
+	int getCount() const;
+};
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <vector>
 #include <iostream>
 #include <string>
@@ -9,8 +10,15 @@
 #include "Globals/Globals.h"
 #include "Globals/Math.h"
 #include "Globals/Display.h"
+#include "Globals/DrawQueue.h"
+#include "Globals/TextureCache.h"
 #include "Globals/Font.h"
+#include "Globals/TextRenderer.h"
 #include "Interactables.h"
+#include "Layout.h"
+#include "Components.h"
+#include "WidgetPool.h"
+#include "Instrumentation/FrameProfiler.h"
 
 //Default the ID generator to 0
 int Interactable::IDGenerator = 0;
@@ -74,7 +82,7 @@ float Coordinate::getValue() const { return value; }
  * @return int The Pixel Position of the Coordinate, -1 if no value set
  */
 int Coordinate::getPixelPos(bool useWidth) const {
-    return getPixelPosEx(useWidth, Display::getWidth(), Display::getHeight());
+    return getPixelPosEx(useWidth, Layout::getDisplayWidth(), Layout::getDisplayHeight());
 }
 
 /**
@@ -137,7 +145,7 @@ int Coordinate::getPixelPosEx(bool useWidth, int width, int height) const {
  * @return int The Percentage Position of the Coordinate, -1 if no value set
  */
 float Coordinate::getPercentagePos(bool useWidth) const {
-    return getPercentagePosEx(useWidth, Display::getWidth(), Display::getHeight());
+    return getPercentagePosEx(useWidth, Layout::getDisplayWidth(), Layout::getDisplayHeight());
 };
 
 /**
@@ -189,6 +197,10 @@ float Coordinate::getPercentagePosEx(bool useWidth, int width, int height) const
 void Interactable::init() {
     //Generates the new ID
     ID = IDGenerator++;
+    //Reserves a place for its components and resolved rect
+    slot = Components::allocate();
+    //Only moving, which the manager checks for, until a class has per frame work
+    updates = false;
     //Defaults the color to white
     setPrimaryColor(50, 50, 50, 255);
     setSecondaryColor(25, 25, 25, 255);
@@ -209,7 +221,10 @@ Interactable::Interactable() { init(); }
  * The container will no longer re-render itself
  */
 void Interactable::revalidate() {
-    updated = false;
+    StateComponent& state = Components::getState(slot);
+    state.updated = false;
+    //Remembers where it was drawn, so the area can be redrawn once it moves
+    state.renderedArea = getRect();
 }
 
 /**
@@ -223,10 +238,10 @@ void Interactable::revalidate() {
 Interactable::Interactable(float x, float y, float w, float h) {
     init();
     //Set the values of each Coordinate
-    this->x.setValue(CordType::Percentage, x);
-    this->y.setValue(CordType::Percentage, y);
-    this->w.setValue(CordType::Percentage, w);
-    this->h.setValue(CordType::Percentage, h);
+    setX(CordType::Percentage, x);
+    setY(CordType::Percentage, y);
+    setW(CordType::Percentage, w);
+    setH(CordType::Percentage, h);
 }
 
 /**
@@ -240,39 +255,60 @@ Interactable::Interactable(float x, float y, float w, float h) {
 Interactable::Interactable(int x, int y, int w, int h) {
     init();
     //Set the values of each Coordinate
-    this->x.setValue(CordType::Pixel, x);
-    this->y.setValue(CordType::Pixel, y);
-    this->w.setValue(CordType::Pixel, w);
-    this->h.setValue(CordType::Pixel, h);
+    setX(CordType::Pixel, (float)x);
+    setY(CordType::Pixel, (float)y);
+    setW(CordType::Pixel, (float)w);
+    setH(CordType::Pixel, (float)h);
+}
+
+
+/*
+* Makes the memory for an Interactable in the widget pool
+*
+* @param size, The size of the Interactable (bytes)
+* @return void*, The memory
+*/
+void* Interactable::operator new(size_t size) {
+    return WidgetPool::allocate(size);
+}
+
+/*
+* Gives an Interactable's memory back to the widget pool
+*
+* @param pointer, The memory
+* @param size, The size of the Interactable, the most derived one as the destructor is virtual
+*/
+void Interactable::operator delete(void* pointer, size_t size) {
+    WidgetPool::release(pointer, size);
 }
 
 
 /**
  * @brief Destroy the Interactable object
  */
-Interactable::~Interactable() {}
+Interactable::~Interactable() {
+    Components::release(slot);
+}
 
 
 /*
 * Updates the interactable
-* NOTE: If overriding this function in a child class, This must still be called
+* Moving is checked for by the manager across all its slots, so there's nothing to do here
+* NOTE: Overriding classes must call setUpdates(true) for it to be called
 * 
 * @return int, 0 on success
 */
 int Interactable::update() {
-    //Gets the current Area
-    SDL_Rect currentArea = getRect();
-
-    //Checks if the previous area and current area are different
-    if (!compare(currentArea, prevArea) || Display::getSizeChanged()) {
-        //Then it gets updated
-        invalidate();
-        prevArea = currentArea;
-    }
-
     return 0;
 }
 
+/*
+* Has the manager call update each frame, set before it's added to one
+*
+* @param updates, true if it has per frame work
+*/
+void Interactable::setUpdates(bool updates) { this->updates = updates; }
+
 /*
 * Binds an Interactable to a certain size
 * 
@@ -285,13 +321,16 @@ int Interactable::bindToSize(int width, int height) {
     SDL_assert(width > 0 && height > 0);
     if (width <= 0 || height <= 0) return 1;
 
+    //Nothing has to be laid out / rendered again if it's already bound there
+    LayoutComponent& layout = Components::getLayout(slot);
+    SDL_Rect area = { 0, 0, width, height };    //Defaults the position to (0,0)
+    if (layout.isBound && SDL_RectEquals(&layout.boundRect, &area)) return 0;
+
     //Binds the Interactable
-    boundRect.x = 0;    //Defaults the position to (0,0)
-    boundRect.y = 0;
-    boundRect.w = width;
-    boundRect.h = height;
-    isBound = true;
+    layout.boundRect = area;
+    layout.isBound = true;
     //Invalidates the interactable
+    relayout();
     invalidate();
     //Successfully bound the Interactable
     return 0;
@@ -308,10 +347,15 @@ int Interactable::bindToArea(SDL_Rect area) {
     SDL_assert(area.w > 0 && area.h > 0);
     if (area.w <= 0 || area.h <= 0) return 1;
 
+    //Nothing has to be laid out / rendered again if it's already bound there
+    LayoutComponent& layout = Components::getLayout(slot);
+    if (layout.isBound && SDL_RectEquals(&layout.boundRect, &area)) return 0;
+
     //Binds the Interactable
-    boundRect = area;
-    isBound = true;
+    layout.boundRect = area;
+    layout.isBound = true;
     //Invalidates the interactable
+    relayout();
     invalidate();
     //Successfully bound the Interactable
     return 0;
@@ -321,13 +365,12 @@ int Interactable::bindToArea(SDL_Rect area) {
 * Unbinds the Interactable
 */
 void Interactable::unbind() {
-    boundRect.x = 0;
-    boundRect.y = 0;
-    boundRect.w = -1;
-    boundRect.h = -1;
-    isBound = false;
+    LayoutComponent& layout = Components::getLayout(slot);
+    layout.boundRect = { 0, 0, -1, -1 };
+    layout.isBound = false;
 
     //Invalidates the interactable
+    relayout();
     invalidate();
 }
 
@@ -343,10 +386,7 @@ void Interactable::unbind() {
 */
 int Interactable::setPrimaryColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
     //Sets the color
-    primaryColor.r = r;
-    primaryColor.g = g;
-    primaryColor.b = b;
-    primaryColor.a = a;
+    Components::getStyle(slot).primaryColor = { r, g, b, a };
     //Invalidates the Interactable since the color is different
     invalidate();
 
@@ -364,10 +404,7 @@ int Interactable::setPrimaryColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
 */
 int Interactable::setSecondaryColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
     //Sets the color
-    secondaryColor.r = r;
-    secondaryColor.g = g;
-    secondaryColor.b = b;
-    secondaryColor.a = a;
+    Components::getStyle(slot).secondaryColor = { r, g, b, a };
     //Invalidates the Interactable since the color is different
     invalidate();
 
@@ -385,10 +422,7 @@ int Interactable::setSecondaryColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
 */
 int Interactable::setTertiaryColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
     //Sets the color
-    tertiaryColor.r = r;
-    tertiaryColor.g = g;
-    tertiaryColor.b = b;
-    tertiaryColor.a = a;
+    Components::getStyle(slot).tertiaryColor = { r, g, b, a };
     //Invalidates the Interactable since the color is different
     invalidate();
 
@@ -403,7 +437,8 @@ int Interactable::setTertiaryColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
 * @return int, 0 on success, otherwise an error
 */
 int Interactable::setRenderStyle(RenderStyle style) {
-    this->style = style;
+    Components::getLayout(slot).style = style;
+    relayout();
     invalidate();
     return 0;
 }
@@ -416,7 +451,8 @@ int Interactable::setRenderStyle(RenderStyle style) {
 * @return int, 0 on success
 */
 int Interactable::setX(CordType type, float value) {
-    this->x.setValue(type, value);
+    Components::getLayout(slot).x.setValue(type, value);
+    relayout();
     invalidate();
     return 0;
 }
@@ -429,7 +465,8 @@ int Interactable::setX(CordType type, float value) {
 * @return int, 0 on success
 */
 int Interactable::setY(CordType type, float value) {
-    this->y.setValue(type, value);
+    Components::getLayout(slot).y.setValue(type, value);
+    relayout();
     invalidate();
     return 0;
 }
@@ -442,7 +479,8 @@ int Interactable::setY(CordType type, float value) {
 * @return int, 0 on success
 */
 int Interactable::setW(CordType type, float value) {
-    this->w.setValue(type, value);
+    Components::getLayout(slot).w.setValue(type, value);
+    relayout();
     invalidate();
     return 0;
 }
@@ -455,41 +493,20 @@ int Interactable::setW(CordType type, float value) {
 * @return int, 0 on success
 */
 int Interactable::setH(CordType type, float value) {
-    this->h.setValue(type, value);
+    Components::getLayout(slot).h.setValue(type, value);
+    relayout();
     invalidate();
     return 0;
 }
 
 /**
  * @brief Gets the SDL_Rect of the interactab;e
+ * The rect is only resolved again once it moves, is rebound or the display is resized
  *
  * @return SDL_Rect The rectangle where the interactable is rendered
  */
 SDL_Rect Interactable::getRect() const {
-    SDL_Rect rect;
-
-    int boundWidth = getBoundWidth();
-    int boundHeight = getBoundHeight();
-    //Gets the pixel position of the rectangle
-    rect.x = x.getPixelPosEx(true, boundWidth, boundHeight) - getBoundX();
-    rect.y = y.getPixelPosEx(false, boundWidth, boundHeight) - getBoundY();
-    rect.w = w.getPixelPosEx(true, boundWidth, boundHeight);
-    rect.h = h.getPixelPosEx(false, boundWidth, boundHeight);
-
-    //Changes the position based off the style
-    switch (getRenderStyle()) {
-        // Will Center the texture style
-    case RenderStyle::Centered:
-        rect.x -= rect.w / 2;
-        rect.y -= rect.h / 2;
-        break;
-        //All other styles can exit
-    default:
-        break;
-    }
-
-    //Return the rect
-    return rect;
+    return Components::getRect(slot);
 }
 
 /*
@@ -497,21 +514,21 @@ SDL_Rect Interactable::getRect() const {
 * 
 * @return SDL_Color, The Primary color of the Interactable
 */
-SDL_Color Interactable::getPrimaryColor() const { return primaryColor; }
+SDL_Color Interactable::getPrimaryColor() const { return Components::getStyle(slot).primaryColor; }
 
 /*
 * Gets the secondary color
 *
 * @return SDL_Color, The Secondary color of the Interactable
 */
-SDL_Color Interactable::getSecondaryColor() const { return secondaryColor; }
+SDL_Color Interactable::getSecondaryColor() const { return Components::getStyle(slot).secondaryColor; }
 
 /*
 * Gets the tertiary color
 *
 * @return SDL_Color, The Tertiary color of the Interactable
 */
-SDL_Color Interactable::getTertiaryColor() const { return tertiaryColor; }
+SDL_Color Interactable::getTertiaryColor() const { return Components::getStyle(slot).tertiaryColor; }
 
 /*
 * Gets the style of the image
@@ -519,7 +536,7 @@ SDL_Color Interactable::getTertiaryColor() const { return tertiaryColor; }
 * @return RenderStyle, The Style of the image
 */
 RenderStyle Interactable::getRenderStyle() const {
-    return style;
+    return Components::getLayout(slot).style;
 }
 
 
@@ -566,7 +583,7 @@ int Interactable::getH() const {
 * @return true, The Interactable is bound
 */
 bool Interactable::getIsBound() const {
-    return isBound;
+    return Components::getLayout(slot).isBound;
 }
 
 /*
@@ -588,43 +605,41 @@ SDL_Rect Interactable::getBoundry() const {
 *
 * @return int, The x position of the boundry
 */
-int Interactable::getBoundX() const { return boundRect.x; }
+int Interactable::getBoundX() const { return Components::getLayout(slot).boundRect.x; }
 
 /*
 * Gets the Y coordinate of the boundry
 * 
 * @return int, The y position of the boundry
 */
-int Interactable::getBoundY() const { return boundRect.y; }
+int Interactable::getBoundY() const { return Components::getLayout(slot).boundRect.y; }
 
 /*
 * Gets the Bound width
 * 
-* @return int, The bound width, Display::getWidth() if not bound
+* @return int, The bound width, the display's width if not bound
 */
 int Interactable::getBoundWidth() const {
-    //Gets the display's width
-    int width = Display::getWidth();
     //If it's bound use the bound width
     if (getIsBound()) {
-        width = boundRect.w;
+        return Components::getLayout(slot).boundRect.w;
     }
-    return width;
+    //Gets the display's width, read once per frame
+    return Layout::getDisplayWidth();
 }
 
 /*
 * Gets the Bound height
 *
-* @return int, The bound height, Display::getHeight() if not bound
+* @return int, The bound height, the display's height if not bound
 */
 int Interactable::getBoundHeight() const {
-    //Gets the display's height
-    int height = Display::getHeight();
     //If it's bound use the bound height
     if (getIsBound()) {
-        height = boundRect.h;
+        return Components::getLayout(slot).boundRect.h;
     }
-    return height;
+    //Gets the display's height, read once per frame
+    return Layout::getDisplayHeight();
 }
 
 /**
@@ -634,6 +649,20 @@ int Interactable::getBoundHeight() const {
  */
 int Interactable::getID() const { return ID; }
 
+/*
+* Gets the slot the Interactable's components are kept in
+*
+* @return int, The slot
+*/
+int Interactable::getSlot() const { return slot; }
+
+/*
+* Checks if update has to be called each frame
+*
+* @return bool, true if it has per frame work of its own
+*/
+bool Interactable::getUpdates() const { return updates; }
+
 
 /*
 * Checks if the Interactable was just updated
@@ -641,7 +670,14 @@ int Interactable::getID() const { return ID; }
 * @return true, The Interactable was updated
 * @return false, The Interactable was not updated
 */
-bool Interactable::getUpdated() const { return updated; }
+bool Interactable::getUpdated() const { return Components::getState(slot).updated; }
+
+/*
+* Gets the area the Interactable was last rendered to
+* 
+* @return SDL_Rect, The area, empty if it hasn't been rendered
+*/
+SDL_Rect Interactable::getRenderedRect() const { return Components::getState(slot).renderedArea; }
 
 /*
 * Checks if the position overlaps with the interactable
@@ -695,28 +731,51 @@ int Interactable::mouseScroll(int scrollX, int scrollY, float scrollSpd) {
     return 0;
 }
 
+/*
+* Tells the Interactable where the mouse is hovering, called every frame
+* 
+* @param hoverX, The Mouse's X position, MOUSE_OUTSIDE when it isn't over the window
+* @param hoverY, The Mouse's Y position, MOUSE_OUTSIDE when it isn't over the window
+* @return int, 0 on success, otherwise an error occured
+*/
+int Interactable::mouseHover(int hoverX, int hoverY) {
+    return 0;
+}
+
 /**
  * @brief Renders the interactable
  */
 void Interactable::render() {
     SDL_Rect renderArea = getRect();
 
-    SDL_Color color = getPrimaryColor();
-    //Sets the color
-    SDL_SetRenderDrawColor(Display::getRenderer(), color.r, color.g, color.b, color.a);
     //Renders the auto generated Rect from the interactaable
-    SDL_RenderFillRect(Display::getRenderer(), &renderArea);
+    DrawQueue::fillRect(renderArea, getPrimaryColor());
 
     //Revalidates the Interactable as it has been rendered
     revalidate();
 }
 
 
+/*
+* Marks the rect to be resolved again, after a coordinate / the binding changed
+*/
+void Interactable::relayout() {
+    Layout::markStale(slot);
+}
+
 /*
 * Forces the Interactable to be considered "Updated" thus requiring a re-render
 */
 void Interactable::invalidate() {
-    updated = true;
+    Components::getState(slot).updated = true;
+}
+
+/*
+* Takes back the textures the renderer lost, and re-renders
+* Plain Interactables hold no textures, so they're only re-rendered
+*/
+void Interactable::resetRendering() {
+    invalidate();
 }
 
 /*
@@ -766,8 +825,8 @@ int TextureInteractable::setTexture(std::string path) {
     //Clears the texture
     clearTexture();
 
-    //Loads the texture
-    texture = loadTextureFromFile(path);
+    //Gets the texture, shared with everything else showing the image
+    texture = TextureCache::acquire(path);
 
     //If the texture fails to load, return 2
     if (texture == nullptr) {
@@ -795,13 +854,24 @@ std::string TextureInteractable::getTexturePath() const {
 * Clears the texture from the Interactable
 */
 void TextureInteractable::clearTexture() {
-    //If there already is a previous texture, destroy it
+    //If there already is a previous texture, let go of it
     if (texture != nullptr) {
-        SDL_DestroyTexture(texture);
+        TextureCache::release(texture);
         texture = nullptr;
     }
 }
 
+/*
+* Swaps the lost texture for the one the cache loaded again
+* NOTE: The cache has to be reloaded first
+*/
+void TextureInteractable::resetRendering() {
+    if (texture != nullptr)
+        texture = TextureCache::getTexture(path);
+
+    invalidate();
+}
+
 /*
 * Renders the Texture Interactable
 * 
@@ -816,7 +886,7 @@ void TextureInteractable::render() {
     SDL_Rect renderArea = getRect();
 
     //Copies the texture to the display
-    SDL_RenderCopy(Display::getRenderer(), texture, NULL, &renderArea);
+    DrawQueue::copy(texture, NULL, renderArea);
 
     //Revalidates the Interactable as it has been rendered
     revalidate();
@@ -826,11 +896,12 @@ void TextureInteractable::render() {
 * Initializes the Text Interactable
 */
 void TextInteractable::init() {
-    //Image has not been generated yet
-    text_img = nullptr;
+    TextComponent& component = Components::getText(getSlot());
+    //Defaults the color to white
+    component.textColor = { 255, 255, 255, 255 };
     //Defaults the textWidth to 0
-    textWidth = 0;
-    textHeight = 0;
+    component.textWidth = 0;
+    component.textHeight = 0;
     //Defaults text to "NOT SET!"
     setText("NOT SET!");
 }
@@ -872,15 +943,6 @@ TextInteractable::TextInteractable(std::string text, int x, int y, int w, int h)
     setText(text);
 }
 
-/*
-* Deconstructor
-* 
-* Clears the Texture
-*/
-TextInteractable::~TextInteractable() {
-    clearTextTexture();
-}
-
 
 /*
 * Updates the Text Interactable
@@ -891,7 +953,7 @@ int TextInteractable::update() {
     //Calls the parent function
     Interactable::update();
     
-    return (text_img == nullptr); //(Since 0 is success!)
+    return 0;
 }
 
 /*
@@ -901,7 +963,7 @@ int TextInteractable::update() {
 * @return int, 0 on success
 */
 int TextInteractable::setTextColor(SDL_Color color) {
-    this->textColor = color;
+    Components::getText(getSlot()).textColor = color;
     return 0;
 }
 
@@ -916,40 +978,26 @@ int TextInteractable::setTextColor(SDL_Color color) {
 */
 int TextInteractable::setTextColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
     //Sets the color
-    textColor.r = r;
-    textColor.g = g;
-    textColor.b = b;
-    textColor.a = a;
+    Components::getText(getSlot()).textColor = { r, g, b, a };
 
     return 0;
 }
 
 /**
  * @brief Sets the Text interactables Text to display
+ * The text is drawn from the glyph atlas, so changing it only measures the new text
+ * It's copied into the text already held, so a recycled row reuses its buffer
  *
  * @param text The text to display
- * @return true The text was altered, (Always true atm)
- * @return false There was an error altering the text (Never false atm)
+ * @return true The text was altered
+ * @return false There was an error measuring the text
  */
-bool TextInteractable::setText(std::string text) {
-    this->text = text;
+bool TextInteractable::setText(std::string_view text) {
+    TextComponent& component = Components::getText(getSlot());
+    component.text.assign(text.data(), text.size());
 
     //Gets the size of the text
-    TTF_SizeUTF8(Font::getFontByNameMut(FontName::UIFont), getText().c_str(), &textWidth, &textHeight);
-    
-    //Makes the surface
-    SDL_Surface* text_surf = TTF_RenderText_Blended(Font::getFontByNameMut(FontName::UIFont), getText().c_str(), getTextColor());
-     
-    //Ensures the surface was generated
-    if (text_surf != nullptr) {
-        //Generates the image
-        text_img = SDL_CreateTextureFromSurface(Display::getRenderer(), text_surf);
-        //Clears the surface
-        SDL_FreeSurface(text_surf);
-        text_surf = nullptr;
-    }
-
-    return text_img != nullptr;
+    return TextRenderer::measure(FontName::UIFont, component.text, component.textWidth, component.textHeight) == 0;
 }
 
 
@@ -958,7 +1006,7 @@ bool TextInteractable::setText(std::string text) {
 * 
 * @return SDL_Color, The color of the text
 */
-SDL_Color TextInteractable::getTextColor() const { return textColor; }
+SDL_Color TextInteractable::getTextColor() const { return Components::getText(getSlot()).textColor; }
 
 /*
 * Gets the width of the rendered text
@@ -966,7 +1014,7 @@ SDL_Color TextInteractable::getTextColor() const { return textColor; }
 * 
 * @return int, The height of the rendered text
 */
-int TextInteractable::getTextWidth() const { return textWidth; }
+int TextInteractable::getTextWidth() const { return Components::getText(getSlot()).textWidth; }
 
 /*
 * Gets the height of the rendered text
@@ -974,44 +1022,26 @@ int TextInteractable::getTextWidth() const { return textWidth; }
 * 
 * @return int, The height of the rendered text
 */
-int TextInteractable::getTextHeight() const { return textHeight; }
+int TextInteractable::getTextHeight() const { return Components::getText(getSlot()).textHeight; }
 
 /**
  * @brief Get the text
  *
  * @return std::string The text currently being displayed
  */
-std::string TextInteractable::getText() const { return text; }
+std::string TextInteractable::getText() const { return Components::getText(getSlot()).text; }
 
 
-/*
-* Clears the text texture
-*/
-void TextInteractable::clearTextTexture() {
-    //Delete the current Text Texture
-    if (text_img != nullptr) {
-        SDL_DestroyTexture(text_img);
-        text_img = nullptr;
-    }
-}
-
 /**
  * @brief Renders the text interactable
  */
 void TextInteractable::render() {    
-    //Ensures that the texture image is loaded before rendering
-    SDL_assert(text_img != nullptr);
-    if (text_img == nullptr) return;
-
     //The area to render to
     SDL_Rect renderArea = getRect();
 
-    //Corrects the renderArea for text that is smaller than the given size
-    renderArea.w = getTextWidth();
-    renderArea.h = getTextHeight();
-
-    //Copies the texture to the display
-    SDL_RenderCopy(Display::getRenderer(), text_img, NULL, &renderArea);
+    //Draws the text from the glyph atlas at its own size
+    const TextComponent& component = Components::getText(getSlot());
+    TextRenderer::draw(FontName::UIFont, component.text, renderArea.x, renderArea.y, component.textColor);
 
     //Revalidates the Interactable as it has been rendered
     revalidate();
@@ -1022,7 +1052,12 @@ void TextInteractable::render() {
 /**
  * @brief Initializes the manager
  */
-void InteractableManager::init() {}
+void InteractableManager::init() {
+    gridVersion = 0;
+    gridDirty = true;
+    removedCount = 0;
+    removedArea = { 0, 0, 0, 0 };
+}
 
 /**
  * @brief Construct a new Interactable Manager object
@@ -1052,6 +1087,10 @@ bool InteractableManager::addInteractable(Interactable* toAdd) {
 
     //Renders this interactable first
     interactables.push_back(toAdd);
+    slots.push_back(toAdd->getSlot());
+    updating.push_back(toAdd->getUpdates());
+    handles.push_back(registry.add(toAdd));
+    gridDirty = true;
 
     //The interactable was added so return true
     return true;
@@ -1065,20 +1104,62 @@ bool InteractableManager::addInteractable(Interactable* toAdd) {
  * @return false No interactable was removed
  */
 bool InteractableManager::removeInteractableByID(int ID) {
-    bool removed = false;
-
-    //Loops through each interactable
-    for (int i = 0; i < interactables.size(); i++) {
-        //Checks if the IDs match
-        if (interactables.at(i)->getID() == ID) {
-            //Remove the i'th element
-            delete interactables.at(i);
-            interactables.erase(interactables.begin() + i);
-            removed = true;
+    return removeInteractable(registry.find(ID));
+}
+
+/*
+* Removes an interactable using its handle
+* It's left in place so anything iterating over the interactables isn't disturbed,
+* and deleted when the manager next updates
+*
+* @param handle, The handle to the interactable
+* @return bool, true if it was removed, false if the handle refers to nothing
+*/
+bool InteractableManager::removeInteractable(InteractableHandle handle) {
+    if (!registry.remove(handle)) return false;
+
+    removedCount++;
+    gridDirty = true;
+    return true;
+}
+
+/*
+* Deletes the interactables removed since the last collection
+* One pass keeps the rest in the order they were added, however many were removed,
+* and the area they were rendered to is redrawn so nothing is left behind
+*
+* @return bool, true if any were deleted
+*/
+bool InteractableManager::collectRemoved() {
+    if (removedCount == 0) return false;
+
+    size_t kept = 0;
+    for (size_t i = 0; i < interactables.size(); i++) {
+        Interactable* interactable = interactables[i];
+        if (registry.getValid(handles[i])) {
+            interactables[kept] = interactable;
+            slots[kept] = slots[i];
+            updating[kept] = updating[i];
+            handles[kept] = handles[i];
+            kept++;
+            continue;
         }
+
+        //Forgets it was hovered
+        hovered.erase(std::remove(hovered.begin(), hovered.end(), interactable), hovered.end());
+
+        SDL_Rect renderedArea = interactable->getRenderedRect();
+        SDL_UnionRect(&removedArea, &renderedArea, &removedArea);
+        delete interactable;
     }
 
-    return removed;
+    interactables.resize(kept);
+    slots.resize(kept);
+    updating.resize(kept);
+    handles.resize(kept);
+    removedCount = 0;
+    gridDirty = true;
+    return true;
 }
 
 /**
@@ -1092,6 +1173,45 @@ void InteractableManager::clear() {
     }
     //Then clears the list since they have all been deleted
     interactables.clear();
+    slots.clear();
+    updating.clear();
+    handles.clear();
+    registry.clear();
+    removedCount = 0;
+    hovered.clear();
+    gridDirty = true;
+}
+
+/*
+* Gets the interactables a point is over
+* The grid is rebuilt first if the interactables or the layout changed since it was built
+*
+* @param posX, The X position
+* @param posY, The Y position
+* @param found, Filled with the interactables, in the order they were added
+*/
+void InteractableManager::getInteractablesAt(int posX, int posY, std::vector<Interactable*>& found) {
+    //Only this manager's interactables going stale rebuilds its grid
+    Uint32 version = Layout::getVersion(slots);
+    if (gridDirty || gridVersion != version) {
+        std::vector<SDL_Rect> rects;
+        Components::getRects(slots, rects);
+
+        grid.build(rects);
+        //Resolving the rects doesn't change the version
+        gridVersion = version;
+        gridDirty = false;
+    }
+
+    std::vector<int> indices;
+    grid.query(posX, posY, indices);
+
+    found.clear();
+    for (int index : indices) {
+        //Removed ones don't respond, even before they're collected
+        if (registry.getValid(handles[index]))
+            found.push_back(interactables[index]);
+    }
 }
 
 
@@ -1113,9 +1233,17 @@ const Interactable* InteractableManager::getInteractableByID(int ID) const {
 * @return int, 0 on success, otherwise the value returned is how many interactables failed to update
 */
 int InteractableManager::updateInteractables() {
+    collectRemoved();
+
+    //Marks the ones that moved in one pass down the components
+    Components::updateMoved(slots);
+
+    //Only the ones with per frame work of their own are called
     int failures = 0;
-    for (Interactable* i : interactables) {
-        failures += i->update() != 0;
+    for (size_t i = 0; i < interactables.size(); i++) {
+        if (!updating[i]) continue;
+        ScopeTimer timer(interactables[i], false);
+        failures += interactables[i]->update() != 0;
     }
     return 0;
 }
@@ -1127,20 +1255,45 @@ int InteractableManager::updateInteractables() {
  * @return const Interactable* The mutable interactable, nullptr if not found
  */
 Interactable* InteractableManager::getInteractableByIDMut(int ID) const {
-    Interactable* foundInteract = nullptr;
+    return registry.get(registry.find(ID));
+}
 
-    //Loops through each interactable until it finds one with the same ID
-    for (Interactable* i : interactables) {
-        //If the IDs match
-        if (i->getID() == ID) {
-            foundInteract = i;
-            break;
-        }
-    }
+/*
+* Gets the handle to an interactable by its ID
+*
+* @param ID, The ID of the interactable
+* @return InteractableHandle, The handle, NO_INTERACTABLE if it isn't in the manager
+*/
+InteractableHandle InteractableManager::getHandle(int ID) const { return registry.find(ID); }
 
-    //Returns the found interactable
-    return foundInteract;
-}
+/*
+* Gets an interactable mutably by its handle
+*
+* @param handle, The handle to the interactable
+* @return Interactable*, The mutable interactable, nullptr if it was removed
+*/
+Interactable* InteractableManager::getInteractableMut(InteractableHandle handle) const { return registry.get(handle); }
+
+/*
+* Gets the amount of interactables in the manager
+*
+* @return int, The amount of interactables, not counting removed ones
+*/
+int InteractableManager::getCount() const { return registry.getCount(); }
+
+/*
+* Gets the interactables in the order they were added
+*
+* @return const std::vector<Interactable*>&, The interactables, removed ones included until they're collected
+*/
+const std::vector<Interactable*>& InteractableManager::getInteractables() const { return interactables; }
+
+/*
+* Gets the slot of each interactable, for running the component systems over them
+*
+* @return const std::vector<int>&, The slots, in the same order as the interactables
+*/
+const std::vector<int>& InteractableManager::getSlots() const { return slots; }
 
 
 
@@ -1154,9 +1307,11 @@ Interactable* InteractableManager::getInteractableByIDMut(int ID) const {
 int InteractableManager::click(int clickX, int clickY) {
     int worked = 0;
 
-    //Clicks on every interactable
-    for (Interactable* i : interactables) {
-        int worked = i->click(clickX, clickY);
+    //Clicks on every interactable under the click
+    std::vector<Interactable*> clicked;
+    getInteractablesAt(clickX, clickY, clicked);
+    for (Interactable* i : clicked) {
+        worked = i->click(clickX, clickY);
         //If there was an error it exits
         if (worked) break;
     }
@@ -1173,8 +1328,10 @@ int InteractableManager::click(int clickX, int clickY) {
 */
 int InteractableManager::mouseDown(int downX, int downY) {
     int worked = 0;
-    //Mouse's Down on every interactable
-    for (Interactable* i : interactables) {
+    //Mouse's Down on every interactable under the mouse
+    std::vector<Interactable*> pressed;
+    getInteractablesAt(downX, downY, pressed);
+    for (Interactable* i : pressed) {
         worked = i->mouseDown(downX, downY);
         //If there was an error it exits
         if (worked) break;
@@ -1193,8 +1350,10 @@ int InteractableManager::mouseDown(int downX, int downY) {
 */
 int InteractableManager::mouseScroll(int scrollX, int scrollY, float scrollSpd) {
     int worked = 0;
-    //Mouse's Down on every interactable
-    for (Interactable* i : interactables) {
+    //Scrolls every interactable under the mouse
+    std::vector<Interactable*> scrolled;
+    getInteractablesAt(scrollX, scrollY, scrolled);
+    for (Interactable* i : scrolled) {
         worked = i->mouseScroll(scrollX, scrollY, scrollSpd);
         //If there was an error it exits
         if (worked) break;
@@ -1203,12 +1362,91 @@ int InteractableManager::mouseScroll(int scrollX, int scrollY, float scrollSpd)
     return worked;
 }
 
+/*
+* Tells the interactables under the mouse where it's hovering
+* The ones it was over last frame are told too, so they can respond to it leaving
+*
+* @param hoverX, The Mouse's X position
+* @param hoverY, The Mouse's Y position
+* @return int, 0 on success, otherwise an error occured
+*/
+int InteractableManager::mouseHover(int hoverX, int hoverY) {
+    int worked = 0;
+
+    std::vector<Interactable*> current;
+    getInteractablesAt(hoverX, hoverY, current);
+
+    //The ones the mouse left
+    for (Interactable* i : hovered) {
+        if (std::find(current.begin(), current.end(), i) == current.end())
+            worked |= i->mouseHover(hoverX, hoverY);
+    }
+
+    for (Interactable* i : current)
+        worked |= i->mouseHover(hoverX, hoverY);
+
+    hovered.swap(current);
+    return worked;
+}
+
+/*
+* Gets the area covered by the interactables that have to be re-rendered
+* Covers both where they are and where they were last rendered, so moved interactables leave nothing behind
+*
+* @param area, Filled with the area
+* @return bool, true if anything has to be re-rendered
+*/
+bool InteractableManager::getDirtyArea(SDL_Rect& area) const {
+    bool dirty = Components::getDirtyArea(slots, area);
+
+    //Where removed interactables were
+    if (!SDL_RectEmpty(&removedArea)) {
+        SDL_UnionRect(&area, &removedArea, &area);
+        dirty = true;
+    }
+    return dirty;
+}
+
 /**
  * Renders all the interactables in the Manager
  */
 void InteractableManager::render() {
     //Loops through each interactable rendering each one
-    for (Interactable* i : interactables) {
-        i->render();
+    for (size_t i = 0; i < interactables.size(); i++) {
+        if (!registry.getValid(handles[i])) continue;
+
+        ScopeTimer timer(interactables[i], true);
+        interactables[i]->render();
     }
+    removedArea = { 0, 0, 0, 0 };
 }
+
+/*
+* Renders the interactables that overlap an area, in order so overlapping ones stay on top
+* NOTE: Anything drawn outside the area should be clipped by the caller
+*
+* @param area, The area to redraw
+*/
+void InteractableManager::renderDirty(const SDL_Rect& area) {
+    std::vector<int> toRender;
+    Components::getRenderList(slots, area, toRender);
+
+    for (int index : toRender) {
+        if (!registry.getValid(handles[index])) continue;
+
+        ScopeTimer timer(interactables[index], true);
+        interactables[index]->render();
+    }
+    removedArea = { 0, 0, 0, 0 };
+}
+
+/*
+* Resets the rendering of every interactable, after the renderer lost its textures
+* Containers reset the interactables inside them, so the whole tree is rendered again
+*/
+void InteractableManager::resetInteractables() {
+    for (size_t i = 0; i < interactables.size(); i++) {
+        if (registry.getValid(handles[i]))
+            interactables[i]->resetRendering();
+    }
+}
\ No newline at end of file
@@ -5,9 +5,15 @@
 #include "SDL_rect.h"
 #include "SDL.h"
 
+#include "SpatialGrid.h"
+#include "InteractableRegistry.h"
+
 #include <string>
+#include <string_view>
 #include <vector>
 
+//The position hovered when the mouse isn't over anything, overlaps no interactable
+#define MOUSE_OUTSIDE SDL_MIN_SINT32
 
 /*
 * The style the texture will be rendered in 
@@ -82,6 +88,7 @@ public:
 
 /**
  * @brief The superclass of all interactable elements
+ * Its data is kept in the component arrays (Components.h), this is a facade over its slot
  */
 class Interactable {
 private:
@@ -89,33 +96,21 @@ private:
     static int IDGenerator;
     int ID;
 
-    //The previous area this was rendered (To identify if it was updated)
-    SDL_Rect prevArea;
-
-    //Used for binding Interactables to be within one-another
-    bool isBound;
-    //The boundRect
-    SDL_Rect boundRect;
-
-    //If the interactable just updated
-    bool updated;
-
-    //The position of the UI element
-    Coordinate x, y;
-    //The size of the UI element
-    Coordinate w, h;
-
-    //The colors of the UI
-    SDL_Color primaryColor;
-    SDL_Color secondaryColor;
-    SDL_Color tertiaryColor;
+    //Where its components are kept, shared with the layout
+    int slot;
 
-    //The render style of the interactable
-    RenderStyle style;
+    //If update has to be called each frame
+    bool updates;
 
     //Initializes the Interactable
     void init();
 
+    //Marks the rect to be resolved again
+    void relayout();
+
+protected:
+    //Has the manager call update each frame, for the classes with per frame work of their own
+    void setUpdates(bool);
 
 public:
     //Create an interactable with no default position
@@ -130,7 +125,15 @@ public:
     //Deconstructor (Virtual for child classes)
     virtual ~Interactable();
 
-    //Updating the interactable
+    //Each Interactable has its own layout slot, so it can't be copied
+    Interactable(const Interactable&) = delete;
+    Interactable& operator=(const Interactable&) = delete;
+
+    //Interactables are made in the widget pool
+    static void* operator new(size_t);
+    static void operator delete(void*, size_t);
+
+    //Updating the interactable, only called on the ones set to update
     virtual int update();
    
     /// Binding within another Interactable
@@ -169,7 +172,7 @@ public:
     /// Getters
 
     //Generates an SDL_Rect for drawing to the display
-    virtual SDL_Rect getRect() const;
+    SDL_Rect getRect() const;
 
     //Gets the primary Color
     SDL_Color getPrimaryColor() const;
@@ -207,9 +210,18 @@ public:
     //Gets the ID
     int getID() const;
 
+    //Gets the slot its components are kept in
+    int getSlot() const;
+
+    //Checks if update has to be called each frame
+    bool getUpdates() const;
+
     //Checks if the Interactable was just updated
     bool getUpdated() const;
 
+    //Gets the area it was last rendered to
+    SDL_Rect getRenderedRect() const;
+
     //Checks if a click overlaps with the interactable
     bool getPositionOverlap(int, int) const;
 
@@ -224,6 +236,9 @@ public:
     //What to do when the mouse is scrolled on the interactable
     virtual int mouseScroll(int, int, float);
 
+    //Tells the Interactable where the mouse is hovering, every frame
+    virtual int mouseHover(int, int);
+
     /// Rendering
 
     //Renders the interactable
@@ -232,6 +247,9 @@ public:
     //Forces the Interactable to be considered "Updated" thus requiring a re-render
     void invalidate();
 
+    //Takes back the textures the renderer lost, and re-renders
+    virtual void resetRendering();
+
     /**
      * Revalidates the Interactable
      * This means that if it's in a container, 
@@ -281,6 +299,9 @@ public:
 
     /// Renderering
 
+    //Swaps the lost texture for the one the cache loaded again
+    void resetRendering();
+
     //Renders the TextureInteractable
     void render();
 };
@@ -290,19 +311,6 @@ public:
  */
 class TextInteractable : virtual public Interactable {
 private:
-    //The text displayed
-    std::string text;
-
-    //The color of the Text
-    SDL_Color textColor;
-
-    //The size of the text to be rendered
-    int textWidth;
-    int textHeight;
-
-    //The Texture to render
-    SDL_Texture* text_img;
-
     //Initializes the Text Interactable
     void init();
 public:
@@ -315,9 +323,6 @@ public:
     //Create a text interactable using only pixel positions
     TextInteractable(std::string, int, int, int, int);
 
-    //Deconstructor 
-    ~TextInteractable();
-
     //Updates the text interactable
     int update();
 
@@ -330,7 +335,7 @@ public:
     int setTextColor(Uint8, Uint8, Uint8, Uint8);
 
     //Sets the text to display
-    bool setText(std::string);
+    bool setText(std::string_view);
 
     /// Getters
 
@@ -346,11 +351,6 @@ public:
     //Gets the height of the rendered text
     int getTextHeight() const;
 
-    /// Clearing
-
-    //Clears the text
-    void clearTextTexture();
-
     /// Rendering
 
     //Renders the TextInteractable
@@ -365,11 +365,36 @@ public:
  */
 class InteractableManager {
 protected:
-    //Holds all the interactables
+    //Holds all the interactables, removed ones stay until they're collected
     std::vector<Interactable*> interactables;
+    //The slot of each interactable, in the same order, for the component systems
+    std::vector<int> slots;
+    //If each interactable has update called, in the same order
+    std::vector<bool> updating;
 private:
+    //Finds the interactables by handle or ID
+    InteractableRegistry registry;
+    //The handle of each interactable, in the same order
+    std::vector<InteractableHandle> handles;
+    //How many of the interactables have been removed but not collected
+    int removedCount;
+    //Where the collected interactables were last rendered, redrawn next frame
+    SDL_Rect removedArea;
+
+    //Indexes the interactables by where they are, so pointer events only visit the ones under the pointer
+    SpatialGrid grid;
+    //The layout version the grid was built at, and if the interactables changed since
+    Uint32 gridVersion;
+    bool gridDirty;
+
+    //The interactables the mouse was over last frame
+    std::vector<Interactable*> hovered;
+
     //Initializes the manager
     void init();
+
+    //Gets the interactables a point is over, in the order they were added
+    void getInteractablesAt(int, int, std::vector<Interactable*>&);
 public:
     //Constructs a new interactable manager
     InteractableManager();
@@ -383,9 +408,15 @@ public:
     //Removes an Interactable from the manager using the ID
     bool removeInteractableByID(int);
 
+    //Removes an Interactable from the manager using its handle
+    bool removeInteractable(InteractableHandle);
+
     //Removes all interactables from the manager
     void clear();
 
+    //Deletes the interactables removed since the last collection
+    bool collectRemoved();
+
     //Updates all the interactables
     int updateInteractables();
 
@@ -397,6 +428,21 @@ public:
     //Gets an interactable mutably by its ID
     Interactable* getInteractableByIDMut(int) const;
 
+    //Gets the handle to an interactable by its ID
+    InteractableHandle getHandle(int) const;
+
+    //Gets an interactable mutably by its handle
+    Interactable* getInteractableMut(InteractableHandle) const;
+
+    //Gets the amount of interactables in the manager
+    int getCount() const;
+
+    //Gets the interactables, removed ones included until they're collected
+    const std::vector<Interactable*>& getInteractables() const;
+
+    //Gets the slot of each interactable, in the same order, for the component systems
+    const std::vector<int>& getSlots() const;
+
     /// Interactivity
 
     //Attempts to click on an interactable
@@ -408,8 +454,20 @@ public:
     //Performs the mouse scroll action on the contained interactables
     virtual int mouseScroll(int, int, float);
 
+    //Tells every interactable where the mouse is hovering
+    virtual int mouseHover(int, int);
+
     /// Rendering
 
+    //Gets the area covered by interactables that have to be re-rendered
+    bool getDirtyArea(SDL_Rect&) const;
+
     //Render all interactables
     virtual void render();
+
+    //Renders the interactables that overlap an area
+    void renderDirty(const SDL_Rect&);
+
+    //Resets the rendering of every interactable, containers reset theirs too
+    void resetInteractables();
 };
\ No newline at end of file
@@ -0,0 +1,171 @@
+#include "Layout.h"
+
+#include "SDL_assert.h"
+
+//The resolved rects, indexed by slot
+static std::vector<SDL_Rect> rects;
+//The generation each rect was resolved in, 0 if it's stale
+static std::vector<Uint32> resolvedIn;
+//The version each rect last went stale at
+static std::vector<Uint32> staleAt;
+
+//Slots freed by deleted Interactables
+static std::vector<int> freeSlots;
+
+//Bumped whenever every rect goes stale at once
+static Uint32 generation = 1;
+
+//The size unbound Interactables are laid out in, read once per frame
+static int displayWidth = 0;
+static int displayHeight = 0;
+
+static Uint32 resolves = 0;
+
+//Counts up whenever any rect goes stale, and the version every rect last went stale at together
+static Uint32 version = 0;
+static Uint32 allStaleAt = 0;
+
+
+/*
+* Starts the layout for a frame
+* Every rect goes stale when the display's size changed
+*
+* @param width, The width of the display
+* @param height, The height of the display
+*/
+void Layout::beginFrame(int width, int height) {
+	if (width == displayWidth && height == displayHeight) return;
+
+	displayWidth = width;
+	displayHeight = height;
+	invalidateAll();
+}
+
+/*
+* Reserves a slot for an Interactable's rect, starting stale
+*
+* @return int, The slot
+*/
+int Layout::allocate() {
+	int slot;
+	if (!freeSlots.empty()) {
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+	}
+	else {
+		slot = (int)rects.size();
+		rects.push_back({ 0, 0, 0, 0 });
+		resolvedIn.push_back(0);
+		staleAt.push_back(0);
+	}
+
+	resolvedIn[slot] = 0;
+	return slot;
+}
+
+/*
+* Frees a slot for reuse
+*
+* @param slot, The slot
+*/
+void Layout::release(int slot) {
+	SDL_assert(slot >= 0 && slot < (int)rects.size());
+	if (slot < 0 || slot >= (int)rects.size()) return;
+
+	resolvedIn[slot] = 0;
+	freeSlots.push_back(slot);
+}
+
+/*
+* Marks a rect as needing to be resolved again
+*
+* @param slot, The slot
+*/
+void Layout::markStale(int slot) {
+	SDL_assert(slot >= 0 && slot < (int)rects.size());
+	resolvedIn[slot] = 0;
+	staleAt[slot] = ++version;
+}
+
+/*
+* Marks every rect as needing to be resolved again
+*/
+void Layout::invalidateAll() {
+	allStaleAt = ++version;
+	generation++;
+	//0 always means stale
+	if (generation == 0)
+		generation = 1;
+}
+
+/*
+* Gets a rect
+*
+* @param slot, The slot
+* @param rect, Filled with the rect if it's up to date
+* @return bool, true if the rect is up to date, false if it has to be resolved
+*/
+bool Layout::getRect(int slot, SDL_Rect& rect) {
+	SDL_assert(slot >= 0 && slot < (int)rects.size());
+	if (resolvedIn[slot] != generation) return false;
+
+	rect = rects[slot];
+	return true;
+}
+
+/*
+* Stores a resolved rect, up to date until it's marked stale
+*
+* @param slot, The slot
+* @param rect, The resolved rect
+*/
+void Layout::setRect(int slot, const SDL_Rect& rect) {
+	SDL_assert(slot >= 0 && slot < (int)rects.size());
+	rects[slot] = rect;
+	resolvedIn[slot] = generation;
+	resolves++;
+}
+
+
+/*
+* Gets the width unbound Interactables are laid out in
+*
+* @return int, The width of the display
+*/
+int Layout::getDisplayWidth() { return displayWidth; }
+
+/*
+* Gets the height unbound Interactables are laid out in
+*
+* @return int, The height of the display
+*/
+int Layout::getDisplayHeight() { return displayHeight; }
+
+/*
+* Gets the amount of rects resolved since the start
+*
+* @return Uint32, The amount of rects resolved
+*/
+Uint32 Layout::getResolves() { return resolves; }
+
+/*
+* Gets a number that changes whenever one of the slots' rects goes stale
+* Used to tell when something built from those rects has to be rebuilt, rects going stale elsewhere don't change it
+* NOTE: Slots being added / removed isn't tracked, the owner of the slots knows when that happens
+*
+* @param slots, The slots
+* @return Uint32, The latest version any of the slots went stale at
+*/
+Uint32 Layout::getVersion(const std::vector<int>& slots) {
+	Uint32 latest = allStaleAt;
+	for (int slot : slots)
+		latest = SDL_max(latest, staleAt[slot]);
+	return latest;
+}
+
+/*
+* Gets the amount of slots in use
+*
+* @return int, The amount of Interactables with a slot
+*/
+int Layout::getSlotCount() { return (int)(rects.size() - freeSlots.size()); }
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vector>
+
+#include "SDL.h"
+
+/*
+* Holds the resolved rect of every Interactable in one flat array
+* A rect is resolved from its coordinates the first time it's needed after it goes stale
+* (the Interactable moved / was rebound, or the display was resized), every other getRect is a read
+* NOTE: Main thread only
+*/
+namespace Layout {
+	//Starts the layout for a frame, with the size unbound Interactables are laid out in
+	void beginFrame(int displayWidth, int displayHeight);
+
+	//Reserves a slot for an Interactable's rect
+	int allocate();
+
+	//Frees a slot for reuse
+	void release(int slot);
+
+	//Marks a rect as needing to be resolved again
+	void markStale(int slot);
+
+	//Marks every rect as needing to be resolved again
+	void invalidateAll();
+
+	//Gets a rect, false if it's stale and has to be resolved
+	bool getRect(int slot, SDL_Rect& rect);
+
+	//Stores a resolved rect
+	void setRect(int slot, const SDL_Rect& rect);
+
+	/// Getters
+
+	//Gets the width unbound Interactables are laid out in
+	int getDisplayWidth();
+
+	//Gets the height unbound Interactables are laid out in
+	int getDisplayHeight();
+
+	//Gets the amount of rects resolved since the start
+	Uint32 getResolves();
+
+	//Gets a number that changes whenever one of the slots' rects goes stale
+	Uint32 getVersion(const std::vector<int>& slots);
+
+	//Gets the amount of slots in use
+	int getSlotCount();
+};
@@ -1,8 +1,21 @@
 #include "ListInteractables.h"
 
+#include "Components.h"
+
 #include "Globals/Display.h"
+#include "Globals/TexturePool.h"
+#include "Globals/DrawQueue.h"
+#include "Instrumentation/FrameProfiler.h"
 
 #include <iostream>
+#include <cmath>
+
+//How far each wheel notch glides, relative to the distance it used to jump
+#define SCROLL_GLIDE 4.0f
+//How quickly a glide slows down (1 / second)
+#define SCROLL_FRICTION 10.0f
+//The speed a glide stops at (pixels / second)
+#define SCROLL_MIN_VELOCITY 20.0f
 
 
 /*
@@ -10,36 +23,37 @@
 */
 void ContainerInteractable::init() {
 	renderTexture = nullptr;
+	renderedSize = { 0, 0, 0, 0 };
+	//Updates the interactables inside it
+	setUpdates(true);
 }
 
 /*
-* Clears the Container Interactable's texture
+* Clears the Container Interactable's texture, giving it back to the pool
 */
 void ContainerInteractable::clearTexture() {
-	//Delete the texture
 	if (renderTexture != nullptr) {
-		SDL_DestroyTexture(renderTexture);
+		TexturePool::release(renderTexture);
 		renderTexture = nullptr;
 	}
 }
 
 /*
 * Generates the Container Interactables texture
+* The texture is kept while the size stays in its bucket, otherwise it's swapped for one from the pool
 * 
 * @return int, 0 on success, otherwise an error
 */
 int ContainerInteractable::generateTexture() {
-	//Clears the old texture
-	clearTexture();
+	renderedSize = { 0, 0, getW(), getH() };
 
-	//Creates the new texture
-	renderTexture = SDL_CreateTexture(
-		Display::getRenderer(), 
-		SDL_PIXELFORMAT_ARGB8888, 
-		SDL_TEXTUREACCESS_TARGET, 
-		getW(), 
-		getH()
-	);
+	//Keeps the texture it has if it still fits
+	if (TexturePool::fits(renderTexture, renderedSize.w, renderedSize.h))
+		return 0;
+
+	//Swaps the old texture for one the right size
+	clearTexture();
+	renderTexture = TexturePool::acquire(renderedSize.w, renderedSize.h);
 
 	//Returns 0 if the renderTexture is valid
 	return (renderTexture != nullptr ? 0 : 1);
@@ -55,7 +69,7 @@ int ContainerInteractable::bindInteractablesToArea() {
 	//Generates the Rect to bind the sub-interactables to
 	SDL_Rect bindingRect = genBindingRect();
 	//Binds all interactables to the Width
-	for (Interactable* i : interactables) {
+	for (Interactable* i : manager.getInteractables()) {
 		binded = i->bindToArea(bindingRect);
 		//Exit if there was an error
 		if (binded) break;
@@ -74,26 +88,40 @@ int ContainerInteractable::renderInteractables() {
 	SDL_Texture* currentTarget = SDL_GetRenderTarget(Display::getRenderer());
 
 	//Sets the new render target
-	SDL_SetRenderTarget(Display::getRenderer(), renderTexture);
+	DrawQueue::setTarget(renderTexture);
 
-	SDL_Color color = getPrimaryColor();
-	//Use a clear color
-	SDL_SetRenderDrawColor(Display::getRenderer(), color.r, color.g, color.b, color.a);
 	//Clears the render Texture
-	SDL_RenderClear(Display::getRenderer());
+	DrawQueue::clear(getPrimaryColor());
 
 	//Renders the interactables to the texture
-	InteractableManager::render();
+	manager.render();
 
-	//Sets the render target back to what it was
-	return SDL_SetRenderTarget(Display::getRenderer(), currentTarget);
+	//Sets the render target back to what it was, drawing what was queued for the texture
+	return DrawQueue::setTarget(currentTarget);
+}
+
+/*
+* Gets the texture the sub-interactables are rendered to
+*
+* @return SDL_Texture*, The texture, nullptr if it hasn't been generated
+*/
+SDL_Texture* ContainerInteractable::getRenderTexture() const { return renderTexture; }
+
+/*
+* Copies the rendered texture onto an area of the display
+* The texture can be bigger than the container, only the part rendered to is copied
+*
+* @param renderArea, Where to copy it to
+*/
+void ContainerInteractable::copyTexture(const SDL_Rect& renderArea) {
+	DrawQueue::copy(renderTexture, &renderedSize, renderArea);
 }
 
 /*
 * Default Constructor for Container Interactable
 */
 ContainerInteractable::ContainerInteractable() 
-: InteractableManager(), Interactable() {
+: Interactable() {
 	init();
 }
 
@@ -114,7 +142,7 @@ ContainerInteractable::~ContainerInteractable() {
 */
 bool ContainerInteractable::addInteractable(Interactable* interactable) {
 	//If the interactable was added
-	if (InteractableManager::addInteractable(interactable)) {
+	if (manager.addInteractable(interactable)) {
 		invalidate();
 		return true;
 	}
@@ -154,14 +182,17 @@ int ContainerInteractable::update() {
 * @return int, 0 on success, otherwise an error occured
 */
 int ContainerInteractable::updateInteractables() {
-	int failures = 0;
-	for (Interactable* i : interactables) {
-		failures += i->update() != 0;
-		//Must be ReRendered if an element was updated
-		if (i->getUpdated())
-			invalidate();
-	}
-	return 0;
+	//Must be ReRendered if an element was removed
+	if (manager.collectRemoved())
+		invalidate();
+
+	int failures = manager.updateInteractables();
+
+	//Must be ReRendered if an element was updated
+	SDL_Rect dirtyArea;
+	if (Components::getDirtyArea(manager.getSlots(), dirtyArea))
+		invalidate();
+	return failures;
 }
 
 /*
@@ -175,7 +206,7 @@ int ContainerInteractable::click(int clickX, int clickY) {
 	//Ensures the click overlaps before calling the parent function
 	if (!getPositionOverlap(clickX, clickY)) return 0;
 
-	return InteractableManager::click(clickX - getX(), clickY - getY());
+	return manager.click(clickX - getX(), clickY - getY());
 }
 
 
@@ -190,7 +221,7 @@ int ContainerInteractable::mouseDown(int downX, int downY) {
 	//Ensures the mouse down overlaps before calling the parent function
 	if (!getPositionOverlap(downX, downY)) return 0;
 
-	return InteractableManager::mouseDown(downX - getX(), downY - getY());
+	return manager.mouseDown(downX - getX(), downY - getY());
 }
 
 /*
@@ -205,7 +236,22 @@ int ContainerInteractable::mouseScroll(int scrollX, int scrollY, float scrollSpd
 	//Ensures the mouse down overlaps before calling the parent function
 	if (!getPositionOverlap(scrollX, scrollY)) return 0;
 
-	return InteractableManager::mouseScroll(scrollX - getX(), scrollY - getY(), scrollSpd);
+	return manager.mouseScroll(scrollX - getX(), scrollY - getY(), scrollSpd);
+}
+
+/*
+* On Mouse Hover, will allow the sub-interactables to respond
+*
+* @param hoverX, The hover X position
+* @param hoverY, The hover Y position
+* @return int, 0 on success otherwise an error occured
+*/
+int ContainerInteractable::mouseHover(int hoverX, int hoverY) {
+	//The sub-interactables still need to know the mouse has left them
+	if (!getPositionOverlap(hoverX, hoverY))
+		return manager.mouseHover(MOUSE_OUTSIDE, MOUSE_OUTSIDE);
+
+	return manager.mouseHover(hoverX - getX(), hoverY - getY());
 }
 
 
@@ -236,19 +282,32 @@ void ContainerInteractable::render() {
 
 	//Gets the area to render the Container
 	SDL_Rect renderArea = getRect();
-	SDL_Color color = getPrimaryColor();
 
 	////Draws the background for the container
-	SDL_SetRenderDrawColor(Display::getRenderer(), color.r, color.g, color.b, color.a);
-	SDL_RenderFillRect(Display::getRenderer(), &renderArea);
+	DrawQueue::fillRect(renderArea, getPrimaryColor());
 
 	//Renders the generated texture
-	SDL_RenderCopy(Display::getRenderer(), renderTexture, NULL, &renderArea);
+	copyTexture(renderArea);
 	
 	//Revalidates the container as it has been rendered
 	revalidate();
 }
 
+/*
+* Drops the texture the renderer lost, and resets the interactables inside
+* A new texture is generated when the container is next updated
+*/
+void ContainerInteractable::resetRendering() {
+	//Destroyed rather than given back to the pool, it belonged to the lost renderer
+	if (renderTexture != nullptr) {
+		SDL_DestroyTexture(renderTexture);
+		renderTexture = nullptr;
+	}
+
+	manager.resetInteractables();
+	invalidate();
+}
+
 
 
 
@@ -258,6 +317,13 @@ void ContainerInteractable::render() {
 void ListInteractable::init() {
 	setScrollDist(0);
 	setMaxScrollDist(0);
+	scrollPosition = 0;
+	scrollVelocity = 0;
+
+	renderedScroll = -1;
+	renderedTexture = nullptr;
+	renderedWidth = 0;
+	renderedHeight = 0;
 }
 
 /*
@@ -322,6 +388,157 @@ SDL_Rect ListInteractable::genBindingRect() const {
 
 
 
+/*
+* Renders the interactables onto the ring
+* Only the band scrolled into view and the interactables that changed are rendered,
+* everything else is still in the ring from earlier frames
+*
+* @return int, 0 on success, otherwise an error
+*/
+int ListInteractable::renderInteractables() {
+	SDL_Texture* texture = getRenderTexture();
+	int textureH;
+	if (texture == nullptr || SDL_QueryTexture(texture, NULL, NULL, NULL, &textureH) != 0) return -1;
+
+	int width = getW();
+	int height = getH();
+	int scroll = getScrollDist();
+
+	const std::vector<int>& slots = manager.getSlots();
+
+	//Where each interactable is in the list, they're bound relative to the scroll distance
+	std::vector<SDL_Rect> listRects;
+	Components::getRects(slots, listRects);
+	for (SDL_Rect& rect : listRects)
+		rect.y += scroll;
+
+	SDL_Texture* currentTarget = SDL_GetRenderTarget(Display::getRenderer());
+	DrawQueue::setTarget(texture);
+
+	//Everything is rendered again when the ring holds nothing usable
+	bool fullRender = renderedScroll < 0 || texture != renderedTexture ||
+		width != renderedWidth || height != renderedHeight || SDL_abs(scroll - renderedScroll) >= height;
+
+	if (fullRender) {
+		renderBand(scroll, scroll + height, listRects);
+	}
+	else {
+		//The band scrolled into view
+		if (scroll > renderedScroll)
+			renderBand(renderedScroll + height, scroll + height, listRects);
+		else if (scroll < renderedScroll)
+			renderBand(scroll, renderedScroll, listRects);
+
+		//The interactables that changed in view
+		for (size_t i = 0; i < slots.size(); i++) {
+			if (!Components::getState(slots[i]).updated) continue;
+
+			int top = SDL_max(listRects[i].y, scroll);
+			int bottom = SDL_min(listRects[i].y + listRects[i].h, scroll + height);
+			if (top < bottom)
+				renderBand(top, bottom, listRects);
+		}
+	}
+
+	//Puts the interactables back where the scroll distance has them
+	//Done before revalidating, as moving back from the ring marks them updated
+	DrawQueue::setClipRect(NULL);
+	ContainerInteractable::bindInteractablesToArea();
+
+	//The ones that changed out of view are rendered once they're scrolled into it
+	for (Interactable* i : manager.getInteractables()) {
+		if (i->getUpdated())
+			i->revalidate();
+	}
+
+	renderedScroll = scroll;
+	renderedTexture = texture;
+	renderedWidth = width;
+	renderedHeight = height;
+
+	//Sets the render target back to what it was
+	return DrawQueue::setTarget(currentTarget);
+}
+
+/*
+* Renders a band of the list onto the ring, in one or two pieces if it wraps around the bottom
+* NOTE: The interactables are left bound to the ring, they have to be bound back after
+*
+* @param top, The top of the band in the list
+* @param bottom, The bottom of the band in the list
+* @param listRects, Where each interactable is in the list
+*/
+void ListInteractable::renderBand(int top, int bottom, const std::vector<SDL_Rect>& listRects) {
+	int textureH;
+	SDL_QueryTexture(getRenderTexture(), NULL, NULL, NULL, &textureH);
+
+	SDL_Color color = getPrimaryColor();
+	SDL_Rect bindingRect = genBindingRect();
+
+	while (top < bottom) {
+		//Where the piece is in the ring
+		int ringY = top % textureH;
+		int pieceHeight = SDL_min(bottom - top, textureH - ringY);
+		SDL_Rect piece = { 0, ringY, getW(), pieceHeight };
+		DrawQueue::setClipRect(&piece);
+
+		//Replaces what was there with the background, transparent backgrounds included
+		DrawQueue::fillRect(piece, color, SDL_BLENDMODE_NONE);
+
+		//Binds the interactables in the piece so they land on the ring
+		bindingRect.y = top - ringY;
+		const std::vector<Interactable*>& interactables = manager.getInteractables();
+		for (size_t i = 0; i < interactables.size(); i++) {
+			if (listRects[i].y >= top + pieceHeight || listRects[i].y + listRects[i].h <= top) continue;
+
+			interactables[i]->bindToArea(bindingRect);
+			ScopeTimer timer(interactables[i], true);
+			interactables[i]->render();
+		}
+
+		top += pieceHeight;
+	}
+}
+
+/*
+* Copies the ring onto an area of the display
+* The view starts at the scroll distance in the ring, and wraps back to the top of it
+*
+* @param renderArea, Where to copy it to
+*/
+void ListInteractable::copyTexture(const SDL_Rect& renderArea) {
+	SDL_Texture* texture = getRenderTexture();
+	int textureH;
+	if (SDL_QueryTexture(texture, NULL, NULL, NULL, &textureH) != 0) return;
+
+	int ringY = renderedScroll % textureH;
+	int firstHeight = SDL_min(renderArea.h, textureH - ringY);
+
+	SDL_Rect source = { 0, ringY, renderArea.w, firstHeight };
+	SDL_Rect destination = { renderArea.x, renderArea.y, renderArea.w, firstHeight };
+	DrawQueue::copy(texture, &source, destination);
+
+	//The rest wrapped around to the top of the ring
+	if (firstHeight < renderArea.h) {
+		source = { 0, 0, renderArea.w, renderArea.h - firstHeight };
+		destination = { renderArea.x, renderArea.y + firstHeight, renderArea.w, renderArea.h - firstHeight };
+		DrawQueue::copy(texture, &source, destination);
+	}
+}
+
+
+/*
+* Renders the whole ring again once it has a new texture
+* The new texture can land at the old one's address, so the ring is marked as holding nothing
+*/
+void ListInteractable::resetRendering() {
+	renderedScroll = -1;
+	renderedTexture = nullptr;
+
+	ContainerInteractable::resetRendering();
+}
+
+
 /*
 * Gets how far the mouse is currently scrolled
 * 
@@ -338,6 +555,7 @@ int ListInteractable::getMaxScrollDist() const { return maxScrollDistance; }
 
 /*
 * What to do when the mouse is scrolled on the Interactable
+* Gives the list a push, it glides on the animation clock until it slows to a stop
 *
 * @param scrollX, The Mouse Scroll's X position
 * @param scrollY, The Mouse Scroll's Y position
@@ -347,11 +565,44 @@ int ListInteractable::getMaxScrollDist() const { return maxScrollDistance; }
 int ListInteractable::mouseScroll(int scrollX, int scrollY, float scrollSpd) {
 	//If the scroll overlaps
 	if (getPositionOverlap(scrollX, scrollY)) {
-		//Alters the scroll Distance
-		setScrollDist(getScrollDist() + (int)scrollSpd);
-		invalidate();
+		//Starts from where the list is if it was resting
+		if (scrollVelocity == 0)
+			scrollPosition = (float)getScrollDist();
+		//Scrolling the other way stops the glide first
+		if (scrollVelocity * scrollSpd < 0)
+			scrollVelocity = 0;
+
+		//Glides SCROLL_GLIDE times the scroll speed in total
+		scrollVelocity += scrollSpd * SCROLL_GLIDE * SCROLL_FRICTION;
+		Animation::start(this);
 	}
 
 	return 0;
 }
 
+/*
+* Glides the list by one step, slowing down until it stops
+*
+* @param seconds, The length of the step
+* @return bool, true while the list is still gliding
+*/
+bool ListInteractable::step(float seconds) {
+	scrollPosition += scrollVelocity * seconds;
+	scrollVelocity *= expf(-SCROLL_FRICTION * seconds);
+
+	int previous = getScrollDist();
+	setScrollDist((int)roundf(scrollPosition));
+
+	//Stops at the ends of the list
+	if (getScrollDist() != (int)roundf(scrollPosition)) {
+		scrollPosition = (float)getScrollDist();
+		scrollVelocity = 0;
+	}
+	if (getScrollDist() != previous)
+		invalidate();
+
+	if (fabsf(scrollVelocity) < SCROLL_MIN_VELOCITY)
+		scrollVelocity = 0;
+	return scrollVelocity != 0;
+}
+
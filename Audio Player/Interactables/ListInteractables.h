@@ -2,17 +2,21 @@
 
 
 #include "Interactables.h"
+#include "Globals/Animation.h"
 
 
 #include <vector>
 
 /*
 * Contains other Interactables in a Container
+* The interactables are held by its own manager, positioned relative to the container
 */
-class ContainerInteractable : virtual public Interactable, virtual public InteractableManager {
+class ContainerInteractable : public Interactable {
 private:
-	//The texture all sub-interactables are rendered to
+	//The texture all sub-interactables are rendered to, from the texture pool
 	SDL_Texture* renderTexture;
+	//The part of the texture that was rendered to
+	SDL_Rect renderedSize;
 
 	//Initializes the Container Interactable
 	void init();
@@ -23,6 +27,14 @@ private:
 	//Generates the renderTexture
 	int generateTexture();
 
+	/// Rendering
+
+	//Renders the interactables onto the Container Interactable
+	virtual int renderInteractables();
+protected:
+	//The interactables inside the container
+	InteractableManager manager;
+
 	/// Binding Interactables
 
 	//Binds Interactables to the Containers area
@@ -30,8 +42,11 @@ private:
 
 	/// Rendering
 
-	//Renders the interactables onto the Container Interactable
-	virtual int renderInteractables();
+	//Gets the texture the sub-interactables are rendered to
+	SDL_Texture* getRenderTexture() const;
+
+	//Copies the rendered texture onto an area of the display
+	virtual void copyTexture(const SDL_Rect& renderArea);
 public:
 	//Default Constructor
 	ContainerInteractable();
@@ -40,7 +55,7 @@ public:
 	~ContainerInteractable();
 
 	//Adds an Interactable to the Container Interactable
-	bool addInteractable(Interactable*);
+	virtual bool addInteractable(Interactable*);
 
 	//Updates the Container Interactable
 	int update();
@@ -59,6 +74,9 @@ public:
 	//On Mouse Scroll, will allow the sub-interactables to respond
 	int mouseScroll(int, int, float);
 
+	//On Mouse Hover, will allow the sub-interactables to respond
+	int mouseHover(int, int);
+
 
 	//Generates an SDL_Rect to bind sub interactables to
 	virtual SDL_Rect genBindingRect() const;
@@ -67,21 +85,46 @@ public:
 
 	//Renders the List Interactable
 	void render();
+
+	//Drops the lost texture and resets the interactables inside
+	void resetRendering();
 };
 
 /*
 * The List Interactable is a container Interactable that is scrollable
 */
-class ListInteractable : public ContainerInteractable {
+class ListInteractable : public ContainerInteractable, public Animated {
 private:
 	//The distance the scrolled
 	int scrollDistance;
 
+	//Where the list is gliding, and how fast (pixels / second)
+	float scrollPosition;
+	float scrollVelocity;
+
 	//The max distance the mouse may scroll
 	int maxScrollDistance;
 
+	//The texture is a ring, each pixel of the list is at its y modulo the texture's height
+	//The scroll distance, texture and size it was last rendered at
+	int renderedScroll;
+	SDL_Texture* renderedTexture;
+	int renderedWidth;
+	int renderedHeight;
+
 	//Initializes the List Interactable
 	void init();
+
+	/// Rendering
+
+	//Renders the rows scrolled into view and the ones that changed onto the ring
+	int renderInteractables() override;
+
+	//Renders a band of the list onto the ring
+	void renderBand(int top, int bottom, const std::vector<SDL_Rect>& listRects);
+
+	//Copies the ring onto an area of the display, starting at the scroll distance
+	void copyTexture(const SDL_Rect& renderArea) override;
 public:
 	//Default Constructor
 	ListInteractable();
@@ -112,4 +155,14 @@ public:
 
 	//What to do when the mouse is scrolled on the interactable
 	int mouseScroll(int, int, float);
+
+	/// Rendering
+
+	//Renders the whole ring again once it has a new texture
+	void resetRendering() override;
+
+	/// Animating
+
+	//Glides the list by one step, slowing down until it stops
+	bool step(float seconds) override;
 };
\ No newline at end of file
@@ -0,0 +1,138 @@
+#include "SpatialGrid.h"
+
+#include <cmath>
+
+//The smallest a cell gets (pixels)
+#define MIN_CELL_SIZE 16
+//The most cells a grid has, so huge areas don't blow up the grid
+#define MAX_CELLS 4096
+
+
+/*
+* Constructor, an empty grid
+*/
+SpatialGrid::SpatialGrid() {
+	clear();
+}
+
+/*
+* Empties the grid
+*/
+void SpatialGrid::clear() {
+	bounds = { 0, 0, 0, 0 };
+	cellSize = MIN_CELL_SIZE;
+	columns = 0;
+	rows = 0;
+	cellStarts.assign(1, 0);
+	cellItems.clear();
+	rects.clear();
+}
+
+/*
+* Gets the range of cells a rect covers, clamped to the grid
+*
+* @param rect, The rect
+* @param firstColumn, Set to the leftmost column
+* @param firstRow, Set to the top row
+* @param lastColumn, Set to the rightmost column
+* @param lastRow, Set to the bottom row
+*/
+void SpatialGrid::getCellRange(const SDL_Rect& rect, int& firstColumn, int& firstRow, int& lastColumn, int& lastRow) const {
+	firstColumn = SDL_max((rect.x - bounds.x) / cellSize, 0);
+	firstRow = SDL_max((rect.y - bounds.y) / cellSize, 0);
+	lastColumn = SDL_min((rect.x + rect.w - 1 - bounds.x) / cellSize, columns - 1);
+	lastRow = SDL_min((rect.y + rect.h - 1 - bounds.y) / cellSize, rows - 1);
+}
+
+/*
+* Builds the grid over the rects given
+* The cells are sized so each holds about one rect, rects with no area are left out
+*
+* @param rects, The rects, queries return indices into these
+*/
+void SpatialGrid::build(const std::vector<SDL_Rect>& rects) {
+	clear();
+	this->rects = rects;
+
+	//Covers every rect with some area
+	int count = 0;
+	for (const SDL_Rect& rect : rects) {
+		if (SDL_RectEmpty(&rect)) continue;
+		if (count++ == 0) bounds = rect;
+		else SDL_UnionRect(&bounds, &rect, &bounds);
+	}
+	if (count == 0) return;
+
+	//About one rect per cell, without going over the cell limit
+	double area = (double)bounds.w * bounds.h;
+	cellSize = SDL_max((int)sqrt(area / count), MIN_CELL_SIZE);
+	cellSize = SDL_max(cellSize, (int)ceil(sqrt(area / MAX_CELLS)));
+	columns = (bounds.w + cellSize - 1) / cellSize;
+	rows = (bounds.h + cellSize - 1) / cellSize;
+
+	//Counts the rects in each cell
+	std::vector<int> counts((size_t)columns * rows + 1, 0);
+	int firstColumn, firstRow, lastColumn, lastRow;
+	for (const SDL_Rect& rect : rects) {
+		if (SDL_RectEmpty(&rect)) continue;
+		getCellRange(rect, firstColumn, firstRow, lastColumn, lastRow);
+		for (int row = firstRow; row <= lastRow; row++)
+			for (int column = firstColumn; column <= lastColumn; column++)
+				counts[(size_t)row * columns + column]++;
+	}
+
+	//Lays the cells out back to back
+	cellStarts.assign(counts.size(), 0);
+	for (size_t cell = 1; cell < counts.size(); cell++)
+		cellStarts[cell] = cellStarts[cell - 1] + counts[cell - 1];
+	cellItems.assign(cellStarts.back(), 0);
+
+	//Fills the cells in index order, so each cell is sorted
+	std::vector<int> filled(cellStarts.begin(), cellStarts.end() - 1);
+	for (size_t i = 0; i < rects.size(); i++) {
+		if (SDL_RectEmpty(&rects[i])) continue;
+		getCellRange(rects[i], firstColumn, firstRow, lastColumn, lastRow);
+		for (int row = firstRow; row <= lastRow; row++)
+			for (int column = firstColumn; column <= lastColumn; column++)
+				cellItems[filled[(size_t)row * columns + column]++] = (int)i;
+	}
+}
+
+/*
+* Finds the rects a point is inside of
+* Uses the same edges as Interactable::getPositionOverlap
+*
+* @param x, The X position
+* @param y, The Y position
+* @param indices, Filled with the indices of the rects, in ascending order
+*/
+void SpatialGrid::query(int x, int y, std::vector<int>& indices) const {
+	indices.clear();
+	if (columns == 0 || x < bounds.x || y < bounds.y) return;
+
+	int column = (x - bounds.x) / cellSize;
+	int row = (y - bounds.y) / cellSize;
+	if (column >= columns || row >= rows) return;
+
+	int cell = row * columns + column;
+	for (int item = cellStarts[cell]; item < cellStarts[cell + 1]; item++) {
+		const SDL_Rect& rect = rects[cellItems[item]];
+		if (rect.x < x && rect.y < y && rect.x + rect.w > x && rect.y + rect.h > y)
+			indices.push_back(cellItems[item]);
+	}
+}
+
+
+/*
+* Gets the amount of rects in the grid
+*
+* @return int, The amount of rects it was built from
+*/
+int SpatialGrid::getCount() const { return (int)rects.size(); }
+
+/*
+* Gets the amount of cells in the grid
+*
+* @return int, The amount of cells
+*/
+int SpatialGrid::getCellCount() const { return columns * rows; }
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vector>
+
+#include "SDL.h"
+
+/*
+* A uniform grid over a set of rects, to find the ones under a point without checking them all
+* Each cell lists the rects overlapping it, stored back to back in one array
+*/
+class SpatialGrid {
+private:
+	//The area the grid covers
+	SDL_Rect bounds;
+
+	//The size of each cell, and how many there are
+	int cellSize;
+	int columns;
+	int rows;
+
+	//Where each cell's items start in cellItems, with one extra entry marking the end
+	std::vector<int> cellStarts;
+	//The indices of the rects in each cell, in ascending order
+	std::vector<int> cellItems;
+
+	//The rects the grid was built from
+	std::vector<SDL_Rect> rects;
+
+	//Gets the range of cells a rect covers
+	void getCellRange(const SDL_Rect&, int& firstColumn, int& firstRow, int& lastColumn, int& lastRow) const;
+public:
+	//Constructor, an empty grid
+	SpatialGrid();
+
+	//Builds the grid over the rects given, replacing what it held
+	void build(const std::vector<SDL_Rect>& rects);
+
+	//Empties the grid
+	void clear();
+
+	//Finds the indices of the rects a point is inside of, in ascending order
+	void query(int x, int y, std::vector<int>& indices) const;
+
+	/// Getters
+
+	//Gets the amount of rects in the grid
+	int getCount() const;
+
+	//Gets the amount of cells in the grid
+	int getCellCount() const;
+};
@@ -0,0 +1,178 @@
+#include "WidgetPool.h"
+
+#include <new>
+#include <vector>
+
+#include "SDL_assert.h"
+
+//Sizes are rounded up to a multiple of this (bytes), also keeps the blocks aligned
+#define SIZE_CLASS 64
+//Anything bigger comes straight from the heap
+#define MAX_POOLED_SIZE 1024
+//The blocks in each chunk
+#define BLOCKS_PER_CHUNK 64
+
+/*
+* A block given back, linking to the next free block of its class
+*/
+struct FreeBlock {
+	FreeBlock* next;
+};
+
+//The free blocks of each size class
+static FreeBlock* freeBlocks[MAX_POOLED_SIZE / SIZE_CLASS] = {};
+
+//Every chunk allocated, freed together
+static std::vector<void*> chunks;
+static size_t chunkBytes = 0;
+
+static bool enabled = true;
+
+static unsigned int allocations = 0;
+static unsigned int heapAllocations = 0;
+static int liveCount = 0;
+
+
+/*
+* Gets the size class of an object
+*
+* @param size, The size of the object (bytes)
+* @return int, The index of its class, -1 if it's too big for the pool
+*/
+static int getSizeClass(size_t size) {
+	if (size == 0 || size > MAX_POOLED_SIZE) return -1;
+	return (int)((size - 1) / SIZE_CLASS);
+}
+
+/*
+* Allocates a chunk for a size class, adding its blocks to the free list
+*
+* @param sizeClass, The size class
+*/
+static void addChunk(int sizeClass) {
+	size_t blockSize = (size_t)(sizeClass + 1) * SIZE_CLASS;
+	char* chunk = (char*)::operator new(blockSize * BLOCKS_PER_CHUNK);
+	chunks.push_back(chunk);
+	chunkBytes += blockSize * BLOCKS_PER_CHUNK;
+	heapAllocations++;
+
+	//Linked back to front, so the blocks are handed out in address order
+	for (int i = BLOCKS_PER_CHUNK - 1; i >= 0; i--) {
+		FreeBlock* block = (FreeBlock*)(chunk + blockSize * i);
+		block->next = freeBlocks[sizeClass];
+		freeBlocks[sizeClass] = block;
+	}
+}
+
+
+/*
+* Gets a block for an object
+*
+* @param size, The size of the object (bytes)
+* @return void*, The block, throws std::bad_alloc like new if the heap is out of memory
+*/
+void* WidgetPool::allocate(size_t size) {
+	allocations++;
+	liveCount++;
+
+	int sizeClass = getSizeClass(size);
+	if (!enabled || sizeClass < 0) {
+		heapAllocations++;
+		return ::operator new(size);
+	}
+
+	if (freeBlocks[sizeClass] == nullptr)
+		addChunk(sizeClass);
+
+	FreeBlock* block = freeBlocks[sizeClass];
+	freeBlocks[sizeClass] = block->next;
+	return block;
+}
+
+/*
+* Gives a block back to its size class
+*
+* @param block, The block
+* @param size, The size it was allocated for
+*/
+void WidgetPool::release(void* block, size_t size) {
+	if (block == nullptr) return;
+	liveCount--;
+
+	int sizeClass = getSizeClass(size);
+	if (!enabled || sizeClass < 0) {
+		::operator delete(block);
+		return;
+	}
+
+	FreeBlock* freed = (FreeBlock*)block;
+	freed->next = freeBlocks[sizeClass];
+	freeBlocks[sizeClass] = freed;
+}
+
+/*
+* Frees every chunk
+* NOTE: Every widget has to be deleted first
+*/
+void WidgetPool::clear() {
+	SDL_assert(liveCount == 0);
+	if (liveCount != 0) return;
+
+	for (void* chunk : chunks)
+		::operator delete(chunk);
+	chunks.clear();
+	chunkBytes = 0;
+
+	for (FreeBlock*& block : freeBlocks)
+		block = nullptr;
+}
+
+
+/*
+* Sets whether blocks come from the pool or straight from the heap
+* Can't change while widgets exist, as they have to be given back the way they were allocated
+*
+* @param enabled, true to use the pool
+* @return bool, true if it changed
+*/
+bool WidgetPool::setEnabled(bool enabled) {
+	if (liveCount != 0) return false;
+
+	::enabled = enabled;
+	return true;
+}
+
+/*
+* Checks if blocks come from the pool
+*
+* @return bool, true if the pool is used
+*/
+bool WidgetPool::getEnabled() { return enabled; }
+
+/*
+* Gets the amount of widgets allocated
+*
+* @return unsigned int, The amount since the start
+*/
+unsigned int WidgetPool::getAllocations() { return allocations; }
+
+/*
+* Gets the amount of allocations made on the heap
+*
+* @return unsigned int, The amount since the start
+*/
+unsigned int WidgetPool::getHeapAllocations() { return heapAllocations; }
+
+/*
+* Gets the amount of widgets that exist
+*
+* @return int, The amount allocated and not released
+*/
+int WidgetPool::getLiveCount() { return liveCount; }
+
+/*
+* Gets the amount of memory held in chunks
+*
+* @return size_t, The size of every chunk (bytes)
+*/
+size_t WidgetPool::getChunkBytes() { return chunkBytes; }
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+
+/*
+* Hands out the memory Interactables are made in, from chunks holding many of the same size
+* Sizes are rounded up into classes, each class keeps a free list of the blocks given back
+* so building or rebuilding a UI reuses blocks instead of going to the heap for every widget
+* NOTE: Main thread only
+*/
+namespace WidgetPool {
+	//Gets a block for an object of the size given
+	void* allocate(size_t size);
+
+	//Gives a block back, with the size it was allocated for
+	void release(void* block, size_t size);
+
+	//Frees every chunk, once no widget is left
+	void clear();
+
+	/// Setters
+
+	//Sets whether blocks come from the pool or straight from the heap, only while no widget exists
+	bool setEnabled(bool enabled);
+
+	/// Getters
+
+	//Checks if blocks come from the pool
+	bool getEnabled();
+
+	//Gets the amount of widgets allocated
+	unsigned int getAllocations();
+
+	//Gets the amount of allocations made on the heap, chunks and anything too big for the pool
+	unsigned int getHeapAllocations();
+
+	//Gets the amount of widgets that exist
+	int getLiveCount();
+
+	//Gets the amount of memory held in chunks (bytes)
+	size_t getChunkBytes();
+};
@@ -4,12 +4,23 @@
 #include "MouseController.h"
 #include "Music/MusicPlayer/MusicPlayer.h"
 #include "Globals/Globals.h"
+#include "Globals/Display.h"
+#include "Globals/TextRenderer.h"
+#include "Globals/TextureCache.h"
+#include "Globals/TexturePool.h"
+#include "Instrumentation/DebugOverlay.h"
+#include "Instrumentation/FrameProfiler.h"
 
 
 
 //Should the application quit
 static bool quit = false;
 
+//How much the speed changes per key press
+#define SPEED_STEP 0.1f
+//The ratio between two semitones
+#define SEMITONE 1.059463f
+
 /*
 * ONLY run when mouse is pressed
 * Makes all interactive elements respond to the current mouse click
@@ -44,6 +55,59 @@ void onMouseDown(InteractableManager* manager) {
 	manager->mouseDown(Mouse::getX(), Mouse::getY());
 }
 
+/*
+* Changes the speed / pitch of the playing song
+* [ / ] change the speed, - / = change the pitch by a semitone, \ resets both
+*
+* @param key, The key that was pressed
+*/
+void onRateKey(SDL_Keycode key) {
+	int songID = MusicPlayer::getPlayingSongID();
+	if (songID == -1) return;
+
+	PlaybackRate rate = MusicPlayer::getSongRate(songID);
+	switch (key) {
+	case SDLK_LEFTBRACKET:	rate.speed -= SPEED_STEP; break;
+	case SDLK_RIGHTBRACKET:	rate.speed += SPEED_STEP; break;
+	case SDLK_MINUS:		rate.pitch /= SEMITONE; break;
+	case SDLK_EQUALS:		rate.pitch *= SEMITONE; break;
+	case SDLK_BACKSLASH:	rate = { 1, 1 }; break;
+	default: return;
+	}
+	MusicPlayer::setSongRate(songID, rate.speed, rate.pitch);
+}
+
+/*
+* Runs every frame with where the mouse is hovering
+*/
+void onMouseHover(InteractableManager* manager) {
+	//Nothing is hovered once the mouse leaves the window
+	if (SDL_GetMouseFocus() == nullptr)
+		manager->mouseHover(MOUSE_OUTSIDE, MOUSE_OUTSIDE);
+	else
+		manager->mouseHover(Mouse::getX(), Mouse::getY());
+}
+
+/*
+* Runs when the renderer lost its textures (SDL_RENDER_TARGETS_RESET / SDL_RENDER_DEVICE_RESET)
+* Every texture is made again, and the whole UI is re-rendered into a new frame
+*/
+void onRenderReset(InteractableManager* manager) {
+	//Ensures the manager is valid
+	SDL_assert(manager != nullptr);
+	if (manager == nullptr) return;
+
+	Display::resetFrame();
+
+	//The atlas is rasterized again as text is drawn, and the pooled targets are made again as containers need them
+	TextRenderer::clear();
+	TexturePool::clear();
+
+	//The images are loaded again before the interactables take them back
+	TextureCache::reload();
+	manager->resetInteractables();
+}
+
 /*
 * Runs when the mouse wheel is scrolled
 */
@@ -75,6 +139,32 @@ int recieve(InteractableManager* manager) {
 		if (event.type == SDL_QUIT)
 			quit = true;
 
+		//Redraws everything once the window is shown again
+		if (event.type == SDL_WINDOWEVENT && (event.window.event == SDL_WINDOWEVENT_EXPOSED ||
+			event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED || event.window.event == SDL_WINDOWEVENT_RESTORED))
+			Display::invalidate();
+		//Makes every texture again once the renderer lost them
+		if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET)
+			onRenderReset(manager);
+
+		//Toggles the debug overlay
+		if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F3 && !event.key.repeat)
+			DebugOverlay::toggle();
+
+		//Toggles the frame profiler, and exports what it has
+		if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F4 && !event.key.repeat)
+			FrameProfiler::toggle();
+		if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F5 && !event.key.repeat && FrameProfiler::getEnabled())
+			FrameProfiler::exportCSV("profile");
+
+		//Switches how the next song is picked
+		if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_m && !event.key.repeat)
+			MusicPlayer::cyclePlayMode();
+
+		//Changes the speed / pitch of the playing song
+		if (event.type == SDL_KEYDOWN)
+			onRateKey(event.key.keysym.sym);
+
 
 		/// Multimedia keys
 		if (state[SDL_SCANCODE_AUDIONEXT]) {
@@ -125,6 +215,9 @@ void Input::update(InteractableManager* manager) {
 
 	//Updates whether or not the LMB is down
 	LMBDown = LMBIsDown;
+
+	//Lets interactables respond to the mouse resting on them
+	onMouseHover(manager);
 	//Recieves the inputs
 	recieve(manager);
 }
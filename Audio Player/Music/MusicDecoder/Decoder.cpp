@@ -0,0 +1,117 @@
+#include "Decoder.h"
+#include "WavDecoder.h"
+#include "MixerDecoder.h"
+#include "Mpg123Decoder.h"
+#include "FlacDecoder.h"
+#include "VorbisDecoder.h"
+
+
+/*
+* Works out the format of a song from its first bytes
+* Falls back to the extension, as not every MP3 starts with a recognizable header
+*
+* @param path, The path to the song
+* @return DecoderFormat, The format, Unknown if it couldn't be worked out
+*/
+DecoderFormat Decoders::sniff(std::string path) {
+	Uint8 magic[12] = { 0 };
+
+	SDL_RWops* file = SDL_RWFromFile(path.c_str(), "rb");
+	if (file != nullptr) {
+		SDL_RWread(file, magic, 1, sizeof(magic));
+		SDL_RWclose(file);
+	}
+
+	if (SDL_memcmp(magic, "RIFF", 4) == 0 && SDL_memcmp(magic + 8, "WAVE", 4) == 0)
+		return DecoderFormat::WAV;
+	if (SDL_memcmp(magic, "fLaC", 4) == 0)
+		return DecoderFormat::FLAC;
+	if (SDL_memcmp(magic, "OggS", 4) == 0)
+		return DecoderFormat::Ogg;
+	//An ID3 tag, or an MPEG frame sync
+	if (SDL_memcmp(magic, "ID3", 3) == 0 || (magic[0] == 0xFF && (magic[1] & 0xE0) == 0xE0))
+		return DecoderFormat::MP3;
+
+	//Uses the extension like Mix_LoadMUS does
+	std::string extension = path.substr(path.find_last_of('.') + 1);
+	if (SDL_strcasecmp(extension.c_str(), "wav") == 0) return DecoderFormat::WAV;
+	if (SDL_strcasecmp(extension.c_str(), "mp3") == 0) return DecoderFormat::MP3;
+	if (SDL_strcasecmp(extension.c_str(), "flac") == 0) return DecoderFormat::FLAC;
+	if (SDL_strcasecmp(extension.c_str(), "ogg") == 0) return DecoderFormat::Ogg;
+	return DecoderFormat::Unknown;
+}
+
+/*
+* Creates a backend for a format, without opening anything
+* Formats whose codec library couldn't be loaded are decoded whole by SDL_mixer
+*
+* @param format, The format to decode
+* @return Decoder*, The backend, owned by the caller
+*/
+Decoder* Decoders::create(DecoderFormat format) {
+	switch (format) {
+	case DecoderFormat::WAV:	return new WavDecoder();
+	case DecoderFormat::MP3:	return (Mpg123Decoder::getAvailable() ? (Decoder*)new Mpg123Decoder() : new MixerDecoder("MP3"));
+	case DecoderFormat::FLAC:	return (FlacDecoder::getAvailable() ? (Decoder*)new FlacDecoder() : new MixerDecoder("FLAC"));
+	case DecoderFormat::Ogg:	return (VorbisDecoder::getAvailable() ? (Decoder*)new VorbisDecoder() : new MixerDecoder("Ogg"));
+	default:					return new MixerDecoder("Mixer");
+	}
+}
+
+/*
+* Opens a song with the backend for its format
+* Falls back to SDL_mixer's decoders if the backend can't handle it
+*
+* @param path, The path to the song
+* @return Decoder*, The opened decoder owned by the caller, nullptr if nothing can decode it
+*/
+Decoder* Decoders::open(std::string path) {
+	DecoderFormat format = sniff(path);
+
+	Decoder* decoder = create(format);
+	if (decoder->open(path))
+		return decoder;
+	delete decoder;
+
+	//Something the backend doesn't support (24 bit WAV, Opus in an Ogg, ...)
+	if (format != DecoderFormat::Unknown && getStreams(format)) {
+		decoder = create(DecoderFormat::Unknown);
+		if (decoder->open(path))
+			return decoder;
+		delete decoder;
+	}
+	return nullptr;
+}
+
+/*
+* Checks if the backend for a format streams the file as it's read
+* Backends that don't decode the whole song when it's opened
+*
+* @param format, The format
+* @return bool, true if opening is cheap
+*/
+bool Decoders::getStreams(DecoderFormat format) {
+	switch (format) {
+	case DecoderFormat::WAV:	return true;
+	case DecoderFormat::MP3:	return Mpg123Decoder::getAvailable();
+	case DecoderFormat::FLAC:	return FlacDecoder::getAvailable();
+	case DecoderFormat::Ogg:	return VorbisDecoder::getAvailable();
+	default:					return false;
+	}
+}
+
+/*
+* Gets the name of a format
+*
+* @param format, The format
+* @return const char*, The name of the format
+*/
+const char* Decoders::getFormatName(DecoderFormat format) {
+	switch (format) {
+	case DecoderFormat::WAV:	return "WAV";
+	case DecoderFormat::MP3:	return "MP3";
+	case DecoderFormat::FLAC:	return "FLAC";
+	case DecoderFormat::Ogg:	return "Ogg";
+	default:					return "Unknown";
+	}
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <string>
+
+#include "SDL.h"
+
+/*
+* The formats a file can be sniffed as
+*/
+enum class DecoderFormat {
+	Unknown,
+	WAV,
+	MP3,
+	FLAC,
+	Ogg,
+};
+
+/*
+* Decodes a song into frames in the format of the opened audio device (16 bit, device channels / rate)
+* Each backend handles one or more formats, and is only used by one thread at a time
+*/
+class Decoder {
+public:
+	//Deconstructor, closes the decoder
+	virtual ~Decoder() {}
+
+	//Opens a song, returns false if the backend can't decode it
+	virtual bool open(std::string path) = 0;
+
+	//Reads up to maxFrames interleaved frames, returns 0 at the end of the song
+	virtual int readFrames(Sint16* frames, int maxFrames) = 0;
+
+	//Moves to a frame
+	virtual bool seek(Sint64 frame) = 0;
+
+	//Closes the song, freeing what it holds
+	virtual void close() = 0;
+
+	/// Getters
+
+	//Checks if frames can be read without blocking, false while the backend is still catching up
+	virtual bool getReady() const { return true; }
+
+	//Gets the length of the song in frames, -1 if unknown
+	virtual Sint64 getLength() const = 0;
+
+	//Gets the name of the backend
+	virtual const char* getName() const = 0;
+};
+
+/*
+* Picks the decoder backend for a song by sniffing its content
+*/
+namespace Decoders {
+	//Opens a song with the backend for its format, nullptr if nothing can decode it
+	Decoder* open(std::string path);
+
+	//Creates a backend for a format, without opening anything
+	Decoder* create(DecoderFormat);
+
+	//Works out the format of a song from its first bytes, then its extension
+	DecoderFormat sniff(std::string path);
+
+	//Checks if the backend for a format streams, so opening it is cheap
+	bool getStreams(DecoderFormat);
+
+	//Gets the name of a format
+	const char* getFormatName(DecoderFormat);
+};
@@ -0,0 +1,329 @@
+#include "FlacDecoder.h"
+
+#include <mutex>
+
+#ifdef _WIN32
+#define FLAC_LIBRARY "libFLAC-8.dll"
+#else
+#define FLAC_LIBRARY "libFLAC.so.8"
+#endif
+
+//libFLAC's constants
+#define FLAC_READ_CONTINUE 0
+#define FLAC_READ_END_OF_STREAM 1
+#define FLAC_READ_ABORT 2
+#define FLAC_SEEK_OK 0
+#define FLAC_SEEK_ERROR 1
+#define FLAC_WRITE_CONTINUE 0
+#define FLAC_WRITE_ABORT 1
+#define FLAC_INIT_OK 0
+#define FLAC_STATE_END_OF_STREAM 4
+#define FLAC_STATE_SEEK_ERROR 6
+#define FLAC_METADATA_STREAMINFO 0
+
+/*
+* The start of libFLAC's FLAC__FrameHeader, the rest isn't needed
+*/
+struct FlacFrameHeader {
+	unsigned blockSize;
+	unsigned sampleRate;
+	unsigned channels;
+	int channelAssignment;
+	unsigned bitsPerSample;
+};
+
+/*
+* The start of libFLAC's FLAC__StreamMetadata holding a STREAMINFO block
+*/
+struct FlacStreamInfo {
+	int type;
+	int isLast;
+	unsigned length;
+	unsigned minBlockSize;
+	unsigned maxBlockSize;
+	unsigned minFrameSize;
+	unsigned maxFrameSize;
+	unsigned sampleRate;
+	unsigned channels;
+	unsigned bitsPerSample;
+	Uint64 totalSamples;
+};
+
+/*
+* The functions used from libFLAC, the decoder is opaque
+*/
+static struct {
+	void* (*create)(void);
+	void (*destroy)(void* flac);
+	int (*initStream)(void* flac,
+		int (*read)(const void*, Uint8*, size_t*, void*),
+		int (*seek)(const void*, Uint64, void*),
+		int (*tell)(const void*, Uint64*, void*),
+		int (*length)(const void*, Uint64*, void*),
+		int (*endOfFile)(const void*, void*),
+		int (*write)(const void*, const void*, const Sint32* const[], void*),
+		void (*metadata)(const void*, const void*, void*),
+		void (*error)(const void*, int, void*),
+		void* client);
+	int (*processSingle)(void* flac);
+	int (*processMetadata)(void* flac);
+	int (*seekAbsolute)(void* flac, Uint64 frame);
+	int (*flush)(void* flac);
+	int (*getState)(const void* flac);
+} libFLAC;
+
+static std::once_flag libraryOnce;
+static bool libraryLoaded = false;
+
+
+/*
+* Loads libFLAC, kept loaded until the program exits
+*/
+static void loadLibrary() {
+	void* library = SDL_LoadObject(FLAC_LIBRARY);
+	if (library == nullptr) return;
+
+	bool loaded =
+		StreamDecoder::loadFunction(library, "FLAC__stream_decoder_new", libFLAC.create) &&
+		StreamDecoder::loadFunction(library, "FLAC__stream_decoder_delete", libFLAC.destroy) &&
+		StreamDecoder::loadFunction(library, "FLAC__stream_decoder_init_stream", libFLAC.initStream) &&
+		StreamDecoder::loadFunction(library, "FLAC__stream_decoder_process_single", libFLAC.processSingle) &&
+		StreamDecoder::loadFunction(library, "FLAC__stream_decoder_process_until_end_of_metadata", libFLAC.processMetadata) &&
+		StreamDecoder::loadFunction(library, "FLAC__stream_decoder_seek_absolute", libFLAC.seekAbsolute) &&
+		StreamDecoder::loadFunction(library, "FLAC__stream_decoder_flush", libFLAC.flush) &&
+		StreamDecoder::loadFunction(library, "FLAC__stream_decoder_get_state", libFLAC.getState);
+
+	if (!loaded) {
+		SDL_UnloadObject(library);
+		return;
+	}
+	libraryLoaded = true;
+}
+
+
+/*
+* Constructor
+*/
+FlacDecoder::FlacDecoder() {
+	flac = nullptr;
+	channels = 0;
+	bitsPerSample = 0;
+	totalFrames = -1;
+}
+
+/*
+* Deconstructor
+*/
+FlacDecoder::~FlacDecoder() {
+	close();
+}
+
+/*
+* Opens a FLAC file, only its metadata is read
+*
+* @param path, The path to the song
+* @return bool, true if the file can be decoded
+*/
+bool FlacDecoder::open(std::string path) {
+	close();
+	if (!getAvailable() || !openFile(path)) {
+		close();
+		return false;
+	}
+
+	flac = libFLAC.create();
+	if (flac == nullptr ||
+		libFLAC.initStream(flac, readFile, seekFile, tellFile, lengthFile, endOfFile, writeFrame, readMetadata, skipError, this) != FLAC_INIT_OK ||
+		!libFLAC.processMetadata(flac)) {
+		close();
+		return false;
+	}
+
+	//The STREAMINFO block is always first, so the format is known once the metadata's read
+	if (bitsPerSample <= 0 || bitsPerSample > 32 || !openStream(AUDIO_S32SYS, channels, sourceRate)) {
+		close();
+		return false;
+	}
+	return true;
+}
+
+/*
+* Decodes the next block
+*
+* @return bool, true if there's more to decode
+*/
+bool FlacDecoder::decodeBlock() {
+	return libFLAC.processSingle(flac) && libFLAC.getState(flac) < FLAC_STATE_END_OF_STREAM;
+}
+
+/*
+* Moves libFLAC to a frame, it decodes the block it lands in
+*
+* @param frame, The frame at the files rate
+* @return bool, true if it moved
+*/
+bool FlacDecoder::seekSource(Sint64 frame) {
+	if (libFLAC.seekAbsolute(flac, (Uint64)frame)) return true;
+
+	//The decoder has to be flushed before it can be used again
+	if (libFLAC.getState(flac) == FLAC_STATE_SEEK_ERROR)
+		libFLAC.flush(flac);
+	return false;
+}
+
+/*
+* Gets the length of the song
+*
+* @return Sint64, The length in frames at the files rate, -1 if unknown
+*/
+Sint64 FlacDecoder::getSourceLength() const {
+	return (flac != nullptr ? totalFrames : -1);
+}
+
+/*
+* Frees libFLAC's decoder
+*/
+void FlacDecoder::closeSource() {
+	if (flac != nullptr)
+		libFLAC.destroy(flac);
+
+	flac = nullptr;
+	channels = 0;
+	bitsPerSample = 0;
+	totalFrames = -1;
+}
+
+/*
+* Reads from the file for libFLAC
+*
+* @param buffer, Filled with the bytes read
+* @param bytes, The most bytes to read, set to the amount read
+* @param decoder, The FlacDecoder
+* @return int, The read status
+*/
+int FlacDecoder::readFile(const void*, Uint8* buffer, size_t* bytes, void* decoder) {
+	if (*bytes == 0) return FLAC_READ_ABORT;
+
+	*bytes = SDL_RWread(((FlacDecoder*)decoder)->file, buffer, 1, *bytes);
+	return (*bytes > 0 ? FLAC_READ_CONTINUE : FLAC_READ_END_OF_STREAM);
+}
+
+/*
+* Seeks in the file for libFLAC
+*
+* @param offset, Where to seek to (bytes from the start)
+* @param decoder, The FlacDecoder
+* @return int, The seek status
+*/
+int FlacDecoder::seekFile(const void*, Uint64 offset, void* decoder) {
+	return (SDL_RWseek(((FlacDecoder*)decoder)->file, (Sint64)offset, RW_SEEK_SET) < 0 ? FLAC_SEEK_ERROR : FLAC_SEEK_OK);
+}
+
+/*
+* Gets the position in the file for libFLAC
+*
+* @param offset, Set to the position (bytes)
+* @param decoder, The FlacDecoder
+* @return int, The tell status, which shares its values with seeking
+*/
+int FlacDecoder::tellFile(const void*, Uint64* offset, void* decoder) {
+	Sint64 position = SDL_RWtell(((FlacDecoder*)decoder)->file);
+	if (position < 0) return FLAC_SEEK_ERROR;
+
+	*offset = (Uint64)position;
+	return FLAC_SEEK_OK;
+}
+
+/*
+* Gets the size of the file for libFLAC
+*
+* @param length, Set to the size (bytes)
+* @param decoder, The FlacDecoder
+* @return int, The length status, which shares its values with seeking
+*/
+int FlacDecoder::lengthFile(const void*, Uint64* length, void* decoder) {
+	Sint64 size = SDL_RWsize(((FlacDecoder*)decoder)->file);
+	if (size < 0) return FLAC_SEEK_ERROR;
+
+	*length = (Uint64)size;
+	return FLAC_SEEK_OK;
+}
+
+/*
+* Checks if the whole file has been read for libFLAC
+*
+* @param decoder, The FlacDecoder
+* @return int, true at the end of the file
+*/
+int FlacDecoder::endOfFile(const void*, void* decoder) {
+	SDL_RWops* file = ((FlacDecoder*)decoder)->file;
+	return SDL_RWtell(file) >= SDL_RWsize(file);
+}
+
+/*
+* Interleaves a decoded block into 32 bit samples and hands them to the converter
+*
+* @param frame, libFLAC's FLAC__Frame, starting with its header
+* @param samples, The samples of each channel
+* @param decoder, The FlacDecoder
+* @return int, The write status
+*/
+int FlacDecoder::writeFrame(const void*, const void* frame, const Sint32* const samples[], void* decoder) {
+	FlacDecoder* flacDecoder = (FlacDecoder*)decoder;
+	const FlacFrameHeader* header = (const FlacFrameHeader*)frame;
+	if ((int)header->channels != flacDecoder->channels) return FLAC_WRITE_ABORT;
+
+	int channels = flacDecoder->channels;
+	int shift = 32 - (int)header->bitsPerSample;
+	std::vector<Sint32>& block = flacDecoder->block;
+	block.resize((size_t)header->blockSize * channels);
+
+	Sint32* destination = block.data();
+	for (unsigned i = 0; i < header->blockSize; i++) {
+		for (int channel = 0; channel < channels; channel++)
+			*destination++ = (Sint32)((Uint32)samples[channel][i] << shift);
+	}
+
+	flacDecoder->putSamples(block.data(), (int)(block.size() * sizeof(Sint32)));
+	return FLAC_WRITE_CONTINUE;
+}
+
+/*
+* Reads the format from the STREAMINFO block
+*
+* @param metadata, libFLAC's FLAC__StreamMetadata
+* @param decoder, The FlacDecoder
+*/
+void FlacDecoder::readMetadata(const void*, const void* metadata, void* decoder) {
+	const FlacStreamInfo* info = (const FlacStreamInfo*)metadata;
+	if (info->type != FLAC_METADATA_STREAMINFO) return;
+
+	FlacDecoder* flacDecoder = (FlacDecoder*)decoder;
+	flacDecoder->channels = (int)info->channels;
+	flacDecoder->bitsPerSample = (int)info->bitsPerSample;
+	flacDecoder->sourceRate = (int)info->sampleRate;
+	//0 samples means the length isn't known
+	flacDecoder->totalFrames = (info->totalSamples > 0 ? (Sint64)info->totalSamples : -1);
+}
+
+/*
+* Ignores a corrupt block, libFLAC carries on from the next one
+*/
+void FlacDecoder::skipError(const void*, int, void*) {}
+
+/*
+* Gets the name of the backend
+*
+* @return const char*, The name
+*/
+const char* FlacDecoder::getName() const { return "libFLAC"; }
+
+/*
+* Checks if libFLAC could be loaded, loading it the first time
+*
+* @return bool, true if FLACs can be streamed
+*/
+bool FlacDecoder::getAvailable() {
+	std::call_once(libraryOnce, loadLibrary);
+	return libraryLoaded;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vector>
+
+#include "StreamDecoder.h"
+
+/*
+* Streams FLAC files through libFLAC, the library SDL_mixer ships with
+* The library is loaded the first time it's needed, FLACs fall back to SDL_mixer if it can't be
+*/
+class FlacDecoder : public StreamDecoder {
+private:
+	//The libraries FLAC__StreamDecoder
+	void* flac;
+	//The block being interleaved
+	std::vector<Sint32> block;
+
+	//The format from the files STREAMINFO
+	int channels;
+	int bitsPerSample;
+	Sint64 totalFrames;
+
+	//Decodes the next block
+	bool decodeBlock() override;
+
+	//Moves libFLAC to a frame
+	bool seekSource(Sint64 frame) override;
+
+	//Gets the length of the song at its own rate
+	Sint64 getSourceLength() const override;
+
+	//Frees libFLAC's decoder
+	void closeSource() override;
+
+	//libFLAC's callbacks, given the FlacDecoder as their client data
+	static int readFile(const void* flac, Uint8* buffer, size_t* bytes, void* decoder);
+	static int seekFile(const void* flac, Uint64 offset, void* decoder);
+	static int tellFile(const void* flac, Uint64* offset, void* decoder);
+	static int lengthFile(const void* flac, Uint64* length, void* decoder);
+	static int endOfFile(const void* flac, void* decoder);
+	static int writeFrame(const void* flac, const void* frame, const Sint32* const samples[], void* decoder);
+	static void readMetadata(const void* flac, const void* metadata, void* decoder);
+	static void skipError(const void* flac, int status, void* decoder);
+public:
+	//Constructor
+	FlacDecoder();
+
+	//Deconstructor
+	~FlacDecoder();
+
+	//Opens a FLAC file
+	bool open(std::string path) override;
+
+	/// Getters
+
+	//Gets the name of the backend
+	const char* getName() const override;
+
+	//Checks if libFLAC could be loaded
+	static bool getAvailable();
+};
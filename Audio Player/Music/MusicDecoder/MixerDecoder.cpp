@@ -0,0 +1,121 @@
+#include "MixerDecoder.h"
+
+#include "Music/MusicPlayer/MappedFile.h"
+
+
+/*
+* Constructor
+*
+* @param name, The name of the backend, for the format it's used for
+*/
+MixerDecoder::MixerDecoder(const char* name) : name(name) {
+	chunk = nullptr;
+	frames = 0;
+	position = 0;
+	bytesPerFrame = 4;
+}
+
+/*
+* Deconstructor
+*/
+MixerDecoder::~MixerDecoder() {
+	close();
+}
+
+/*
+* Decodes the whole song into the format of the opened device
+*
+* @param path, The path to the song
+* @return bool, true if the song was decoded
+*/
+bool MixerDecoder::open(std::string path) {
+	close();
+
+	//Reads from the mapping, falling back to SDL's own file reading
+	SDL_RWops* file = MappedFile::openRW(path);
+	if (file == nullptr)
+		file = SDL_RWFromFile(path.c_str(), "rb");
+	if (file == nullptr) return false;
+
+	return openRW(file);
+}
+
+/*
+* Decodes a whole song from an SDL_RWops into the format of the opened device
+*
+* @param file, The song, closed once decoded
+* @return bool, true if the song was decoded
+*/
+bool MixerDecoder::openRW(SDL_RWops* file) {
+	close();
+
+	int frequency, channels;
+	Uint16 format;
+	if (Mix_QuerySpec(&frequency, &format, &channels) == 0 || format != AUDIO_S16SYS) {
+		SDL_RWclose(file);
+		return false;
+	}
+	bytesPerFrame = (int)sizeof(Sint16) * channels;
+
+	//Closes the file once decoded
+	chunk = Mix_LoadWAV_RW(file, 1);
+	if (chunk == nullptr) return false;
+
+	frames = chunk->alen / bytesPerFrame;
+	position = 0;
+	return true;
+}
+
+/*
+* Reads frames from the decoded song
+*
+* @param destination, Filled with the interleaved frames
+* @param maxFrames, The most frames to read
+* @return int, The amount of frames read, 0 at the end of the song
+*/
+int MixerDecoder::readFrames(Sint16* destination, int maxFrames) {
+	if (chunk == nullptr) return 0;
+
+	int count = (int)SDL_min((Sint64)maxFrames, frames - position);
+	SDL_memcpy(destination, chunk->abuf + position * bytesPerFrame, (size_t)count * bytesPerFrame);
+	position += count;
+	return count;
+}
+
+/*
+* Moves to a frame
+*
+* @param frame, The frame to move to
+* @return bool, true if it moved
+*/
+bool MixerDecoder::seek(Sint64 frame) {
+	if (chunk == nullptr) return false;
+
+	position = SDL_min(SDL_max(frame, (Sint64)0), frames);
+	return true;
+}
+
+/*
+* Frees the decoded song
+*/
+void MixerDecoder::close() {
+	if (chunk != nullptr)
+		Mix_FreeChunk(chunk);
+	chunk = nullptr;
+	frames = 0;
+	position = 0;
+}
+
+/*
+* Gets the length of the song
+*
+* @return Sint64, The length in frames, -1 if nothing is open
+*/
+Sint64 MixerDecoder::getLength() const { return (chunk != nullptr ? frames : -1); }
+
+/*
+* Gets the name of the backend
+*
+* @return const char*, The name
+*/
+const char* MixerDecoder::getName() const { return name; }
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Decoder.h"
+
+#include "SDL_mixer.h"
+
+/*
+* Decodes a whole song up front with SDL_mixer's codecs (MP3, FLAC, Ogg, ...), then reads it from memory
+* The decoding runs on the thread that opens it, not inside SDL_mixer's audio callback
+*/
+class MixerDecoder : public Decoder {
+private:
+	//The name of the backend
+	const char* name;
+
+	//The decoded song
+	Mix_Chunk* chunk;
+	Sint64 frames;
+	Sint64 position;
+	int bytesPerFrame;
+public:
+	//Constructor
+	MixerDecoder(const char* name);
+
+	//Deconstructor
+	~MixerDecoder();
+
+	//Decodes the whole song
+	bool open(std::string path) override;
+
+	//Decodes the whole song from an SDL_RWops, closing it
+	bool openRW(SDL_RWops* file);
+
+	//Reads frames from the decoded song
+	int readFrames(Sint16* frames, int maxFrames) override;
+
+	//Moves to a frame
+	bool seek(Sint64 frame) override;
+
+	//Frees the decoded song
+	void close() override;
+
+	/// Getters
+
+	//Gets the length of the song in frames
+	Sint64 getLength() const override;
+
+	//Gets the name of the backend
+	const char* getName() const override;
+};
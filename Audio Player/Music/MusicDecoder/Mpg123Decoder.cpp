@@ -0,0 +1,231 @@
+#include "Mpg123Decoder.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <mutex>
+#include <sys/types.h>
+
+#ifdef _WIN32
+#define MPG123_LIBRARY "libmpg123-0.dll"
+#else
+#define MPG123_LIBRARY "libmpg123.so.0"
+#endif
+
+//The size of each block decoded (bytes)
+#define DECODE_BLOCK_BYTES 16384
+
+//libmpg123's constants
+#define MPG123_OK 0
+#define MPG123_NEW_FORMAT -11
+#define MPG123_ADD_FLAGS 2
+#define MPG123_QUIET 0x20
+#define MPG123_MONO 1
+#define MPG123_STEREO 2
+#define MPG123_ENC_SIGNED_16 0xD0
+
+/*
+* The functions used from libmpg123, the handle is opaque
+*/
+static struct {
+	int (*init)(void);
+	void* (*create)(const char* decoder, int* error);
+	void (*destroy)(void* handle);
+	int (*param)(void* handle, int type, long value, double floatValue);
+	void (*rates)(const long** list, size_t* count);
+	int (*formatNone)(void* handle);
+	int (*format)(void* handle, long rate, int channels, int encodings);
+	int (*replaceReader)(void* handle, ptrdiff_t (*read)(void*, void*, size_t), off_t (*seek)(void*, off_t, int), void (*cleanup)(void*));
+	int (*openHandle)(void* handle, void* file);
+	int (*getFormat)(void* handle, long* rate, int* channels, int* encoding);
+	int (*read)(void* handle, unsigned char* output, size_t size, size_t* done);
+	off_t (*seek)(void* handle, off_t frame, int whence);
+	off_t (*length)(void* handle);
+	int (*close)(void* handle);
+} mpg123;
+
+static std::once_flag libraryOnce;
+static bool libraryLoaded = false;
+
+
+/*
+* Loads libmpg123, kept loaded until the program exits
+*/
+static void loadLibrary() {
+	void* library = SDL_LoadObject(MPG123_LIBRARY);
+	if (library == nullptr) return;
+
+	bool loaded =
+		StreamDecoder::loadFunction(library, "mpg123_init", mpg123.init) &&
+		StreamDecoder::loadFunction(library, "mpg123_new", mpg123.create) &&
+		StreamDecoder::loadFunction(library, "mpg123_delete", mpg123.destroy) &&
+		StreamDecoder::loadFunction(library, "mpg123_param", mpg123.param) &&
+		StreamDecoder::loadFunction(library, "mpg123_rates", mpg123.rates) &&
+		StreamDecoder::loadFunction(library, "mpg123_format_none", mpg123.formatNone) &&
+		StreamDecoder::loadFunction(library, "mpg123_format", mpg123.format) &&
+		StreamDecoder::loadFunction(library, "mpg123_replace_reader_handle", mpg123.replaceReader) &&
+		StreamDecoder::loadFunction(library, "mpg123_open_handle", mpg123.openHandle) &&
+		StreamDecoder::loadFunction(library, "mpg123_getformat", mpg123.getFormat) &&
+		StreamDecoder::loadFunction(library, "mpg123_read", mpg123.read) &&
+		StreamDecoder::loadFunction(library, "mpg123_seek", mpg123.seek) &&
+		StreamDecoder::loadFunction(library, "mpg123_length", mpg123.length) &&
+		StreamDecoder::loadFunction(library, "mpg123_close", mpg123.close);
+
+	if (!loaded || mpg123.init() != MPG123_OK) {
+		SDL_UnloadObject(library);
+		return;
+	}
+	libraryLoaded = true;
+}
+
+/*
+* Reads from the file for libmpg123
+*
+* @param file, The SDL_RWops
+* @param buffer, Filled with the bytes read
+* @param bytes, The most bytes to read
+* @return ptrdiff_t, The amount of bytes read
+*/
+static ptrdiff_t readFile(void* file, void* buffer, size_t bytes) {
+	return (ptrdiff_t)SDL_RWread((SDL_RWops*)file, buffer, 1, bytes);
+}
+
+/*
+* Seeks in the file for libmpg123
+*
+* @param file, The SDL_RWops
+* @param offset, Where to seek to (bytes)
+* @param whence, SEEK_SET / SEEK_CUR / SEEK_END, the same values as RW_SEEK_SET / CUR / END
+* @return off_t, The new position, negative on failure
+*/
+static off_t seekFile(void* file, off_t offset, int whence) {
+	return (off_t)SDL_RWseek((SDL_RWops*)file, offset, whence);
+}
+
+
+/*
+* Constructor
+*/
+Mpg123Decoder::Mpg123Decoder() {
+	handle = nullptr;
+}
+
+/*
+* Deconstructor
+*/
+Mpg123Decoder::~Mpg123Decoder() {
+	close();
+}
+
+/*
+* Opens an MP3 file, only its first frame is decoded to find the format
+*
+* @param path, The path to the song
+* @return bool, true if the file can be decoded
+*/
+bool Mpg123Decoder::open(std::string path) {
+	close();
+	if (!getAvailable() || !openFile(path)) {
+		close();
+		return false;
+	}
+
+	int error;
+	handle = mpg123.create(nullptr, &error);
+	if (handle == nullptr) {
+		close();
+		return false;
+	}
+	mpg123.param(handle, MPG123_ADD_FLAGS, MPG123_QUIET, 0);
+
+	//Only 16 bit output, at whatever rate / channels the file has
+	const long* rates;
+	size_t rateCount;
+	mpg123.rates(&rates, &rateCount);
+	mpg123.formatNone(handle);
+	for (size_t i = 0; i < rateCount; i++)
+		mpg123.format(handle, rates[i], MPG123_MONO | MPG123_STEREO, MPG123_ENC_SIGNED_16);
+
+	long rate;
+	int channels, encoding;
+	if (mpg123.replaceReader(handle, readFile, seekFile, nullptr) != MPG123_OK ||
+		mpg123.openHandle(handle, file) != MPG123_OK ||
+		mpg123.getFormat(handle, &rate, &channels, &encoding) != MPG123_OK) {
+		close();
+		return false;
+	}
+
+	//Locks the format so it can't change part way through the song
+	mpg123.formatNone(handle);
+	mpg123.format(handle, rate, channels, encoding);
+
+	if (!openStream(AUDIO_S16SYS, channels, (int)rate)) {
+		close();
+		return false;
+	}
+	block.resize(DECODE_BLOCK_BYTES);
+	return true;
+}
+
+/*
+* Decodes the next block
+*
+* @return bool, true if there's more to decode
+*/
+bool Mpg123Decoder::decodeBlock() {
+	size_t done = 0;
+	int result = mpg123.read(handle, block.data(), block.size(), &done);
+	putSamples(block.data(), (int)done);
+
+	//The format is locked, so a new format is only the first frame being found
+	return result == MPG123_OK || result == MPG123_NEW_FORMAT;
+}
+
+/*
+* Moves libmpg123 to a frame
+*
+* @param frame, The frame at the files rate
+* @return bool, true if it moved
+*/
+bool Mpg123Decoder::seekSource(Sint64 frame) {
+	return mpg123.seek(handle, (off_t)frame, SEEK_SET) >= 0;
+}
+
+/*
+* Gets the length of the song, estimated from the file size when it has no header giving it
+*
+* @return Sint64, The length in frames at the files rate, -1 if unknown
+*/
+Sint64 Mpg123Decoder::getSourceLength() const {
+	if (handle == nullptr) return -1;
+
+	off_t length = mpg123.length(handle);
+	return (length >= 0 ? (Sint64)length : -1);
+}
+
+/*
+* Frees libmpg123's handle
+*/
+void Mpg123Decoder::closeSource() {
+	if (handle != nullptr) {
+		mpg123.close(handle);
+		mpg123.destroy(handle);
+	}
+	handle = nullptr;
+}
+
+/*
+* Gets the name of the backend
+*
+* @return const char*, The name
+*/
+const char* Mpg123Decoder::getName() const { return "mpg123"; }
+
+/*
+* Checks if libmpg123 could be loaded, loading it the first time
+*
+* @return bool, true if MP3s can be streamed
+*/
+bool Mpg123Decoder::getAvailable() {
+	std::call_once(libraryOnce, loadLibrary);
+	return libraryLoaded;
+}
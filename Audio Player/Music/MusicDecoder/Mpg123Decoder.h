@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+
+#include "StreamDecoder.h"
+
+/*
+* Streams MP3 files through libmpg123, the library SDL_mixer ships with
+* The library is loaded the first time it's needed, MP3s fall back to SDL_mixer if it can't be
+*/
+class Mpg123Decoder : public StreamDecoder {
+private:
+	//The libraries decoder handle
+	void* handle;
+	//The block being decoded
+	std::vector<Uint8> block;
+
+	//Decodes the next block
+	bool decodeBlock() override;
+
+	//Moves libmpg123 to a frame
+	bool seekSource(Sint64 frame) override;
+
+	//Gets the length of the song at its own rate
+	Sint64 getSourceLength() const override;
+
+	//Frees libmpg123's handle
+	void closeSource() override;
+public:
+	//Constructor
+	Mpg123Decoder();
+
+	//Deconstructor
+	~Mpg123Decoder();
+
+	//Opens an MP3 file
+	bool open(std::string path) override;
+
+	/// Getters
+
+	//Gets the name of the backend
+	const char* getName() const override;
+
+	//Checks if libmpg123 could be loaded
+	static bool getAvailable();
+};
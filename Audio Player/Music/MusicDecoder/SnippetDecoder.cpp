@@ -0,0 +1,176 @@
+#include "SnippetDecoder.h"
+
+#include "Globals/Worker.h"
+
+static std::atomic<Uint32> splices(0);
+static std::atomic<Uint32> lateSplices(0);
+
+
+/*
+* Constructor
+*
+* @param snippet, The start of the song, in the format of the device
+* @param channels, The amount of channels the device has
+*/
+SnippetDecoder::SnippetDecoder(std::shared_ptr<const std::vector<Sint16>> snippet, int channels) : snippet(snippet), channels(channels) {
+	snippetFrames = (Sint64)snippet->size() / channels;
+	full = nullptr;
+	spliced = false;
+	position = 0;
+	waited = false;
+}
+
+/*
+* Deconstructor
+*/
+SnippetDecoder::~SnippetDecoder() {
+	close();
+}
+
+/*
+* Starts opening the full song on the worker
+* Only the snippet can be read until it's open
+*
+* @param path, The path to the song
+* @return bool, true if the full song is being opened
+*/
+bool SnippetDecoder::open(std::string path) {
+	close();
+	splice = std::make_shared<Splice>();
+
+	std::shared_ptr<Splice> shared = splice;
+	bool submitted = Worker::submit([shared, path]() {
+		Decoder* decoder = Decoders::open(path);
+
+		std::lock_guard<std::mutex> lock(shared->mutex);
+		//Nothing is waiting on it anymore
+		if (shared->abandoned)
+			delete decoder;
+		else
+			shared->full = decoder;
+		shared->done = true;
+	});
+
+	if (!submitted)
+		splice->done = true;
+	return submitted;
+}
+
+/*
+* Takes the full decoder from the worker, moving it to the position
+*
+* @return bool, true if the full decoder can be read
+*/
+bool SnippetDecoder::takeFull() {
+	if (full == nullptr && splice != nullptr && splice->done) {
+		std::lock_guard<std::mutex> lock(splice->mutex);
+		full = splice->full;
+		splice->full = nullptr;
+	}
+	if (full == nullptr) return false;
+
+	if (!spliced) {
+		spliced = full->seek(position);
+		if (spliced) {
+			splices++;
+			if (waited)
+				lateSplices++;
+		}
+	}
+	return spliced;
+}
+
+/*
+* Reads frames from the snippet, then the full decoder once past it
+* NOTE: Only call once getReady
+*
+* @param destination, Filled with the interleaved frames
+* @param maxFrames, The most frames to read
+* @return int, The amount of frames read, 0 at the end of the song
+*/
+int SnippetDecoder::readFrames(Sint16* destination, int maxFrames) {
+	//Up to the end of the snippet, so the splice lands on a block boundary
+	if (position < snippetFrames) {
+		int count = (int)SDL_min((Sint64)maxFrames, snippetFrames - position);
+		SDL_memcpy(destination, snippet->data() + position * channels, (size_t)count * channels * sizeof(Sint16));
+		position += count;
+		return count;
+	}
+
+	//The full decoder couldn't be opened, the song ends with the snippet
+	if (!takeFull()) return 0;
+
+	int got = full->readFrames(destination, maxFrames);
+	position += got;
+	return got;
+}
+
+/*
+* Moves to a frame
+*
+* @param frame, The frame to move to
+* @return bool, true if it moved
+*/
+bool SnippetDecoder::seek(Sint64 frame) {
+	position = SDL_max(frame, (Sint64)0);
+	//The full decoder is moved when it's next read
+	spliced = false;
+	return true;
+}
+
+/*
+* Closes the full decoder, or leaves it for the worker to delete
+*/
+void SnippetDecoder::close() {
+	if (splice != nullptr) {
+		std::lock_guard<std::mutex> lock(splice->mutex);
+		splice->abandoned = true;
+		delete splice->full;
+		splice->full = nullptr;
+	}
+	splice = nullptr;
+
+	delete full;
+	full = nullptr;
+	spliced = false;
+}
+
+/*
+* Checks if frames can be read without blocking
+*
+* @return bool, false once past the snippet until the full decoder has been opened
+*/
+bool SnippetDecoder::getReady() const {
+	if (position < snippetFrames || full != nullptr || splice == nullptr || splice->done) return true;
+
+	waited = true;
+	return false;
+}
+
+/*
+* Gets the length of the song
+*
+* @return Sint64, The length in frames, -1 until the full decoder has been taken
+*/
+Sint64 SnippetDecoder::getLength() const { return (full != nullptr ? full->getLength() : -1); }
+
+/*
+* Gets the name of the backend
+*
+* @return const char*, The name
+*/
+const char* SnippetDecoder::getName() const { return "Snippet"; }
+
+/*
+* Gets the amount of snippets spliced into their full decoder
+*
+* @return Uint32, The amount of splices
+*/
+Uint32 SnippetDecoder::getSplices() { return splices.load(); }
+
+/*
+* Gets the amount of splices that had to wait on the full decoder, the audio thread may have starved
+*
+* @return Uint32, The amount of late splices
+*/
+Uint32 SnippetDecoder::getLateSplices() { return lateSplices.load(); }
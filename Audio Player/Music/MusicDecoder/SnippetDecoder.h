@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Decoder.h"
+
+/*
+* Plays the pre-decoded start of a song while the full decoder opens on the worker
+* Once past the snippet it splices into the full decoder at the same frame, so the switch can't be heard
+*/
+class SnippetDecoder : public Decoder {
+private:
+	/*
+	* The full decoder being opened on the worker
+	*/
+	struct Splice {
+		std::mutex mutex;
+		//nullptr until opened, or if it couldn't be
+		Decoder* full = nullptr;
+		//Set once the worker is done with it
+		std::atomic<bool> done{ false };
+		//Set if the snippet is deleted before the worker is done
+		bool abandoned = false;
+	};
+
+	//The start of the song, shared with the cache
+	std::shared_ptr<const std::vector<Sint16>> snippet;
+	Sint64 snippetFrames;
+	int channels;
+
+	//Shared with the worker
+	std::shared_ptr<Splice> splice;
+
+	//The full decoder, once taken from the worker
+	Decoder* full;
+	//Has the full decoder been moved to the position
+	bool spliced;
+	Sint64 position;
+
+	//Was the full decoder needed before it was ready
+	mutable bool waited;
+
+	//Takes the full decoder from the worker
+	bool takeFull();
+public:
+	//Constructor, for a snippet in the format of the device
+	SnippetDecoder(std::shared_ptr<const std::vector<Sint16>> snippet, int channels);
+
+	//Deconstructor
+	~SnippetDecoder();
+
+	//Starts opening the full song on the worker
+	bool open(std::string path) override;
+
+	//Reads frames from the snippet, then the full decoder
+	int readFrames(Sint16* frames, int maxFrames) override;
+
+	//Moves to a frame
+	bool seek(Sint64 frame) override;
+
+	//Closes the full decoder
+	void close() override;
+
+	/// Getters
+
+	//Checks if frames can be read, false once past the snippet until the full decoder is ready
+	bool getReady() const override;
+
+	//Gets the length of the song in frames, -1 until spliced
+	Sint64 getLength() const override;
+
+	//Gets the name of the backend
+	const char* getName() const override;
+
+	//Gets the amount of snippets spliced into their full decoder
+	static Uint32 getSplices();
+
+	//Gets the amount of splices that had to wait on the full decoder
+	static Uint32 getLateSplices();
+};
@@ -0,0 +1,133 @@
+#include "StreamDecoder.h"
+
+#include "SDL_mixer.h"
+
+#include "Music/MusicPlayer/MappedFile.h"
+
+
+/*
+* Constructor
+*/
+StreamDecoder::StreamDecoder() {
+	stream = nullptr;
+	deviceRate = 0;
+	deviceChannels = 0;
+	flushed = false;
+	file = nullptr;
+	sourceRate = 0;
+}
+
+/*
+* Opens the file for the codec to read
+*
+* @param path, The path to the song
+* @return bool, true if the file was opened
+*/
+bool StreamDecoder::openFile(std::string path) {
+	//Reads from the mapping, falling back to SDL's own file reading
+	file = MappedFile::openRW(path);
+	if (file == nullptr)
+		file = SDL_RWFromFile(path.c_str(), "rb");
+	return file != nullptr;
+}
+
+/*
+* Starts converting from the codecs format to the devices
+*
+* @param format, The sample format the codec decodes to
+* @param channels, The amount of channels the codec decodes
+* @param rate, The rate the codec decodes at
+* @return bool, true if the format can be converted
+*/
+bool StreamDecoder::openStream(SDL_AudioFormat format, int channels, int rate) {
+	Uint16 deviceFormat;
+	if (Mix_QuerySpec(&deviceRate, &deviceFormat, &deviceChannels) == 0 || deviceFormat != AUDIO_S16SYS) return false;
+	if (channels <= 0 || rate <= 0) return false;
+
+	stream = SDL_NewAudioStream(format, channels, rate, AUDIO_S16SYS, deviceChannels, deviceRate);
+	if (stream == nullptr) return false;
+
+	sourceRate = rate;
+	flushed = false;
+	return true;
+}
+
+/*
+* Hands decoded samples to the converter
+*
+* @param samples, The interleaved samples in the format given to openStream
+* @param bytes, The size of the samples
+*/
+void StreamDecoder::putSamples(const void* samples, int bytes) {
+	if (stream != nullptr && bytes > 0)
+		SDL_AudioStreamPut(stream, samples, bytes);
+}
+
+/*
+* Reads frames, decoding blocks until enough have been converted
+*
+* @param destination, Filled with the interleaved frames
+* @param maxFrames, The most frames to read
+* @return int, The amount of frames read, 0 at the end of the song
+*/
+int StreamDecoder::readFrames(Sint16* destination, int maxFrames) {
+	if (stream == nullptr) return 0;
+
+	int bytesPerFrame = (int)sizeof(Sint16) * deviceChannels;
+	int wanted = maxFrames * bytesPerFrame;
+
+	while (SDL_AudioStreamAvailable(stream) < wanted && !flushed) {
+		if (!decodeBlock()) {
+			//Pushes out what the converter is holding on to
+			SDL_AudioStreamFlush(stream);
+			flushed = true;
+		}
+	}
+
+	int got = SDL_AudioStreamGet(stream, destination, wanted);
+	return (got > 0 ? got / bytesPerFrame : 0);
+}
+
+/*
+* Moves to a frame
+*
+* @param frame, The frame to move to, at the device rate
+* @return bool, true if it moved
+*/
+bool StreamDecoder::seek(Sint64 frame) {
+	if (stream == nullptr) return false;
+
+	//Cleared first, codecs may decode the block they land in while seeking
+	SDL_AudioStreamClear(stream);
+	flushed = false;
+	return seekSource(SDL_max(frame, (Sint64)0) * sourceRate / deviceRate);
+}
+
+/*
+* Closes the codec and the file
+*/
+void StreamDecoder::close() {
+	closeSource();
+
+	if (stream != nullptr)
+		SDL_FreeAudioStream(stream);
+	if (file != nullptr)
+		SDL_RWclose(file);
+
+	stream = nullptr;
+	file = nullptr;
+	sourceRate = 0;
+	flushed = false;
+}
+
+/*
+* Gets the length of the song
+*
+* @return Sint64, The length in frames at the device rate, -1 if nothing is open or it's unknown
+*/
+Sint64 StreamDecoder::getLength() const {
+	if (stream == nullptr) return -1;
+
+	Sint64 length = getSourceLength();
+	return (length >= 0 ? length * deviceRate / sourceRate : -1);
+}
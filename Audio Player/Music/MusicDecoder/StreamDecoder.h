@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Decoder.h"
+
+/*
+* Streams a song through a codec one block at a time, converting it to the format of the device as it's read
+* Each backend only has to decode its next block and seek in its own frames, so opening and seeking never decode the whole song
+* NOTE: Backends call close from their deconstructor, as it closes the codec
+*/
+class StreamDecoder : public Decoder {
+private:
+	//Converts the codecs format to the devices
+	SDL_AudioStream* stream;
+
+	//The format of the device
+	int deviceRate;
+	int deviceChannels;
+
+	//Has the stream been flushed at the end of the song
+	bool flushed;
+protected:
+	//The song being decoded
+	SDL_RWops* file;
+
+	//The rate the codec decodes at
+	int sourceRate;
+
+	//Opens the file for the codec to read
+	bool openFile(std::string path);
+
+	//Starts converting from the codecs format, once it's known
+	bool openStream(SDL_AudioFormat format, int channels, int rate);
+
+	//Hands decoded samples to the converter
+	void putSamples(const void* samples, int bytes);
+
+	//Decodes the next block, false at the end of the song
+	virtual bool decodeBlock() = 0;
+
+	//Moves the codec to a frame at its own rate
+	virtual bool seekSource(Sint64 frame) = 0;
+
+	//Gets the length of the song at the codecs rate, -1 if unknown
+	virtual Sint64 getSourceLength() const = 0;
+
+	//Closes the codec
+	virtual void closeSource() = 0;
+public:
+	//Constructor
+	StreamDecoder();
+
+	//Reads and converts frames
+	int readFrames(Sint16* frames, int maxFrames) override;
+
+	//Moves to a frame
+	bool seek(Sint64 frame) override;
+
+	//Closes the codec and the file
+	void close() override;
+
+	/// Getters
+
+	//Gets the length of the song in frames
+	Sint64 getLength() const override;
+
+	//Loads a function from a codec library
+	template<typename Function>
+	static bool loadFunction(void* library, const char* name, Function& function) {
+		function = (Function)SDL_LoadFunction(library, name);
+		return function != nullptr;
+	}
+};
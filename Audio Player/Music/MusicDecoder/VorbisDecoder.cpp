@@ -0,0 +1,221 @@
+#include "VorbisDecoder.h"
+
+#include <mutex>
+
+#ifdef _WIN32
+#define VORBISFILE_LIBRARY "libvorbisfile-3.dll"
+#else
+#define VORBISFILE_LIBRARY "libvorbisfile.so.3"
+#endif
+
+//The size of each block decoded (bytes)
+#define DECODE_BLOCK_BYTES 16384
+//Room for libvorbisfile's OggVorbis_File, which is under 1KB on every platform it ships for
+#define VORBIS_FILE_BYTES 4096
+
+//libvorbisfile's constants
+#define OV_HOLE -3
+
+/*
+* The callbacks libvorbisfile reads the file through
+*/
+struct VorbisCallbacks {
+	size_t (*read)(void* buffer, size_t size, size_t count, void* file);
+	int (*seek)(void* file, Sint64 offset, int whence);
+	int (*close)(void* file);
+	long (*tell)(void* file);
+};
+
+/*
+* The start of libvorbisfile's vorbis_info, the rest isn't needed
+*/
+struct VorbisInfo {
+	int version;
+	int channels;
+	long rate;
+};
+
+/*
+* The functions used from libvorbisfile, the OggVorbis_File is opaque
+*/
+static struct {
+	int (*openCallbacks)(void* file, void* vorbisFile, const char* initial, long initialBytes, VorbisCallbacks callbacks);
+	VorbisInfo* (*info)(void* vorbisFile, int link);
+	long (*read)(void* vorbisFile, char* buffer, int length, int bigEndian, int word, int isSigned, int* link);
+	int (*pcmSeek)(void* vorbisFile, Sint64 frame);
+	Sint64 (*pcmTotal)(void* vorbisFile, int link);
+	int (*clear)(void* vorbisFile);
+} vorbis;
+
+static std::once_flag libraryOnce;
+static bool libraryLoaded = false;
+
+
+/*
+* Loads libvorbisfile, kept loaded until the program exits
+*/
+static void loadLibrary() {
+	void* library = SDL_LoadObject(VORBISFILE_LIBRARY);
+	if (library == nullptr) return;
+
+	bool loaded =
+		StreamDecoder::loadFunction(library, "ov_open_callbacks", vorbis.openCallbacks) &&
+		StreamDecoder::loadFunction(library, "ov_info", vorbis.info) &&
+		StreamDecoder::loadFunction(library, "ov_read", vorbis.read) &&
+		StreamDecoder::loadFunction(library, "ov_pcm_seek", vorbis.pcmSeek) &&
+		StreamDecoder::loadFunction(library, "ov_pcm_total", vorbis.pcmTotal) &&
+		StreamDecoder::loadFunction(library, "ov_clear", vorbis.clear);
+
+	if (!loaded) {
+		SDL_UnloadObject(library);
+		return;
+	}
+	libraryLoaded = true;
+}
+
+/*
+* Reads from the file for libvorbisfile
+*
+* @param buffer, Filled with the bytes read
+* @param size, The size of each item
+* @param count, The most items to read
+* @param file, The SDL_RWops
+* @return size_t, The amount of items read
+*/
+static size_t readFile(void* buffer, size_t size, size_t count, void* file) {
+	return SDL_RWread((SDL_RWops*)file, buffer, size, count);
+}
+
+/*
+* Seeks in the file for libvorbisfile
+*
+* @param file, The SDL_RWops
+* @param offset, Where to seek to (bytes)
+* @param whence, SEEK_SET / SEEK_CUR / SEEK_END, the same values as RW_SEEK_SET / CUR / END
+* @return int, 0 on success
+*/
+static int seekFile(void* file, Sint64 offset, int whence) {
+	return (SDL_RWseek((SDL_RWops*)file, offset, whence) < 0 ? -1 : 0);
+}
+
+/*
+* Gets the position in the file for libvorbisfile
+*
+* @param file, The SDL_RWops
+* @return long, The position (bytes)
+*/
+static long tellFile(void* file) {
+	return (long)SDL_RWtell((SDL_RWops*)file);
+}
+
+
+/*
+* Constructor
+*/
+VorbisDecoder::VorbisDecoder() {
+	vorbisFile = nullptr;
+}
+
+/*
+* Deconstructor
+*/
+VorbisDecoder::~VorbisDecoder() {
+	close();
+}
+
+/*
+* Opens an Ogg Vorbis file, only its headers are read
+*
+* @param path, The path to the song
+* @return bool, true if the file can be decoded
+*/
+bool VorbisDecoder::open(std::string path) {
+	close();
+	if (!getAvailable() || !openFile(path)) {
+		close();
+		return false;
+	}
+
+	//The file is closed by us, not libvorbisfile
+	VorbisCallbacks callbacks = { readFile, seekFile, nullptr, tellFile };
+	void* opening = SDL_calloc(1, VORBIS_FILE_BYTES);
+	if (opening == nullptr || vorbis.openCallbacks(file, opening, nullptr, 0, callbacks) != 0) {
+		//A file that failed to open has already been cleared
+		SDL_free(opening);
+		close();
+		return false;
+	}
+	vorbisFile = opening;
+
+	VorbisInfo* info = vorbis.info(vorbisFile, -1);
+	if (info == nullptr || !openStream(AUDIO_S16SYS, info->channels, (int)info->rate)) {
+		close();
+		return false;
+	}
+	block.resize(DECODE_BLOCK_BYTES);
+	return true;
+}
+
+/*
+* Decodes the next block
+*
+* @return bool, true if there's more to decode
+*/
+bool VorbisDecoder::decodeBlock() {
+	int link;
+	long got = vorbis.read(vorbisFile, (char*)block.data(), (int)block.size(), (SDL_BYTEORDER == SDL_BIG_ENDIAN ? 1 : 0), 2, 1, &link);
+	putSamples(block.data(), (int)SDL_max(got, 0L));
+
+	//A hole in the data is skipped over
+	return got > 0 || got == OV_HOLE;
+}
+
+/*
+* Moves libvorbisfile to a frame
+*
+* @param frame, The frame at the files rate
+* @return bool, true if it moved
+*/
+bool VorbisDecoder::seekSource(Sint64 frame) {
+	return vorbis.pcmSeek(vorbisFile, frame) == 0;
+}
+
+/*
+* Gets the length of the song
+*
+* @return Sint64, The length in frames at the files rate, -1 if unknown
+*/
+Sint64 VorbisDecoder::getSourceLength() const {
+	if (vorbisFile == nullptr) return -1;
+
+	Sint64 length = vorbis.pcmTotal(vorbisFile, -1);
+	return (length >= 0 ? length : -1);
+}
+
+/*
+* Frees libvorbisfile's file
+*/
+void VorbisDecoder::closeSource() {
+	if (vorbisFile != nullptr) {
+		vorbis.clear(vorbisFile);
+		SDL_free(vorbisFile);
+	}
+	vorbisFile = nullptr;
+}
+
+/*
+* Gets the name of the backend
+*
+* @return const char*, The name
+*/
+const char* VorbisDecoder::getName() const { return "Vorbis"; }
+
+/*
+* Checks if libvorbisfile could be loaded, loading it the first time
+*
+* @return bool, true if Ogg Vorbis files can be streamed
+*/
+bool VorbisDecoder::getAvailable() {
+	std::call_once(libraryOnce, loadLibrary);
+	return libraryLoaded;
+}
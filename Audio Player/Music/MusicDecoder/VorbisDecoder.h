@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+
+#include "StreamDecoder.h"
+
+/*
+* Streams Ogg Vorbis files through libvorbisfile, the library SDL_mixer ships with
+* The library is loaded the first time it's needed, Ogg files fall back to SDL_mixer if it can't be
+*/
+class VorbisDecoder : public StreamDecoder {
+private:
+	//libvorbisfile's OggVorbis_File, nullptr if nothing is open
+	void* vorbisFile;
+	//The block being decoded
+	std::vector<Uint8> block;
+
+	//Decodes the next block
+	bool decodeBlock() override;
+
+	//Moves libvorbisfile to a frame
+	bool seekSource(Sint64 frame) override;
+
+	//Gets the length of the song at its own rate
+	Sint64 getSourceLength() const override;
+
+	//Frees libvorbisfile's file
+	void closeSource() override;
+public:
+	//Constructor
+	VorbisDecoder();
+
+	//Deconstructor
+	~VorbisDecoder();
+
+	//Opens an Ogg Vorbis file
+	bool open(std::string path) override;
+
+	/// Getters
+
+	//Gets the name of the backend
+	const char* getName() const override;
+
+	//Checks if libvorbisfile could be loaded
+	static bool getAvailable();
+};
@@ -0,0 +1,218 @@
+#include "WavDecoder.h"
+
+#include "SDL_mixer.h"
+
+#include "Music/MusicPlayer/MappedFile.h"
+
+//The size of each raw block read from the file (bytes)
+#define RAW_BLOCK_SIZE 16384
+
+//The WAV format tags
+#define WAVE_FORMAT_PCM 0x0001
+#define WAVE_FORMAT_IEEE_FLOAT 0x0003
+#define WAVE_FORMAT_EXTENSIBLE 0xFFFE
+
+
+/*
+* Constructor
+*/
+WavDecoder::WavDecoder() {
+	file = nullptr;
+	stream = nullptr;
+	dataOffset = 0;
+	dataSize = 0;
+	dataRead = 0;
+	blockAlign = 0;
+	fileRate = 0;
+	deviceRate = 0;
+	deviceChannels = 0;
+	flushed = false;
+}
+
+/*
+* Deconstructor
+*/
+WavDecoder::~WavDecoder() {
+	close();
+}
+
+/*
+* Reads the format from the "fmt " chunk and finds the "data" chunk
+*
+* @param format, Set to the sample format of the file
+* @param channels, Set to the amount of channels in the file
+* @return bool, true if the file can be decoded
+*/
+bool WavDecoder::readHeader(SDL_AudioFormat& format, int& channels) {
+	char id[4];
+
+	//"RIFF" <size> "WAVE"
+	if (SDL_RWread(file, id, 1, 4) != 4 || SDL_memcmp(id, "RIFF", 4) != 0) return false;
+	SDL_ReadLE32(file);
+	if (SDL_RWread(file, id, 1, 4) != 4 || SDL_memcmp(id, "WAVE", 4) != 0) return false;
+
+	bool foundFormat = false;
+	while (SDL_RWread(file, id, 1, 4) == 4) {
+		Uint32 size = SDL_ReadLE32(file);
+		Sint64 next = SDL_RWtell(file) + size + (size & 1);	//Chunks are padded to 2 bytes
+
+		if (SDL_memcmp(id, "fmt ", 4) == 0) {
+			Uint16 tag = SDL_ReadLE16(file);
+			channels = SDL_ReadLE16(file);
+			fileRate = SDL_ReadLE32(file);
+			SDL_ReadLE32(file);	//Byte rate
+			blockAlign = SDL_ReadLE16(file);
+			Uint16 bits = SDL_ReadLE16(file);
+
+			//The real tag is the start of the sub format
+			if (tag == WAVE_FORMAT_EXTENSIBLE && size >= 26) {
+				SDL_ReadLE16(file);	//Extension size
+				SDL_ReadLE16(file);	//Valid bits
+				SDL_ReadLE32(file);	//Channel mask
+				tag = SDL_ReadLE16(file);
+			}
+
+			if (tag == WAVE_FORMAT_PCM && bits == 8) format = AUDIO_U8;
+			else if (tag == WAVE_FORMAT_PCM && bits == 16) format = AUDIO_S16LSB;
+			else if (tag == WAVE_FORMAT_PCM && bits == 32) format = AUDIO_S32LSB;
+			else if (tag == WAVE_FORMAT_IEEE_FLOAT && bits == 32) format = AUDIO_F32LSB;
+			//24 bit, compressed, ...
+			else return false;
+
+			if (channels <= 0 || fileRate <= 0 || blockAlign != channels * bits / 8) return false;
+			foundFormat = true;
+		}
+		else if (SDL_memcmp(id, "data", 4) == 0) {
+			dataOffset = SDL_RWtell(file);
+			//Some writers leave the size unset when streaming
+			Sint64 fileSize = SDL_RWsize(file);
+			dataSize = (fileSize > 0 ? SDL_min((Sint64)size, fileSize - dataOffset) : size);
+			dataSize -= dataSize % SDL_max(blockAlign, 1);
+			return foundFormat;
+		}
+
+		if (SDL_RWseek(file, next, RW_SEEK_SET) < 0) return false;
+	}
+	return false;
+}
+
+/*
+* Opens a WAV file
+*
+* @param path, The path to the song
+* @return bool, true if the file can be decoded
+*/
+bool WavDecoder::open(std::string path) {
+	close();
+
+	Uint16 deviceFormat;
+	if (Mix_QuerySpec(&deviceRate, &deviceFormat, &deviceChannels) == 0 || deviceFormat != AUDIO_S16SYS) return false;
+
+	//Reads from the mapping, falling back to SDL's own file reading
+	file = MappedFile::openRW(path);
+	if (file == nullptr)
+		file = SDL_RWFromFile(path.c_str(), "rb");
+	if (file == nullptr) return false;
+
+	SDL_AudioFormat format;
+	int channels;
+	if (!readHeader(format, channels)) {
+		close();
+		return false;
+	}
+
+	stream = SDL_NewAudioStream(format, channels, fileRate, AUDIO_S16SYS, deviceChannels, deviceRate);
+	if (stream == nullptr) {
+		close();
+		return false;
+	}
+
+	rawBlock.resize(RAW_BLOCK_SIZE - RAW_BLOCK_SIZE % blockAlign);
+	return seek(0);
+}
+
+/*
+* Reads frames, converting them to the format of the device
+*
+* @param destination, Filled with the interleaved frames
+* @param maxFrames, The most frames to read
+* @return int, The amount of frames read, 0 at the end of the song
+*/
+int WavDecoder::readFrames(Sint16* destination, int maxFrames) {
+	if (stream == nullptr) return 0;
+
+	int bytesPerFrame = (int)sizeof(Sint16) * deviceChannels;
+	int wanted = maxFrames * bytesPerFrame;
+
+	//Puts raw blocks in until enough has been converted
+	while (SDL_AudioStreamAvailable(stream) < wanted && !flushed) {
+		Sint64 count = SDL_min((Sint64)rawBlock.size(), dataSize - dataRead);
+		size_t read = (count > 0 ? SDL_RWread(file, rawBlock.data(), 1, (size_t)count) : 0);
+		read -= read % blockAlign;
+
+		if (read == 0) {
+			//Pushes out what the converter is holding on to
+			SDL_AudioStreamFlush(stream);
+			flushed = true;
+			break;
+		}
+
+		dataRead += read;
+		SDL_AudioStreamPut(stream, rawBlock.data(), (int)read);
+	}
+
+	int got = SDL_AudioStreamGet(stream, destination, wanted);
+	return (got > 0 ? got / bytesPerFrame : 0);
+}
+
+/*
+* Moves to a frame
+*
+* @param frame, The frame to move to, at the device rate
+* @return bool, true if it moved
+*/
+bool WavDecoder::seek(Sint64 frame) {
+	if (stream == nullptr) return false;
+
+	//The frame in the file at its own rate
+	Sint64 fileFrame = SDL_max(frame, (Sint64)0) * fileRate / deviceRate;
+	dataRead = SDL_min(fileFrame * blockAlign, dataSize);
+	if (SDL_RWseek(file, dataOffset + dataRead, RW_SEEK_SET) < 0) return false;
+
+	SDL_AudioStreamClear(stream);
+	flushed = false;
+	return true;
+}
+
+/*
+* Closes the file
+*/
+void WavDecoder::close() {
+	if (stream != nullptr)
+		SDL_FreeAudioStream(stream);
+	if (file != nullptr)
+		SDL_RWclose(file);
+
+	stream = nullptr;
+	file = nullptr;
+	dataOffset = 0;
+	dataSize = 0;
+	dataRead = 0;
+}
+
+/*
+* Gets the length of the song
+*
+* @return Sint64, The length in frames at the device rate, -1 if nothing is open
+*/
+Sint64 WavDecoder::getLength() const {
+	if (stream == nullptr) return -1;
+	return dataSize / blockAlign * deviceRate / fileRate;
+}
+
+/*
+* Gets the name of the backend
+*
+* @return const char*, The name
+*/
+const char* WavDecoder::getName() const { return "WAV"; }
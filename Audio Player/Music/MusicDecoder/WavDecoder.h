@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+
+#include "Decoder.h"
+
+/*
+* Streams PCM / float WAV files, converting them to the format of the device as they're read
+* Only the blocks being read are touched, so opening and seeking are instant
+*/
+class WavDecoder : public Decoder {
+private:
+	SDL_RWops* file;
+	//Converts the files format to the devices
+	SDL_AudioStream* stream;
+	//Raw blocks read from the file before converting
+	std::vector<Uint8> rawBlock;
+
+	//Where the samples are in the file
+	Sint64 dataOffset;
+	Sint64 dataSize;
+	//The amount of bytes read from the samples
+	Sint64 dataRead;
+
+	//The format of the file
+	int blockAlign;
+	int fileRate;
+	//The format of the device
+	int deviceRate;
+	int deviceChannels;
+
+	//Has the stream been flushed at the end of the samples
+	bool flushed;
+
+	//Reads the format and finds the samples
+	bool readHeader(SDL_AudioFormat& format, int& channels);
+public:
+	//Constructor
+	WavDecoder();
+
+	//Deconstructor
+	~WavDecoder();
+
+	//Opens a WAV file
+	bool open(std::string path) override;
+
+	//Reads and converts frames
+	int readFrames(Sint16* frames, int maxFrames) override;
+
+	//Moves to a frame
+	bool seek(Sint64 frame) override;
+
+	//Closes the file
+	void close() override;
+
+	/// Getters
+
+	//Gets the length of the song in frames
+	Sint64 getLength() const override;
+
+	//Gets the name of the backend
+	const char* getName() const override;
+};
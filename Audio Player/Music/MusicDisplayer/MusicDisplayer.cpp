@@ -8,16 +8,33 @@
 #include "SDL_image.h"
 #include "Globals/Globals.h"
 #include "Globals/Display.h"
+#include "Globals/DrawQueue.h"
+#include "Globals/TextureCache.h"
 #include "Music/MusicPlayer/MusicPlayer.h"
+#include "Music/MusicPlayer/SnippetCache.h"
+#include "Music/MusicPlayer/Speculator.h"
 
 #include <iostream>
 
+//The height of each song in the music list
+#define SONG_HEIGHT 75
+//How long the music list must be still before the songs on screen are decoded (ms)
+#define SNIPPET_SETTLE_MS 300
+//The most songs on screen that are decoded
+#define VISIBLE_SNIPPETS 8
+//How long a row's highlight takes to fade in / out (ms)
+#define HIGHLIGHT_FADE_MS 120
+//The image shown while the music is paused
+#define PLAY_TEXTURE_PATH "Images/playButton.png"
+
 
 //Initializes the Interactable
 void PlayPauseInteractable::init() {
 	setTexture("Images/pauseButton.png");
 	setRenderStyle(RenderStyle::Centered);
-	playTexture = loadTextureFromFile("Images/playButton.png");
+	playTexture = TextureCache::acquire(PLAY_TEXTURE_PATH);
+	//Follows whether the music is paused
+	setUpdates(true);
 }
 
 /*
@@ -59,9 +76,9 @@ void PlayPauseInteractable::clearTexture() {
 	//Clears the texture from the texture interactable
 	TextureInteractable::clearTexture();
 
-	//Deletes the current playTexture
+	//Lets go of the current playTexture
 	if (playTexture != nullptr) {
-		SDL_DestroyTexture(playTexture);
+		TextureCache::release(playTexture);
 		playTexture = nullptr;
 	}
 }
@@ -90,11 +107,6 @@ int PlayPauseInteractable::click(int clickX, int clickY) {
 * Renders the PlayPauseInteractable to the display
 */
 void PlayPauseInteractable::render() {
-
-	//Sets the color
-	SDL_Color color = getPrimaryColor();
-	SDL_SetRenderDrawColor(Display::getRenderer(), color.r, color.g, color.b, color.a);
-
 	//Display the pause texture / play texture depending on the situation
 	if (!paused) {
 		TextureInteractable::render();
@@ -102,12 +114,22 @@ void PlayPauseInteractable::render() {
 		//Gets the rendered area
 		SDL_Rect renderArea = getRect();
 		//Copies the texture to the display
-		SDL_RenderCopy(Display::getRenderer(), playTexture, NULL, &renderArea);
+		DrawQueue::copy(playTexture, NULL, renderArea);
 	}
 	//Revalidates the Interactable as it has been rendered
 	revalidate();
 }
 
+/*
+* Swaps both lost textures for the ones the cache loaded again
+*/
+void PlayPauseInteractable::resetRendering() {
+	TextureInteractable::resetRendering();
+
+	if (playTexture != nullptr)
+		playTexture = TextureCache::getTexture(PLAY_TEXTURE_PATH);
+}
+
 
 
 /*
@@ -121,6 +143,8 @@ void VolumeInteractable::init() {
 
 	//Sets the volume
 	volume = MusicPlayer::getVolume();
+	//Follows the volume
+	setUpdates(true);
 }
 
 /*
@@ -263,12 +287,10 @@ void VolumeInteractable::render() {
 	lineArea.w = getW() * volume;
 
 	//Renders the outline
-	SDL_SetRenderDrawColor(Display::getRenderer(), secondaryColor.r, secondaryColor.g, secondaryColor.b, secondaryColor.a);
-	SDL_RenderFillRect(Display::getRenderer(), &renderArea);
+	DrawQueue::fillRect(renderArea, secondaryColor);
 
 	//Renders the bar
-	SDL_SetRenderDrawColor(Display::getRenderer(), primaryColor.r, primaryColor.g, primaryColor.b, primaryColor.a);
-	SDL_RenderFillRect(Display::getRenderer(), &lineArea);
+	DrawQueue::fillRect(lineArea, primaryColor);
 
 	//Revalidates the Interactable as it has been rendered
 	revalidate();
@@ -349,14 +371,16 @@ int SkipBackwardInteractable::click(int clickX, int clickY) {
 */
 void MusicListInteractable::init() {
 	setPrimaryColor(50, 50, 50, 255);
-	//Defaults the height to 0
-	addHeight = 0;
+
+	snippetScroll = -1;
+	lastScroll = 0;
+	lastScrollTicks = 0;
 }
 
 /*
 * Default constructor for the Music List Interactable
 */
-MusicListInteractable::MusicListInteractable() : ListInteractable() {
+MusicListInteractable::MusicListInteractable() : ListInteractable(), catalog(&arena) {
 	init();
 }
 
@@ -365,6 +389,87 @@ MusicListInteractable::MusicListInteractable() : ListInteractable() {
 */
 MusicListInteractable::~MusicListInteractable() {}
 
+/*
+* Updates the Music List
+*
+* @return int, 0 on success, otherwise an error occured
+*/
+int MusicListInteractable::update() {
+	//Rebinds the rows before the list decides whether to re-render
+	bindVisibleRows();
+
+	int updated = ListInteractable::update();
+
+	//Waits for the scrolling to stop so flicking through the list doesn't decode every song passed
+	if (getScrollDist() != lastScroll) {
+		lastScroll = getScrollDist();
+		lastScrollTicks = SDL_GetTicks();
+	}
+	if (lastScroll != snippetScroll) {
+		Uint32 settled = SDL_GetTicks() - lastScrollTicks;
+		if (settled >= SNIPPET_SETTLE_MS)
+			requestVisibleSnippets();
+		else
+			Display::requestFrame(SNIPPET_SETTLE_MS - settled);
+	}
+
+	return updated;
+}
+
+/*
+* Decodes the start of the songs on screen in the background, so clicking one starts instantly
+*/
+void MusicListInteractable::requestVisibleSnippets() {
+	snippetScroll = getScrollDist();
+
+	//The songs are stacked in the order they were added
+	int first = getScrollDist() / SONG_HEIGHT;
+	int last = SDL_min((getScrollDist() + getH()) / SONG_HEIGHT, first + VISIBLE_SNIPPETS - 1);
+	for (int i = first; i <= last && i < (int)catalog.size(); i++)
+		SnippetCache::request(std::string(catalog[i].path));
+}
+
+/*
+* Grows the pool of rows to cover the list, and binds each row to the song under it
+* Row n always shows a song whose index is n modulo the pool size, so rows that stay on screen while scrolling are left alone
+*/
+void MusicListInteractable::bindVisibleRows() {
+	//One extra for the row cut off at the top, and one at the bottom
+	int rowCount = getH() / SONG_HEIGHT + 2;
+	if ((int)rows.size() < rowCount) {
+		while ((int)rows.size() < rowCount) {
+			SongDisplayInteractable* row = new SongDisplayInteractable();
+
+			//Sets its position
+			row->setX(CordType::Percentage, 0);
+			row->setW(CordType::PercentageWidth, 1);
+			row->setH(CordType::Pixel, SONG_HEIGHT);
+			row->bindToArea(genBindingRect());
+
+			rows.push_back(row);
+			ListInteractable::addInteractable(row);
+		}
+		//The rows map to different songs with a bigger pool
+		rowIndices.assign(rows.size(), -1);
+	}
+
+	int first = getScrollDist() / SONG_HEIGHT;
+	int pool = (int)rows.size();
+	for (int i = first; i < first + pool; i++) {
+		int slot = i % pool;
+		if (rowIndices[slot] == i) continue;
+
+		//Moves the row to the song it now shows
+		rowIndices[slot] = i;
+		rows[slot]->setY(CordType::Pixel, (float)i * SONG_HEIGHT);
+		if (i < (int)catalog.size())
+			rows[slot]->setSong(catalog[i].ID, catalog[i].title);
+		else
+			rows[slot]->clearSong();
+		invalidate();
+	}
+}
+
 /*
 * Overides the parent function to disable directly adding Interactables
 * 
@@ -390,10 +495,15 @@ int MusicListInteractable::addMusic(const std::vector<SongData>* songData) {
 	SDL_assert(songData != nullptr);
 	if (songData == nullptr) return -1;
 
-	//Adds all the songs
-	for (int i = 0; i < songData->size(); i++) {
-		addSong(songData->at(i));
-	}
+	//Adds all the songs, rows are only made for the ones on screen
+	//Reserved up front, as a vector growing in the arena leaves its old buffers behind
+	catalog.reserve(catalog.size() + songData->size());
+	for (const SongData& song : *songData)
+		catalog.push_back({ song.getID(), std::pmr::string(song.getTitle(), &arena), std::pmr::string(song.getPath(), &arena) });
+
+	//The last song can be scrolled to the top
+	setMaxScrollDist(SDL_max((int)catalog.size() - 1, 0) * SONG_HEIGHT);
+	invalidate();
 
 	return 1;
 }
@@ -405,32 +515,30 @@ int MusicListInteractable::addMusic(const std::vector<SongData>* songData) {
 * @param title, The song title
 * @return int, 0 on success, Otherwise there was an error
 */
-int MusicListInteractable::addSong(const SongData data) {
-	//Creates the song
-	SongDisplayInteractable* newSong = new SongDisplayInteractable();
-
-	//Sets its position
-	newSong->setX(CordType::Percentage, 0);
-	newSong->setY(CordType::Pixel, addHeight);
-	newSong->setW(CordType::PercentageWidth, 1);
-	newSong->setH(CordType::Pixel, 75);
+int MusicListInteractable::addSong(const SongData& data) {
+	catalog.push_back({ data.getID(), std::pmr::string(data.getTitle(), &arena), std::pmr::string(data.getPath(), &arena) });
 
-	//Binds the song to the area
-	newSong->bindToArea(genBindingRect());
-
-	//Sets the song
-	newSong->setSong(data);
-
-	//Adds the Interactable to the list
-	ListInteractable::addInteractable(newSong);
-
-	//The new scroll Distance is the addHeight of the song we just added
-	setMaxScrollDist(addHeight);
-	addHeight += newSong->getH();
+	//The new scroll Distance is the height of the song we just added
+	setMaxScrollDist(((int)catalog.size() - 1) * SONG_HEIGHT);
+	invalidate();
 
 	return 0;
 }
 
+/*
+* Gets the amount of songs in the list
+*
+* @return int, The amount of songs
+*/
+int MusicListInteractable::getSongCount() const { return (int)catalog.size(); }
+
+/*
+* Gets the amount of rows that exist to show the songs, stays the same however many songs there are
+*
+* @return int, The amount of rows
+*/
+int MusicListInteractable::getRowCount() const { return (int)rows.size(); }
+
 /*
 * Renders the Music List
 */
@@ -445,9 +553,18 @@ void SongDisplayInteractable::init() {
 	//Sets the default color
 	setPrimaryColor(0, 0, 0, 0);
 	setTextColor(255, 255, 255, 255);
+	//Lightens the row while the mouse is over it
+	setSecondaryColor(255, 255, 255, 40);
 	//Defaults to an invalid song
+	songID = -1;
 	validSong = false;
 	beingPlayed = false;
+	hovered = false;
+	hoverStartTicks = 0;
+	speculated = false;
+	highlight.set(0);
+	//Follows the song playing
+	setUpdates(true);
 }
 
 /*
@@ -474,7 +591,7 @@ int SongDisplayInteractable::update() {
 	int playingSongID = MusicPlayer::getPlayingSongID();
 
 	//If the song's being played, re-render
-	bool playing = songData.getID() == playingSongID;
+	bool playing = songID == playingSongID;
 
 	//If the song's playing state switched
 	if (getBeingPlayed() != playing) {
@@ -496,14 +613,24 @@ int SongDisplayInteractable::update() {
 /*
 * Sets the song to display
 *
-* @param song, The song's data
+* @param songID, The song's ID
+* @param title, The song's title
 * @return int, 0 on success, otherwise an error occured
 */
-int SongDisplayInteractable::setSong(SongData song) {
-	//Sets the songData
-	songData = song;
+int SongDisplayInteractable::setSong(int songID, std::string_view title) {
+	//A recycled row is no longer over the song it was hovering
+	if (hovered && speculated)
+		Speculator::cancel(this->songID);
+	if (hovered)
+		invalidate();
+	hovered = false;
+	//A recycled row starts unlit
+	highlight.set(0);
+
+	//Sets the song
+	this->songID = songID;
 	//Checks that the text changed
-	bool worked = TextInteractable::setText(songData.getTitle());
+	bool worked = TextInteractable::setText(title);
 	//Ensures that it is a valid song
 	validSong = true;
 
@@ -518,6 +645,20 @@ int SongDisplayInteractable::setSong(SongData song) {
 */
 bool SongDisplayInteractable::hasValidSong() const { return validSong; }
 
+/*
+* Stops displaying a song, the row is hidden until it's given another
+*/
+void SongDisplayInteractable::clearSong() {
+	if (hovered && speculated)
+		Speculator::cancel(songID);
+	hovered = false;
+	highlight.set(0);
+
+	validSong = false;
+	songID = -1;
+	invalidate();
+}
+
 
 /*
 * Checks if the Song Display is being played
@@ -527,6 +668,13 @@ bool SongDisplayInteractable::hasValidSong() const { return validSong; }
 */
 bool SongDisplayInteractable::getBeingPlayed() const { return beingPlayed; }
 
+/*
+* Gets the ID of the displayed song
+*
+* @return int, The song's ID
+*/
+int SongDisplayInteractable::getSongID() const { return songID; }
+
 /*
 * Clicks on the Song Display
 * 
@@ -540,8 +688,67 @@ int SongDisplayInteractable::click(int clickX, int clickY) {
 
 	//Checks that the position overlaps
 	if (getPositionOverlap(clickX, clickY)) {
-		MusicPlayer::playSongSave(songData.getID());
+		//Shift click queues the song instead
+		if (SDL_GetModState() & KMOD_SHIFT)
+			MusicPlayer::enqueueSong(songID);
+		else if (MusicPlayer::playSongSave(songID))
+			Speculator::recordClick(songID);
+	}
+	return 0;
+}
+
+/*
+* Opens the song in the background once the mouse has rested on it, so a click starts it straight away
+* The speculation is cancelled when the mouse leaves
+*
+* @param hoverX, The Mouse's X position
+* @param hoverY, The Mouse's Y position
+* @return int, 0 on success, otherwise an error occured
+*/
+int SongDisplayInteractable::mouseHover(int hoverX, int hoverY) {
+	bool overlapping = hasValidSong() && getPositionOverlap(hoverX, hoverY);
+
+	//The mouse just arrived
+	if (overlapping && !hovered) {
+		hovered = true;
+		hoverStartTicks = SDL_GetTicks();
+		speculated = false;
+		//Fades the highlight in
+		highlight.start(1, HIGHLIGHT_FADE_MS);
+		Animation::start(this);
+	}
+	//The mouse just left
+	else if (!overlapping && hovered) {
+		hovered = false;
+		if (speculated)
+			Speculator::cancel(songID);
+		highlight.start(0, HIGHLIGHT_FADE_MS);
+		Animation::start(this);
 	}
+
+	//Speculates once the mouse has dwelled long enough, waking the main loop when it will have
+	if (hovered && !speculated) {
+		Uint32 dwelled = SDL_GetTicks() - hoverStartTicks;
+		if (dwelled >= Speculator::getDwell())
+			speculated = Speculator::speculate(songID);
+		else
+			Display::requestFrame(Speculator::getDwell() - dwelled);
+	}
+
+	return 0;
+}
+
+
+/*
+* Fades the highlight by one step, re-rendering the row
+*
+* @param seconds, The length of the step
+* @return bool, true while the highlight is still fading
+*/
+bool SongDisplayInteractable::step(float seconds) {
+	bool fading = highlight.step(seconds);
+	invalidate();
+	return fading;
 }
 
 
@@ -549,6 +756,21 @@ int SongDisplayInteractable::click(int clickX, int clickY) {
 * Renders the Song Display Interactable
 */
 void SongDisplayInteractable::render() {
+	//Rows past the end of the list are left empty
+	if (!hasValidSong()) {
+		revalidate();
+		return;
+	}
+
 	Interactable::render();
+
+	//Highlights the row the mouse is over
+	if (highlight.getValue() > 0) {
+		SDL_Rect renderArea = getRect();
+		SDL_Color color = getSecondaryColor();
+		color.a = (Uint8)(color.a * highlight.getValue());
+		DrawQueue::fillRect(renderArea, color);
+	}
+
 	TextInteractable::render();
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 
 #include <future>
+#include <memory_resource>
+#include <string_view>
 #include "Interactables/Interactables.h"
 #include "Interactables/ListInteractables.h"
 #include "Music/MusicPlayer/MusicPlayer.h"
@@ -44,6 +46,9 @@ public:
 
 	//Renders the PlayPauseInteractable to the display
 	void render();
+
+	//Swaps both lost textures for the ones the cache loaded again
+	void resetRendering();
 };
 
 /*
@@ -121,16 +126,47 @@ public:
 };
 
 
+class SongDisplayInteractable;
+
+/*
+* A song in the music list, its strings kept in the list's arena
+*/
+struct ListedSong {
+	int ID;
+	std::pmr::string title;
+	std::pmr::string path;
+};
+
 /*
 * Adds music to the music list
+* Only the rows on screen exist, a small pool of rows is recycled as the list scrolls
+* The catalog is built in an arena, so a list of any size is a few large allocations, freed at once with the list
 */
 class MusicListInteractable : public ListInteractable {
 private:
-	//The Height to add the next Song at
-	int addHeight;
+	//Holds the catalog and its strings
+	std::pmr::monotonic_buffer_resource arena;
+	//Every song in the list, in order
+	std::pmr::vector<ListedSong> catalog;
+
+	//The recycled rows, and the index in the catalog each is showing (-1 for none)
+	std::vector<SongDisplayInteractable*> rows;
+	std::vector<int> rowIndices;
+
+	//The scroll distance snippets were last requested at
+	int snippetScroll;
+	//The scroll distance last frame, and when it last changed
+	int lastScroll;
+	Uint32 lastScrollTicks;
 
 	//Initializes the Music List
 	void init();
+
+	//Decodes the start of the songs on screen, once the list stops scrolling
+	void requestVisibleSnippets();
+
+	//Grows the pool to cover the list, and binds each row to the song it's over
+	void bindVisibleRows();
 public:
 	//Default Constructor
 	MusicListInteractable();
@@ -138,6 +174,9 @@ public:
 	//Deconstructor
 	~MusicListInteractable();
 
+	//Updates the Music List
+	int update() override;
+
 	/// Adding to the list
 
 	//Overides the parent function to disable directly adding Interactables
@@ -147,7 +186,15 @@ public:
 	int addMusic(const std::vector<SongData>* songData);
 
 	//Adds one song based off the path and title
-	int addSong(const SongData data);
+	int addSong(const SongData& data);
+
+	/// Getters
+
+	//Gets the amount of songs in the list
+	int getSongCount() const;
+
+	//Gets the amount of rows that exist to show them
+	int getRowCount() const;
 
 	//Renders the Music List
 	void render();
@@ -157,7 +204,7 @@ public:
 /*
 * Displays a single song
 */
-class SongDisplayInteractable : public TextInteractable {
+class SongDisplayInteractable : public TextInteractable, public Animated {
 private:
 	//Is this a valid song?
 	bool validSong;
@@ -165,8 +212,16 @@ private:
 	//Is this being played
 	bool beingPlayed;
 
-	//Holds the songs data
-	SongData songData;
+	//Is the mouse resting on this, and since when
+	bool hovered;
+	Uint32 hoverStartTicks;
+	//Has the song been opened speculatively for this hover
+	bool speculated;
+	//How strongly the row is highlighted, fades in and out with the hover (0 - 1)
+	Tween highlight;
+
+	//The ID of the song shown, -1 for none
+	int songID;
 
 	//Initializes the Song Display Interactable
 	void init();
@@ -184,7 +239,10 @@ public:
 	/// Setters
 
 	//Sets the song to display
-	int setSong(SongData);
+	int setSong(int songID, std::string_view title);
+
+	//Stops displaying a song
+	void clearSong();
 
 	/// Getters
 
@@ -194,11 +252,22 @@ public:
 	//Checks if the Song Display is being played
 	bool getBeingPlayed() const;
 
+	//Gets the ID of the displayed song
+	int getSongID() const;
+
 	/// Interactivity
 	
 	//Plays the saved song on click
 	int click(int, int);
 
+	//Opens the song in the background once the mouse has rested on it
+	int mouseHover(int, int) override;
+
+	/// Animating
+
+	//Fades the highlight by one step
+	bool step(float seconds) override;
+
 	/// Rendering
 
 	//Renders the Song Display Interactable
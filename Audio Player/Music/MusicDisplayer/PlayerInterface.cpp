@@ -0,0 +1,124 @@
+#include "PlayerInterface.h"
+
+#include "Interactables/ListInteractables.h"
+#include "Music/MusicDisplayer/MusicDisplayer.h"
+#include "Instrumentation/DebugOverlay.h"
+#include "Instrumentation/FrameProfiler.h"
+
+
+/*
+* Builds the player's UI
+* NOTE: The display, fonts and text renderer have to be initialized first
+*
+* @param songs, The songs shown in the music list
+* @return InteractableManager*, The manager holding the UI, deleted by the caller
+*/
+InteractableManager* PlayerInterface::build(const std::vector<SongData>* songs) {
+	//The interactable manager
+	InteractableManager* interactableManager = new InteractableManager();
+
+	/// Bottom Audio Controls Container
+
+	ContainerInteractable* container = new ContainerInteractable();
+
+	//Sets the Color
+	container->setPrimaryColor(50, 50, 50, 255);
+	container->setX(CordType::PercentageWidth, 0.5f);
+	container->setY(CordType::PixelFromBottomEdge, 75);
+	container->setW(CordType::Pixel, 400);
+	container->setH(CordType::Pixel, 125);
+	//Centers the Container
+	container->setRenderStyle(RenderStyle::Centered);
+
+	interactableManager->addInteractable(container);
+
+	///Play / Pause button   
+
+	//Makes the pauseButton
+	PlayPauseInteractable* pauseButton = new PlayPauseInteractable();
+
+	//Sets the position of the pauseButton
+	pauseButton->setX(CordType::PercentageWidth, 0.5);
+	pauseButton->setY(CordType::Pixel, 40);
+	pauseButton->setW(CordType::Pixel, 50);
+	pauseButton->setH(CordType::Pixel, 50);
+
+	container->addInteractable(pauseButton);
+
+	/// Skip forward button
+
+	SkipForwardInteractable* skipForwardButton = new SkipForwardInteractable();
+
+	//Sets the position of the Skip forward
+	skipForwardButton->setX(CordType::PercentageWidth, 0.75);
+	skipForwardButton->setY(CordType::Pixel, 40);
+	skipForwardButton->setW(CordType::Pixel, 50);
+	skipForwardButton->setH(CordType::Pixel, 50);
+
+	container->addInteractable(skipForwardButton);
+
+	/// Skip backward button
+
+	SkipBackwardInteractable* skipBackwardButton = new SkipBackwardInteractable();
+
+	//Sets the position of the Skip forward
+	skipBackwardButton->setX(CordType::PercentageWidth, 0.25);
+	skipBackwardButton->setY(CordType::Pixel, 40);
+	skipBackwardButton->setW(CordType::Pixel, 50);
+	skipBackwardButton->setH(CordType::Pixel, 50);
+
+	container->addInteractable(skipBackwardButton);
+
+	/// Volume Interactable
+
+	//Makes the Volume interactable
+	VolumeInteractable* volume = new VolumeInteractable();
+
+	//Sets the position of the volume
+	volume->setX(CordType::PercentageWidth, 0.5);
+	volume->setY(CordType::Pixel, 100);
+	volume->setW(CordType::Pixel, 300);
+	volume->setH(CordType::Pixel, 40);
+	//Centers the volume
+	volume->setRenderStyle(RenderStyle::Centered);
+
+	container->addInteractable(volume);
+
+	/// Music List
+
+	MusicListInteractable* musicList = new MusicListInteractable();
+
+	musicList->setX(CordType::PercentageWidth, 0);
+	musicList->setY(CordType::PercentageHeight, 0);
+	musicList->setW(CordType::PercentageWidth, 1);
+	musicList->setH(CordType::PixelFromBottomEdge, 150);
+
+	musicList->setRenderStyle(RenderStyle::None);
+	musicList->addMusic(songs);
+
+	interactableManager->addInteractable(musicList);
+
+	/// Debug Overlay (Toggled with F3)
+
+	DebugOverlayInteractable* debugOverlay = new DebugOverlayInteractable();
+
+	debugOverlay->setX(CordType::Pixel, 5);
+	debugOverlay->setY(CordType::Pixel, 5);
+	debugOverlay->setW(CordType::Pixel, 1);
+	debugOverlay->setH(CordType::Pixel, 1);
+
+	//Added last so it's rendered on top
+	interactableManager->addInteractable(debugOverlay);
+
+	/// Profiler Overlay (Toggled with F4)
+
+	ProfilerOverlayInteractable* profilerOverlay = new ProfilerOverlayInteractable();
+
+	profilerOverlay->setY(CordType::Pixel, 5);
+	profilerOverlay->setW(CordType::Pixel, 1);
+	profilerOverlay->setH(CordType::Pixel, 1);
+
+	interactableManager->addInteractable(profilerOverlay);
+
+	return interactableManager;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <vector>
+
+#include "Interactables/Interactables.h"
+#include "Music/MusicLoader/MusicLoader.h"
+
+/*
+* Builds the player's UI, the audio controls along the bottom with the music list above them
+* The player and the UI benchmark build the same tree from here
+*/
+namespace PlayerInterface {
+	//Builds the player's UI listing the songs given, the caller owns the manager
+	InteractableManager* build(const std::vector<SongData>* songs);
+};
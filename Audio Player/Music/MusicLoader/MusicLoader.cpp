@@ -31,6 +31,9 @@ SongData::SongData() {
 	title = "";
 	path = "";
 	ID = -1;
+	soundStartMs = -1;
+	soundEndMs = -1;
+	lengthMs = -1;
 }
 
 /*
@@ -40,7 +43,7 @@ SongData::SongData() {
 * @param path, The path of the song
 */
 SongData::SongData(std::string title, std::string path) 
-	: title(title), path(path), ID(IDgenerator++) {}
+	: title(title), path(path), ID(IDgenerator++), soundStartMs(-1), soundEndMs(-1), lengthMs(-1) {}
 
 /*
 * Deconstructor
@@ -57,6 +60,9 @@ SongData& SongData::operator= (const SongData& other) {
 	title = other.getTitle();
 	path = other.getPath();
 	ID = other.getID();
+	soundStartMs = other.getSoundStart();
+	soundEndMs = other.getSoundEnd();
+	lengthMs = other.getLength();
 
 	return *this;
 }
@@ -66,14 +72,14 @@ SongData& SongData::operator= (const SongData& other) {
 * 
 * @return string, The title
 */
-std::string SongData::getTitle() const { return title; }
+const std::string& SongData::getTitle() const { return title; }
 
 /*
 * Gets the path from the Song
 *
 * @return string, The path
 */
-std::string SongData::getPath() const { return path; }
+const std::string& SongData::getPath() const { return path; }
 
 
 /*
@@ -91,6 +97,53 @@ int SongData::getID() const { return ID; }
 */
 bool SongData::getValid() const { return ID != -1; }
 
+/*
+* Starts the IDs from 0 again, once the songs they index are gone
+*/
+void SongData::resetIDs() { IDgenerator = 0; }
+
+/*
+* Sets where the sound starts / ends, found by the SilenceAnalyzer
+*
+* @param startMs, Where the sound starts
+* @param endMs, Where the sound ends
+* @param length, The length of the song
+*/
+void SongData::setSoundBounds(int startMs, int endMs, int length) {
+	soundStartMs = startMs;
+	soundEndMs = endMs;
+	lengthMs = length;
+}
+
+/*
+* Gets where the sound starts
+*
+* @return int, The start in ms, -1 until analyzed
+*/
+int SongData::getSoundStart() const { return soundStartMs; }
+
+/*
+* Gets where the sound ends
+*
+* @return int, The end in ms, -1 until analyzed
+*/
+int SongData::getSoundEnd() const { return soundEndMs; }
+
+/*
+* Gets the length of the song
+*
+* @return int, The length in ms, -1 until analyzed
+*/
+int SongData::getLength() const { return lengthMs; }
+
+/*
+* Checks if the silence in the song has been found
+*
+* @return true, The sound bounds are set
+* @return false, The song hasn't been analyzed
+*/
+bool SongData::getAnalyzed() const { return lengthMs != -1; }
+
 /*
 * Initializes the musicLoader
 * 
@@ -129,6 +182,9 @@ void MusicLoader::close() {
 		songTitles = nullptr;
 		songPaths = nullptr;
 		songDatas = nullptr;
+
+		//The IDs index the songs, so a new list starts them over
+		SongData::resetIDs();
 	}
 }
 
@@ -296,7 +352,7 @@ int MusicLoader::getSongIDFromPath(std::string path) {
 	int ID = -1;
 
 	//Loops until it finds the songs ID
-	for (SongData sd : *songDatas) {
+	for (const SongData& sd : *songDatas) {
 		if (path == sd.getPath())
 			ID = sd.getID();
 	}
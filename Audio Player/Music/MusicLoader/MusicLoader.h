@@ -10,6 +10,7 @@
 *	Title
 *	Path
 *	ID
+*	Where its sound starts / ends (once analyzed)
 */
 class SongData {
 private:
@@ -20,6 +21,10 @@ private:
 	std::string path;
 	//ID of the song
 	int ID;
+	//Where the sound starts / ends, and the length of the song (ms), -1 until analyzed
+	int soundStartMs;
+	int soundEndMs;
+	int lengthMs;
 
 public:
 	//Default Constructor
@@ -35,10 +40,10 @@ public:
 	SongData& operator= (const SongData& other);
 
 	//Gets the title of the song
-	std::string getTitle() const;
+	const std::string& getTitle() const;
 
 	//Gets the path to the song
-	std::string getPath() const;
+	const std::string& getPath() const;
 
 	//Gets the ID of the song
 	int getID() const;
@@ -46,6 +51,24 @@ public:
 	//Checks if the SongData is valid
 	bool getValid() const;
 
+	//Starts the IDs from 0 again, once the songs they index are gone
+	static void resetIDs();
+
+	//Sets where the sound starts / ends, skipping the silence around it
+	void setSoundBounds(int startMs, int endMs, int lengthMs);
+
+	//Gets where the sound starts (ms), -1 until analyzed
+	int getSoundStart() const;
+
+	//Gets where the sound ends (ms), -1 until analyzed
+	int getSoundEnd() const;
+
+	//Gets the length of the song (ms), -1 until analyzed
+	int getLength() const;
+
+	//Checks if the silence in the song has been found
+	bool getAnalyzed() const;
+
 };
 
 /*
@@ -0,0 +1,109 @@
+#include "AudioEvents.h"
+
+#include <atomic>
+
+//The amount of events the queue holds, must be a power of two
+#define QUEUE_SIZE 256
+
+/*
+* A slot in the queue
+* The sequence tells producers and the consumer whose turn it is to use the slot
+*/
+struct EventSlot {
+	std::atomic<Uint32> sequence;
+	AudioEvent event;
+};
+
+/*
+* Builds the slots with their starting sequence
+*/
+struct EventQueue {
+	EventSlot slots[QUEUE_SIZE];
+
+	EventQueue() {
+		for (Uint32 i = 0; i < QUEUE_SIZE; i++)
+			slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+};
+
+static EventQueue queue;
+
+//Claimed by producers with a compare and swap
+static std::atomic<Uint32> enqueuePosition(0);
+//Only the main thread consumes
+static Uint32 dequeuePosition = 0;
+
+static std::atomic<Uint32> dropped(0);
+
+
+/*
+* Posts an event to the main loop
+* NOTE: Lock-free, safe to call from the audio thread
+*
+* @param type, The type of event
+* @param trackSerial, The serial of the track the event is about
+* @param value, Depends on the type of event
+* @return bool, true if the event was queued, false if the queue was full
+*/
+bool AudioEvents::post(AudioEventType type, int trackSerial, Sint64 value) {
+	EventSlot* slot;
+	Uint32 position = enqueuePosition.load(std::memory_order_relaxed);
+
+	while (true) {
+		slot = &queue.slots[position & (QUEUE_SIZE - 1)];
+		Uint32 sequence = slot->sequence.load(std::memory_order_acquire);
+		Sint32 difference = (Sint32)(sequence - position);
+
+		//The slot is free, try to claim it
+		if (difference == 0) {
+			if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				break;
+		}
+		//The slot still holds an event the main loop hasn't taken, the queue is full
+		else if (difference < 0) {
+			dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		//Another producer claimed it first
+		else {
+			position = enqueuePosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	slot->event.type = type;
+	slot->event.trackSerial = trackSerial;
+	slot->event.value = value;
+
+	//Publishes the event to the consumer
+	slot->sequence.store(position + 1, std::memory_order_release);
+	return true;
+}
+
+/*
+* Takes the oldest event off the queue
+* NOTE: Main thread only
+*
+* @param event, Filled with the event
+* @return bool, true if there was an event
+*/
+bool AudioEvents::poll(AudioEvent& event) {
+	EventSlot* slot = &queue.slots[dequeuePosition & (QUEUE_SIZE - 1)];
+	Uint32 sequence = slot->sequence.load(std::memory_order_acquire);
+
+	//The next event hasn't been published yet
+	if ((Sint32)(sequence - (dequeuePosition + 1)) < 0) return false;
+
+	event = slot->event;
+
+	//Hands the slot back to the producers for the next lap around the queue
+	slot->sequence.store(dequeuePosition + QUEUE_SIZE, std::memory_order_release);
+	dequeuePosition++;
+	return true;
+}
+
+/*
+* Gets the amount of events dropped because the queue was full
+*
+* @return Uint32, The amount of dropped events
+*/
+Uint32 AudioEvents::getDropped() { return dropped.load(std::memory_order_relaxed); }
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "SDL.h"
+
+/*
+* The kinds of notifications the audio thread sends to the main loop
+*/
+enum class AudioEventType {
+	None,
+	//A track stopped playing (value unused)
+	TrackFinished,
+	//A callback arrived too late to keep the device fed (value is the interval in us)
+	Underrun,
+	//The playback position of a track moved (value is the position in ms)
+	PositionTick,
+};
+
+/*
+* A notification from the audio thread
+* Plain data so it can be copied into the queue without allocating
+*/
+struct AudioEvent {
+	AudioEventType type;
+	//The serial of the track the event is about
+	int trackSerial;
+	//Depends on the type of event
+	Sint64 value;
+};
+
+/*
+* A lock-free queue carrying events from the audio thread (or any other thread) to the main loop
+* Posting never blocks or allocates, if the queue is full the event is dropped
+*/
+namespace AudioEvents {
+	//Posts an event, safe to call from any thread
+	bool post(AudioEventType type, int trackSerial, Sint64 value);
+
+	//Takes the oldest event off the queue, main thread only
+	bool poll(AudioEvent& event);
+
+	//Gets the amount of events dropped because the queue was full
+	Uint32 getDropped();
+};
@@ -0,0 +1,480 @@
+#include "AudioPipeline.h"
+#include "AudioStats.h"
+#include "TimeStretcher.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "SDL_assert.h"
+
+//The most frames processed in one go, the callback is split into blocks of this size
+#define BLOCK_FRAMES 2048
+//The frames the feeder decodes in one go
+#define FEED_FRAMES 4096
+//The length of the ring the feeder decodes ahead into (ms)
+#define RING_MS 1000
+//How long the feeder sleeps when the ring is full (ms)
+#define FEED_WAIT_MS 5
+
+static bool pipelineLoaded = false;
+
+//The format of the opened device
+static int frequency = 44100;
+static int channels = 2;
+static int bytesPerFrame = 4;
+
+//The stages of the pipeline
+static TimeStretcher* stretcher = nullptr;
+
+//Scratch buffers, allocated up front so the audio thread never allocates
+static std::vector<float> stretchInput;
+static std::vector<float> stretchOutput;
+static std::vector<Sint16> pcmInput;
+static std::vector<Sint16> pcmOutput;
+
+//The decoder being played, only changed while unhooked and holding the mutex
+static std::mutex decoderMutex;
+static Decoder* source = nullptr;
+static std::atomic<bool> sourceEnded(true);	//The decoder has nothing left to give
+static Sint64 playFrame = 0;	//Audio thread only while hooked
+
+//Decoded frames, written by the feeder and read by the audio thread
+static std::vector<Sint16> ring;
+static int ringFrames = 0;
+//The total frames written / read, the ring holds the difference
+static std::atomic<Sint64> ringWritten(0);
+static std::atomic<Sint64> ringRead(0);
+
+//The thread keeping the ring full
+static std::thread feeder;
+static std::atomic<bool> feeding(false);
+static std::condition_variable feederWake;
+
+//Read by the audio thread every callback
+static std::atomic<float> targetSpeed(1);
+static std::atomic<float> targetPitch(1);
+static std::atomic<bool> paused(false);
+static std::atomic<int> volume(MIX_MAX_VOLUME);
+
+//Written by the audio thread
+static std::atomic<Sint64> sourcePosition(-1);
+static std::atomic<bool> finished(false);
+static std::atomic<Uint32> starvations(0);
+
+static void (SDLCALL *finishedHook)() = nullptr;
+
+
+/*
+* Keeps the ring full from the playing decoder
+* NOTE: Feeder thread only
+*/
+static void feedPipeline() {
+	std::vector<Sint16> block((size_t)FEED_FRAMES * channels);
+
+	std::unique_lock<std::mutex> lock(decoderMutex);
+	while (feeding) {
+		bool fed = false;
+
+		Sint64 written = ringWritten.load(std::memory_order_relaxed);
+		int space = ringFrames - (int)(written - ringRead.load(std::memory_order_acquire));
+		//Decoders still catching up are left until they're ready
+		if (source != nullptr && !sourceEnded && space >= FEED_FRAMES && source->getReady()) {
+			int got = source->readFrames(block.data(), FEED_FRAMES);
+
+			if (got <= 0) {
+				sourceEnded.store(true, std::memory_order_release);
+			}
+			else {
+				//Copies in, wrapping around the end of the ring
+				int start = (int)(written % ringFrames);
+				int first = SDL_min(got, ringFrames - start);
+				SDL_memcpy(ring.data() + (size_t)start * channels, block.data(), (size_t)first * bytesPerFrame);
+				SDL_memcpy(ring.data(), block.data() + (size_t)first * channels, (size_t)(got - first) * bytesPerFrame);
+				ringWritten.store(written + got, std::memory_order_release);
+				fed = true;
+			}
+		}
+
+		//Sleeps until there's room, or the source changes
+		if (!fed)
+			feederWake.wait_for(lock, std::chrono::milliseconds(FEED_WAIT_MS));
+	}
+}
+
+/*
+* Empties the ring, for a new source / position
+* NOTE: Only while unhooked and holding the decoder mutex
+*/
+static void clearRing() {
+	ringWritten = 0;
+	ringRead = 0;
+}
+
+/*
+* Reads decoded frames out of the ring
+* NOTE: Audio thread only
+*
+* @param samples, Filled with the interleaved frames
+* @param frameCount, The most frames to read
+* @return int, The amount of frames read, less than wanted when the ring runs dry
+*/
+static int readRing(Sint16* samples, int frameCount) {
+	Sint64 read = ringRead.load(std::memory_order_relaxed);
+	int available = (int)(ringWritten.load(std::memory_order_acquire) - read);
+	int count = SDL_min(frameCount, available);
+
+	//Copies out, wrapping around the end of the ring
+	int start = (int)(read % ringFrames);
+	int first = SDL_min(count, ringFrames - start);
+	SDL_memcpy(samples, ring.data() + (size_t)start * channels, (size_t)first * bytesPerFrame);
+	SDL_memcpy(samples + (size_t)first * channels, ring.data(), (size_t)(count - first) * bytesPerFrame);
+
+	ringRead.store(read + count, std::memory_order_release);
+	playFrame += count;
+	return count;
+}
+
+/*
+* Converts 16 bit samples to floats (-1 - 1)
+*
+* @param samples, The samples to convert
+* @param floats, Filled with the converted samples
+* @param count, The amount of samples
+*/
+static void samplesToFloats(const Sint16* samples, float* floats, int count) {
+	for (int i = 0; i < count; i++)
+		floats[i] = samples[i] * (1.0f / 32768.0f);
+}
+
+/*
+* Converts floats (-1 - 1) to 16 bit samples, clipping anything out of range
+*
+* @param floats, The floats to convert
+* @param samples, Filled with the converted samples
+* @param count, The amount of samples
+*/
+static void floatsToSamples(const float* floats, Sint16* samples, int count) {
+	for (int i = 0; i < count; i++) {
+		float sample = floats[i] * 32768.0f;
+		samples[i] = (Sint16)SDL_min(SDL_max(sample, -32768.0f), 32767.0f);
+	}
+}
+
+/*
+* Stretches the next block of the source
+* NOTE: Audio thread only
+*
+* @param frameCount, The amount of frames wanted
+* @return int, The amount of frames stretched into pcmOutput, less than wanted when the source runs out
+*/
+static int stretchBlock(int frameCount) {
+	//Feeds the stretcher until it can fill the block
+	while (stretcher->getOutputFrames() < frameCount) {
+		int count = readRing(pcmInput.data(), SDL_min(stretcher->getInputSpace(), BLOCK_FRAMES));
+		if (count <= 0) break;
+
+		samplesToFloats(pcmInput.data(), stretchInput.data(), count * channels);
+		stretcher->putSamples(stretchInput.data(), count);
+	}
+
+	int received = stretcher->receiveSamples(stretchOutput.data(), frameCount);
+	floatsToSamples(stretchOutput.data(), pcmOutput.data(), received * channels);
+	return received;
+}
+
+/*
+* Mixes the pipeline into the stream, replaces SDL_mixer's music mixer
+* NOTE: Audio thread only
+*
+* @param stream, The stream to mix into
+* @param len, The length of the stream in bytes
+*/
+static void SDLCALL mixPipeline(void*, Uint8* stream, int len) {
+	AudioStats::callbackBegin();
+	if (source == nullptr || finished.load(std::memory_order_relaxed) || paused.load(std::memory_order_relaxed))
+		return;
+
+	//Picks up rate changes
+	float speed = targetSpeed.load(std::memory_order_relaxed);
+	float pitch = targetPitch.load(std::memory_order_relaxed);
+	if (speed != stretcher->getSpeed() || pitch != stretcher->getPitch())
+		stretcher->setRate(speed, pitch);
+
+	int mixVolume = volume.load(std::memory_order_relaxed);
+	int frames = len / bytesPerFrame;
+	int done = 0;
+
+	while (done < frames) {
+		int block = SDL_min(frames - done, BLOCK_FRAMES);
+		int got = 0;
+		Uint8* destination = stream + done * bytesPerFrame;
+
+		//Unchanged audio skips the stretcher, once it has played out what it was holding
+		if (speed == 1 && pitch == 1 && stretcher->getOutputFrames() == 0) {
+			stretcher->clear();
+			got = readRing(pcmOutput.data(), block);
+		}
+		else {
+			got = stretchBlock(block);
+		}
+		SDL_MixAudioFormat(destination, (const Uint8*)pcmOutput.data(), AUDIO_S16SYS, got * bytesPerFrame, mixVolume);
+
+		done += got;
+
+		if (got < block) {
+			//Checked before the ring, as the feeder fills the ring before marking the end
+			bool ended = sourceEnded.load(std::memory_order_acquire);
+			bool empty = (ringWritten.load(std::memory_order_acquire) == ringRead.load(std::memory_order_relaxed));
+
+			//The source ran out
+			if (ended && empty && stretcher->getOutputFrames() == 0) {
+				finished = true;
+				if (finishedHook != nullptr)
+					finishedHook();
+			}
+			//The feeder fell behind, the rest of the callback stays silent
+			else {
+				starvations.fetch_add(1, std::memory_order_relaxed);
+			}
+			break;
+		}
+	}
+
+	sourcePosition.store(playFrame, std::memory_order_relaxed);
+}
+
+
+/*
+* Sets up the pipeline for the opened audio device
+* NOTE: Mix_OpenAudio must have been called
+*
+* @return bool, true if the pipeline was set up
+*/
+bool AudioPipeline::init() {
+	SDL_assert(!loaded());
+	if (loaded()) return true;
+
+	Uint16 format;
+	if (Mix_QuerySpec(&frequency, &format, &channels) == 0) {
+		std::cout << "AudioPipeline: Audio is not open " << Mix_GetError() << std::endl;
+		return false;
+	}
+
+	//The stages work on 16 bit samples
+	if (format != AUDIO_S16SYS) {
+		std::cout << "AudioPipeline: Unsupported audio format " << format << std::endl;
+		return false;
+	}
+	bytesPerFrame = (int)sizeof(Sint16) * channels;
+
+	stretcher = new TimeStretcher(channels, frequency);
+	stretchInput.resize((size_t)BLOCK_FRAMES * channels);
+	stretchOutput.resize((size_t)BLOCK_FRAMES * channels);
+	pcmInput.resize((size_t)BLOCK_FRAMES * channels);
+	pcmOutput.resize((size_t)BLOCK_FRAMES * channels);
+
+	ringFrames = SDL_max(frequency * RING_MS / 1000, FEED_FRAMES * 2);
+	ring.resize((size_t)ringFrames * channels);
+
+	//Decodes ahead of the audio thread
+	feeding = true;
+	feeder = std::thread(feedPipeline);
+
+	pipelineLoaded = true;
+	return pipelineLoaded;
+}
+
+/*
+* Stops the pipeline
+*/
+void AudioPipeline::close() {
+	SDL_assert(loaded());
+	if (!loaded()) return;
+
+	stop();
+
+	//Stops the feeder
+	{
+		std::lock_guard<std::mutex> lock(decoderMutex);
+		feeding = false;
+	}
+	feederWake.notify_one();
+	feeder.join();
+
+	delete stretcher;
+	stretcher = nullptr;
+	pipelineLoaded = false;
+}
+
+/*
+* Checks if the pipeline is set up
+*
+* @return bool, true if the pipeline is set up
+*/
+bool AudioPipeline::loaded() { return pipelineLoaded; }
+
+
+/*
+* Plays an opened decoder, taking ownership of it
+* The decoder must give frames in the format of the opened device
+*
+* @param decoder, The opened decoder
+* @param startFrame, The frame to start playing from
+* @return bool, true if the decoder is playing
+*/
+bool AudioPipeline::play(Decoder* decoder, Sint64 startFrame) {
+	SDL_assert(loaded() && decoder != nullptr);
+	if (!loaded() || decoder == nullptr) return false;
+
+	stop();
+
+	//Unhooked, so the audio thread can't see the source change
+	{
+		std::lock_guard<std::mutex> lock(decoderMutex);
+		source = decoder;
+		playFrame = SDL_max(startFrame, (Sint64)0);
+		if (playFrame > 0)
+			source->seek(playFrame);
+		clearRing();
+		sourceEnded = false;
+	}
+	feederWake.notify_one();
+
+	stretcher->clear();
+	finished = false;
+	sourcePosition = playFrame;
+
+	//Mix_HookMusic locks the audio, so the audio thread sees everything above
+	Mix_HookMusic(mixPipeline, nullptr);
+	return true;
+}
+
+/*
+* Moves the playing decoder to a frame, dropping what was decoded ahead
+*
+* @param frame, The frame to move to
+* @return bool, true if it moved
+*/
+bool AudioPipeline::seek(Sint64 frame) {
+	if (source == nullptr || finished) return false;
+
+	//Once unhooked the audio thread is done with the ring
+	Mix_HookMusic(nullptr, nullptr);
+
+	bool moved;
+	{
+		std::lock_guard<std::mutex> lock(decoderMutex);
+		moved = source->seek(SDL_max(frame, (Sint64)0));
+		if (moved)
+			playFrame = SDL_max(frame, (Sint64)0);
+		clearRing();
+		sourceEnded = false;
+	}
+	feederWake.notify_one();
+
+	stretcher->clear();
+	sourcePosition = playFrame;
+
+	Mix_HookMusic(mixPipeline, nullptr);
+	return moved;
+}
+
+/*
+* Stops the playing decoder, deleting it
+* Like Mix_HaltMusic, stopping a decoder that was still playing calls the finished hook
+*/
+void AudioPipeline::stop() {
+	if (source == nullptr) return;
+
+	//Once unhooked the audio thread is done with the source
+	Mix_HookMusic(nullptr, nullptr);
+
+	bool wasPlaying = !finished;
+	{
+		//Waits for the feeder to finish reading it
+		std::lock_guard<std::mutex> lock(decoderMutex);
+		delete source;
+		source = nullptr;
+		clearRing();
+		sourceEnded = true;
+	}
+	sourcePosition = -1;
+	finished = true;
+
+	if (wasPlaying && finishedHook != nullptr)
+		finishedHook();
+}
+
+/*
+* Sets a function to call when a chunk stops playing
+* NOTE: It may be called on the audio thread
+*
+* @param finished, The function to call, nullptr to remove it
+*/
+void AudioPipeline::hookFinished(void (SDLCALL *finished)()) {
+	//Swapped while unhooked so the audio thread can't be calling the old one
+	Decoder* playing = source;
+	if (playing != nullptr)
+		Mix_HookMusic(nullptr, nullptr);
+
+	finishedHook = finished;
+
+	if (playing != nullptr)
+		Mix_HookMusic(mixPipeline, nullptr);
+}
+
+
+/*
+* Sets the speed and pitch of the playback, picked up by the next callback
+*
+* @param speed, How fast the audio plays (0.5 - 2), 1 is unchanged
+* @param pitch, How much the pitch is raised (0.5 - 2), 1 is unchanged
+*/
+void AudioPipeline::setRate(float speed, float pitch) {
+	targetSpeed = SDL_min(SDL_max(speed, TimeStretcher::MIN_RATE), TimeStretcher::MAX_RATE);
+	targetPitch = SDL_min(SDL_max(pitch, TimeStretcher::MIN_RATE), TimeStretcher::MAX_RATE);
+}
+
+/*
+* Pauses / Resumes the playback
+*
+* @param pause, Should the playback be paused
+*/
+void AudioPipeline::setPaused(bool pause) { paused = pause; }
+
+/*
+* Sets the volume of the playback
+*
+* @param newVolume, The volume (0 - MIX_MAX_VOLUME)
+*/
+void AudioPipeline::setVolume(int newVolume) { volume = SDL_min(SDL_max(newVolume, 0), MIX_MAX_VOLUME); }
+
+
+/*
+* Gets the frame of the decoder being played
+* NOTE: Safe to call from the audio thread
+*
+* @return Sint64, The frame, -1 if nothing is playing
+*/
+Sint64 AudioPipeline::getSourceFrame() { return sourcePosition.load(std::memory_order_relaxed); }
+
+/*
+* Gets the amount of decoded frames waiting in the ring
+*
+* @return int, The amount of frames
+*/
+int AudioPipeline::getBufferedFrames() {
+	return (int)(ringWritten.load(std::memory_order_acquire) - ringRead.load(std::memory_order_acquire));
+}
+
+/*
+* Gets the amount of callbacks the ring ran dry in before the song ended
+*
+* @return Uint32, The amount of starvations
+*/
+Uint32 AudioPipeline::getStarvations() { return starvations.load(std::memory_order_relaxed); }
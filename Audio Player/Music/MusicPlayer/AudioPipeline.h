@@ -0,0 +1,57 @@
+#pragma once
+
+#include "SDL.h"
+#include "SDL_mixer.h"
+
+#include "Music/MusicDecoder/Decoder.h"
+
+/*
+* Plays songs through our own decoders using SDL_mixer's music hook, instead of letting SDL_mixer decode them
+* A feeder thread reads the decoder into a ring buffer, the audio thread only ever reads the ring
+* The audio is passed through stages (time-stretching, pitch shifting) on the audio thread before it is mixed
+* Only one track plays through the pipeline at a time, and it replaces any Mix_Music while it plays
+*/
+namespace AudioPipeline {
+	//Sets up the pipeline for the opened audio device
+	bool init();
+
+	//Stops the pipeline
+	void close();
+
+	//Checks if the pipeline is set up
+	bool loaded();
+
+	//Plays an opened decoder from a frame, taking ownership of it
+	bool play(Decoder* decoder, Sint64 startFrame);
+
+	//Moves the playing decoder to a frame
+	bool seek(Sint64 frame);
+
+	//Stops the playing decoder, deleting it
+	void stop();
+
+	//Sets a function to call when a decoder stops playing, like Mix_HookMusicFinished
+	void hookFinished(void (SDLCALL *finished)());
+
+	/// Setters
+
+	//Sets the speed and pitch of the playback, 1 is unchanged
+	void setRate(float speed, float pitch);
+
+	//Pauses / Resumes the playback
+	void setPaused(bool);
+
+	//Sets the volume (0 - MIX_MAX_VOLUME)
+	void setVolume(int);
+
+	/// Getters
+
+	//Gets the frame of the decoder being played, -1 if nothing is playing
+	Sint64 getSourceFrame();
+
+	//Gets the amount of decoded frames waiting in the ring
+	int getBufferedFrames();
+
+	//Gets the amount of callbacks the ring ran dry in before the song ended
+	Uint32 getStarvations();
+};
@@ -0,0 +1,290 @@
+#include "AudioStats.h"
+#include "AudioEvents.h"
+
+#include <atomic>
+#include <fstream>
+#include <iostream>
+
+#include "SDL_mixer.h"
+#include "SDL_assert.h"
+
+//A callback this much later than expected (in percent) counts as an underrun
+#define UNDERRUN_PERCENT 150
+
+static bool statsLoaded = false;
+
+//The histograms written to by the audio thread
+static Histogram durations;
+static Histogram intervals;
+static Histogram jitter;
+static Histogram queueDepths;
+
+static std::atomic<Uint32> underruns(0);
+static std::atomic<Uint32> expectedPeriod(0);
+
+//The size of one sample frame of the opened device
+static int bytesPerFrame = 4;
+static int frequency = 44100;
+
+//Only touched by the audio thread
+static bool inCallback = false;
+static Uint64 callbackStart = 0;
+static Uint64 previousCallbackStart = 0;
+
+//Dumping to the log file
+static std::string logPath = "AudioStats.log";
+static Uint32 dumpInterval = 10000;
+static Uint32 lastDump = 0;
+
+
+/*
+* Converts performance counter ticks to microseconds
+*
+* @param ticks, The amount of ticks
+* @return Uint32, The ticks in microseconds
+*/
+static Uint32 ticksToMicroseconds(Uint64 ticks) {
+	return (Uint32)(ticks * 1000000 / SDL_GetPerformanceFrequency());
+}
+
+/*
+* Formats a histogram into a single line
+*
+* @param name, The name of the histogram
+* @param histogram, The histogram to format
+* @return std::string, The formatted line
+*/
+static std::string formatHistogram(const char* name, const Histogram& histogram) {
+	char line[128];
+	SDL_snprintf(line, sizeof(line), "%s mean %.0f p50 %u p99 %u max %u",
+		name,
+		histogram.getMean(),
+		histogram.getPercentile(0.5f),
+		histogram.getPercentile(0.99f),
+		histogram.getMax()
+	);
+	return line;
+}
+
+
+/*
+* Starts tracking the audio thread
+*
+* @return bool, true if the stats are being tracked
+*/
+bool AudioStats::init() {
+	SDL_assert(!loaded());
+	if (loaded()) return true;
+
+	//Uses the format of the opened device to work out the expected period
+	Uint16 format;
+	int channels;
+	if (Mix_QuerySpec(&frequency, &format, &channels) == 0) {
+		std::cout << "AudioStats: Audio is not open " << Mix_GetError() << std::endl;
+		return false;
+	}
+	bytesPerFrame = SDL_AUDIO_BITSIZE(format) / 8 * channels;
+
+	reset();
+	lastDump = SDL_GetTicks();
+
+	statsLoaded = true;
+	return statsLoaded;
+}
+
+/*
+* Stops tracking the audio thread, dumping the final stats
+*/
+void AudioStats::close() {
+	SDL_assert(loaded());
+	if (!loaded()) return;
+
+	dumpToLog();
+	statsLoaded = false;
+}
+
+/*
+* Checks if the audio stats are being tracked
+*
+* @return bool, true if the stats are being tracked
+*/
+bool AudioStats::loaded() { return statsLoaded; }
+
+
+/*
+* Marks the start of the work done inside a mixer callback
+* Calling this more than once per callback only keeps the first call
+* NOTE: Audio thread only
+*/
+void AudioStats::callbackBegin() {
+	if (inCallback) return;
+
+	inCallback = true;
+	callbackStart = SDL_GetPerformanceCounter();
+}
+
+/*
+* Marks the end of a mixer callback, recording it into the histograms
+* The duration is only recorded when the start was marked, SDL_mixer has no hook before it mixes a Mix_Music
+* NOTE: Audio thread only
+*
+* @param bytes, The amount of bytes the callback mixed
+* @param queueDepth, The amount of tracks queued in the player
+*/
+void AudioStats::callbackEnd(int bytes, int queueDepth) {
+	Uint64 now = SDL_GetPerformanceCounter();
+	if (inCallback)
+		durations.record(ticksToMicroseconds(now - callbackStart));
+	else
+		callbackStart = now;
+	inCallback = false;
+
+	queueDepths.record(queueDepth < 0 ? 0 : queueDepth);
+
+	//The time this callback should have taken to arrive
+	Uint32 period = (Uint32)((Uint64)bytes * 1000000 / bytesPerFrame / frequency);
+	expectedPeriod.store(period, std::memory_order_relaxed);
+
+	//The first callback has nothing to compare to
+	if (previousCallbackStart != 0) {
+		Uint32 interval = ticksToMicroseconds(callbackStart - previousCallbackStart);
+		intervals.record(interval);
+		jitter.record(interval > period ? interval - period : period - interval);
+
+		//The device ran dry if the callback arrived far later than it should have
+		if ((Uint64)interval * 100 > (Uint64)period * UNDERRUN_PERCENT) {
+			underruns.fetch_add(1, std::memory_order_relaxed);
+			AudioEvents::post(AudioEventType::Underrun, -1, interval);
+		}
+	}
+	previousCallbackStart = callbackStart;
+}
+
+
+/*
+* Dumps the stats to the log file when the dump interval has passed
+*/
+void AudioStats::update() {
+	if (!loaded() || dumpInterval == 0) return;
+
+	Uint32 now = SDL_GetTicks();
+	if (now - lastDump >= dumpInterval) {
+		dumpToLog();
+		lastDump = now;
+	}
+}
+
+/*
+* Writes the current stats to the log file
+*
+* @return bool, true if the stats were written
+*/
+bool AudioStats::dumpToLog() {
+	std::ofstream log(logPath, std::ios::app);
+	if (!log.is_open()) {
+		std::cout << "AudioStats: Could not open " << logPath << std::endl;
+		return false;
+	}
+
+	log << "[" << SDL_GetTicks() << " ms]\n";
+	for (const std::string& line : getSummary())
+		log << "\t" << line << "\n";
+
+	//Also writes the raw buckets so the distribution can be plotted
+	log << "\tinterval buckets";
+	for (int i = 0; i < Histogram::BUCKET_COUNT; i++)
+		log << " " << intervals.getBucket(i);
+	log << "\n";
+
+	return log.good();
+}
+
+/*
+* Clears all the recorded stats
+*/
+void AudioStats::reset() {
+	durations.reset();
+	intervals.reset();
+	jitter.reset();
+	queueDepths.reset();
+	underruns.store(0, std::memory_order_relaxed);
+}
+
+
+/*
+* Sets the file the stats are dumped to
+*
+* @param path, The path to the log file
+*/
+void AudioStats::setLogPath(std::string path) { logPath = path; }
+
+/*
+* Sets how often the stats are dumped
+*
+* @param interval, The time between dumps in ms, 0 disables dumping
+*/
+void AudioStats::setDumpInterval(Uint32 interval) { dumpInterval = interval; }
+
+
+/*
+* Gets the time spent inside the callbacks
+*
+* @return const Histogram&, Durations in microseconds
+*/
+const Histogram& AudioStats::getDurations() { return durations; }
+
+/*
+* Gets the time between callbacks
+*
+* @return const Histogram&, Intervals in microseconds
+*/
+const Histogram& AudioStats::getIntervals() { return intervals; }
+
+/*
+* Gets how far the time between callbacks was from the expected period
+*
+* @return const Histogram&, Jitter in microseconds
+*/
+const Histogram& AudioStats::getJitter() { return jitter; }
+
+/*
+* Gets the amount of tracks queued in the player during each callback
+*
+* @return const Histogram&, The queue depths
+*/
+const Histogram& AudioStats::getQueueDepths() { return queueDepths; }
+
+/*
+* Gets the amount of callbacks that came too late to keep the device fed
+*
+* @return Uint32, The amount of underruns
+*/
+Uint32 AudioStats::getUnderruns() { return underruns.load(std::memory_order_relaxed); }
+
+/*
+* Gets the period a callback is expected to arrive in
+*
+* @return Uint32, The period in microseconds, 0 before the first callback
+*/
+Uint32 AudioStats::getExpectedPeriod() { return expectedPeriod.load(std::memory_order_relaxed); }
+
+/*
+* Gets the stats as human readable lines
+*
+* @return std::vector<std::string>, One line per stat
+*/
+std::vector<std::string> AudioStats::getSummary() {
+	std::vector<std::string> summary;
+
+	char line[128];
+	SDL_snprintf(line, sizeof(line), "callbacks %u underruns %u period %u us",
+		intervals.getCount(), getUnderruns(), getExpectedPeriod());
+	summary.push_back(line);
+
+	summary.push_back(formatHistogram("duration us", durations));
+	summary.push_back(formatHistogram("interval us", intervals));
+	summary.push_back(formatHistogram("jitter us", jitter));
+	summary.push_back(formatHistogram("queue depth", queueDepths));
+
+	return summary;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "SDL.h"
+#include "Instrumentation/Histogram.h"
+
+/*
+* Tracks the health of the audio thread
+* Every mixer callback is timestamped, the audio thread only ever writes to lock-free histograms
+*/
+namespace AudioStats {
+	//Starts tracking the audio thread
+	bool init();
+
+	//Stops tracking the audio thread
+	void close();
+
+	//Checks if the audio stats are being tracked
+	bool loaded();
+
+	/// Audio thread
+
+	//Marks the start of the work done inside a mixer callback
+	void callbackBegin();
+
+	//Marks the end of a mixer callback
+	void callbackEnd(int bytes, int queueDepth);
+
+	/// Main thread
+
+	//Dumps the stats to the log file when the dump interval has passed
+	void update();
+
+	//Writes the current stats to the log file
+	bool dumpToLog();
+
+	//Clears all the recorded stats
+	void reset();
+
+	/// Setters
+
+	//Sets the file the stats are dumped to
+	void setLogPath(std::string);
+
+	//Sets how often the stats are dumped (ms), 0 disables dumping
+	void setDumpInterval(Uint32);
+
+	/// Getters
+
+	//Gets the time spent inside the callbacks that marked their start (us)
+	const Histogram& getDurations();
+
+	//Gets the time between callbacks (us)
+	const Histogram& getIntervals();
+
+	//Gets how far the time between callbacks was from the expected period (us)
+	const Histogram& getJitter();
+
+	//Gets the amount of tracks queued in the player during each callback
+	const Histogram& getQueueDepths();
+
+	//Gets the amount of callbacks that came too late to keep the device fed
+	Uint32 getUnderruns();
+
+	//Gets the period a callback is expected to arrive in (us)
+	Uint32 getExpectedPeriod();
+
+	//Gets the stats as human readable lines
+	std::vector<std::string> getSummary();
+};
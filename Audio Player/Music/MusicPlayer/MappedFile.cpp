@@ -0,0 +1,321 @@
+#include "MappedFile.h"
+
+#include <cstring>
+#include <vector>
+
+#include "SDL_assert.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//How much of the file is prefetched ahead of the read position
+#define PREFETCH_WINDOW (256 * 1024)
+
+/*
+* The state behind a memory mapped SDL_RWops
+*/
+struct MappedFileData {
+	//The start of the mapping
+	const Uint8* base;
+	//The size of the file
+	Sint64 size;
+	//The current read position
+	Sint64 position;
+	//Everything before this has been prefetched
+	Sint64 prefetchedTo;
+#ifdef _WIN32
+	HANDLE mapping;
+#endif
+};
+
+
+/*
+* Asks the OS to start reading in a range of the mapping
+*
+* @param data, The mapped file
+* @param start, The offset to start prefetching from
+* @param length, The amount of bytes to prefetch
+*/
+static void prefetchRange(MappedFileData* data, Sint64 start, Sint64 length) {
+	if (start >= data->size) return;
+	if (start + length > data->size) length = data->size - start;
+
+#ifdef _WIN32
+	WIN32_MEMORY_RANGE_ENTRY range;
+	range.VirtualAddress = (PVOID)(data->base + start);
+	range.NumberOfBytes = (SIZE_T)length;
+	PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+	//madvise needs a page aligned address
+	long pageSize = sysconf(_SC_PAGESIZE);
+	Sint64 alignedStart = start - start % pageSize;
+	madvise((void*)(data->base + alignedStart), (size_t)(length + start - alignedStart), MADV_WILLNEED);
+#endif
+	data->prefetchedTo = start + length;
+}
+
+/*
+* Unmaps the file
+*
+* @param data, The mapped file
+*/
+static void unmap(MappedFileData* data) {
+#ifdef _WIN32
+	UnmapViewOfFile(data->base);
+	CloseHandle(data->mapping);
+#else
+	munmap((void*)data->base, (size_t)data->size);
+#endif
+}
+
+
+/*
+* Gets the size of the mapped file
+*
+* @param context, The RWops
+* @return Sint64, The size in bytes
+*/
+static Sint64 SDLCALL mappedSize(SDL_RWops* context) {
+	MappedFileData* data = (MappedFileData*)context->hidden.unknown.data1;
+	return data->size;
+}
+
+/*
+* Seeks within the mapped file
+*
+* @param context, The RWops
+* @param offset, The offset to seek by
+* @param whence, Where the offset is from (RW_SEEK_SET, RW_SEEK_CUR, RW_SEEK_END)
+* @return Sint64, The new position, -1 on error
+*/
+static Sint64 SDLCALL mappedSeek(SDL_RWops* context, Sint64 offset, int whence) {
+	MappedFileData* data = (MappedFileData*)context->hidden.unknown.data1;
+
+	Sint64 position;
+	switch (whence) {
+	case RW_SEEK_SET:
+		position = offset;
+		break;
+	case RW_SEEK_CUR:
+		position = data->position + offset;
+		break;
+	case RW_SEEK_END:
+		position = data->size + offset;
+		break;
+	default:
+		return SDL_SetError("MappedFile: Unknown value for 'whence'");
+	}
+
+	//Keeps the position within the file
+	if (position < 0) position = 0;
+	if (position > data->size) position = data->size;
+
+	//Jumping outside of the prefetched area restarts the prefetching there
+	if (position > data->prefetchedTo || position + PREFETCH_WINDOW < data->prefetchedTo)
+		prefetchRange(data, position, PREFETCH_WINDOW);
+
+	data->position = position;
+	return position;
+}
+
+/*
+* Reads from the mapped file
+*
+* @param context, The RWops
+* @param ptr, Filled with the data read
+* @param size, The size of each object
+* @param maxnum, The maximum amount of objects to read
+* @return size_t, The amount of objects read
+*/
+static size_t SDLCALL mappedRead(SDL_RWops* context, void* ptr, size_t size, size_t maxnum) {
+	MappedFileData* data = (MappedFileData*)context->hidden.unknown.data1;
+	if (size == 0) return 0;
+
+	//Only reads whole objects
+	size_t available = (size_t)(data->size - data->position) / size;
+	size_t count = (maxnum < available ? maxnum : available);
+
+	std::memcpy(ptr, data->base + data->position, count * size);
+	data->position += count * size;
+
+	//Prefetches the next window once the reader is halfway through the current one
+	if (data->position + PREFETCH_WINDOW / 2 >= data->prefetchedTo)
+		prefetchRange(data, data->prefetchedTo, PREFETCH_WINDOW);
+
+	return count;
+}
+
+/*
+* Writing is not supported, the mapping is read-only
+*
+* @return size_t, Always 0
+*/
+static size_t SDLCALL mappedWrite(SDL_RWops*, const void*, size_t, size_t) {
+	SDL_SetError("MappedFile: Mapped files are read-only");
+	return 0;
+}
+
+/*
+* Closes the mapped file
+*
+* @param context, The RWops
+* @return int, Always 0
+*/
+static int SDLCALL mappedClose(SDL_RWops* context) {
+	if (context == nullptr) return 0;
+
+	MappedFileData* data = (MappedFileData*)context->hidden.unknown.data1;
+	unmap(data);
+	delete data;
+
+	SDL_FreeRW(context);
+	return 0;
+}
+
+
+/*
+* Opens a file as a memory mapped SDL_RWops
+*
+* @param path, The path to the file (UTF-8)
+* @return SDL_RWops*, The RWops, nullptr if the file could not be mapped
+*/
+SDL_RWops* MappedFile::openRW(std::string path) {
+	MappedFileData* data = new MappedFileData();
+
+#ifdef _WIN32
+	//Converts the path to a wide string for the unicode API
+	int length = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, NULL, 0);
+	std::wstring widePath(length > 0 ? length : 1, L'\0');
+	MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &widePath[0], length);
+
+	HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+		OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file == INVALID_HANDLE_VALUE) {
+		delete data;
+		return nullptr;
+	}
+
+	LARGE_INTEGER fileSize;
+	data->mapping = NULL;
+	if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+		data->mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	//The mapping keeps the file open
+	CloseHandle(file);
+
+	if (data->mapping == NULL) {
+		delete data;
+		return nullptr;
+	}
+
+	data->size = fileSize.QuadPart;
+	data->base = (const Uint8*)MapViewOfFile(data->mapping, FILE_MAP_READ, 0, 0, 0);
+	if (data->base == nullptr) {
+		CloseHandle(data->mapping);
+		delete data;
+		return nullptr;
+	}
+#else
+	int file = open(path.c_str(), O_RDONLY);
+	if (file == -1) {
+		delete data;
+		return nullptr;
+	}
+
+	struct stat fileInfo;
+	void* mapping = MAP_FAILED;
+	if (fstat(file, &fileInfo) == 0 && fileInfo.st_size > 0)
+		mapping = mmap(NULL, (size_t)fileInfo.st_size, PROT_READ, MAP_SHARED, file, 0);
+	//The mapping keeps the file open
+	::close(file);
+
+	if (mapping == MAP_FAILED) {
+		delete data;
+		return nullptr;
+	}
+
+	data->size = fileInfo.st_size;
+	data->base = (const Uint8*)mapping;
+
+	//Tracks are decoded front to back
+	madvise(mapping, (size_t)data->size, MADV_SEQUENTIAL);
+#endif
+
+	//Starts reading in the beginning of the file
+	data->position = 0;
+	data->prefetchedTo = 0;
+	prefetchRange(data, 0, PREFETCH_WINDOW);
+
+	SDL_RWops* context = SDL_AllocRW();
+	if (context == nullptr) {
+		unmap(data);
+		delete data;
+		return nullptr;
+	}
+
+	context->size = mappedSize;
+	context->seek = mappedSeek;
+	context->read = mappedRead;
+	context->write = mappedWrite;
+	context->close = mappedClose;
+	context->type = SDL_RWOPS_UNKNOWN;
+	context->hidden.unknown.data1 = data;
+
+	return context;
+}
+
+/*
+* Pulls the start of a file into the OS cache so opening it later doesn't touch the disk
+* NOTE: Blocks until the data has been read, run it on a background thread
+*
+* @param path, The path to the file (UTF-8)
+* @param bytes, The amount of bytes from the start of the file to prefetch
+* @return bool, true if the file was prefetched
+*/
+bool MappedFile::prefetch(std::string path, Sint64 bytes) {
+	SDL_assert(bytes > 0);
+	if (bytes <= 0) return false;
+
+#ifdef _WIN32
+	int length = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, NULL, 0);
+	std::wstring widePath(length > 0 ? length : 1, L'\0');
+	MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &widePath[0], length);
+
+	HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+		OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file == INVALID_HANDLE_VALUE) return false;
+
+	//Reading through the cache manager leaves the data in the system cache
+	std::vector<char> buffer(1024 * 1024);
+	DWORD read = 0;
+	Sint64 total = 0;
+	while (total < bytes && ReadFile(file, buffer.data(), (DWORD)buffer.size(), &read, NULL) && read > 0)
+		total += read;
+
+	CloseHandle(file);
+	return total > 0;
+#else
+	int file = open(path.c_str(), O_RDONLY);
+	if (file == -1) return false;
+
+	//Hints the kernel to start reading, then blocks until it has
+	bool prefetched = (posix_fadvise(file, 0, (off_t)bytes, POSIX_FADV_WILLNEED) == 0);
+#ifdef __linux__
+	prefetched = (readahead(file, 0, (size_t)bytes) == 0) || prefetched;
+#endif
+
+	::close(file);
+	return prefetched;
+#endif
+}
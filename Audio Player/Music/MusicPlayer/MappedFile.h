@@ -0,0 +1,17 @@
+#pragma once
+
+#include <string>
+
+#include "SDL.h"
+
+/*
+* Memory maps files so SDL can stream them without buffered stdio reads
+* The mapping is read-only and shared, so every open track shares the page cache
+*/
+namespace MappedFile {
+	//Opens a file as a memory mapped SDL_RWops, nullptr on error
+	SDL_RWops* openRW(std::string path);
+
+	//Pulls the start of a file into the OS cache, blocks until it has been read
+	bool prefetch(std::string path, Sint64 bytes);
+};
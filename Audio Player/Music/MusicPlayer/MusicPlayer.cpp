@@ -1,44 +1,642 @@
 
 #include <random>
 #include "MusicPlayer.h"
+#include "AudioStats.h"
+#include "AudioEvents.h"
+#include "AudioPipeline.h"
+#include "TimeStretcher.h"
+#include "SilenceAnalyzer.h"
+#include "MappedFile.h"
+#include "Prefetcher.h"
+#include "SnippetCache.h"
+#include "Speculator.h"
 #include "Globals/Globals.h"
+#include "Globals/Worker.h"
 
+#include <atomic>
+#include <deque>
 #include <iostream>
+#include <map>
+#include <mutex>
 
 #include "Music/MusicLoader/MusicLoader.h"
+#include "Music/MusicDecoder/Decoder.h"
+
+//How often the audio thread reports the playback position (ms)
+#define POSITION_TICK_MS 250
+//The least trailing silence worth advancing early for (ms)
+#define MIN_TRAILING_SILENCE_MS 500
 
 static float volume = 0.2;
-static bool paused = false;	//Paused
+static std::atomic<bool> paused(false);	//Paused, read by the audio thread
 static int songOn = 0;
 
 //Gets the playing songs ID
 static int currentSongID = -1;
 
+//The random song that will be played next, rolled ahead of time so it can be prefetched
+static int nextRandomSongID = -1;
+
+/*
+* A loaded track, and the serial it was played under
+*/
+struct LoadedMusic {
+	Mix_Music* song;
+	int serial;
+};
+
 static std::vector<Mix_Chunk*>* audio = nullptr;
-static std::vector<Mix_Music*>* music = nullptr;
+static std::vector<LoadedMusic>* music = nullptr;
 static std::vector<std::string>* previousSongPaths = nullptr;	//Stores all the previous paths
 
+//The amount of tracks held by the player, read by the audio thread
+static std::atomic<int> queuedTracks(0);
+
+//Every played track gets a new serial so events can't be mistaken for a later track
+static int trackSerialGenerator = 0;
+static int currentTrackSerial = -1;
+//Is the current track playing through the pipeline
+static bool currentDecoded = false;
+//The serial of the track handed to the mixer, read by the audio thread
+static std::atomic<int> playingSerial(-1);
+
+//The format of the opened device
+static int frequency = 44100;
+static int bytesPerFrame = 4;
+
+//The frame a restarted song was started from, read by the audio thread
+static std::atomic<Sint64> startFrame(0);
+
+//Updated from the audio threads position ticks
+static Sint64 positionMs = 0;
+static Uint32 lastUnderrunTicks = 0;
+
+//How songs are picked when one finishes
+static PlayMode playMode = PlayMode::Shuffle;
+static std::deque<int>* playQueue = nullptr;	//Song IDs queued by the user
+
+//How far into a song (ms) before the next one is prepared
+static Uint32 prepareThreshold = 10000;
 
 /*
-* Loads the song from a file
-* 
-* @param file, The location of the song
-* @return Mix_Chunk*, A "chunk" of the musics audio
+* A track decoded by the worker, ready to play once the current one finishes
 */
-static Mix_Chunk* loadSong(std::string file) {
-	return Mix_LoadWAV(file.c_str());
-}
+struct PreparedTrack {
+	//The serial of the track it follows
+	int afterSerial;
+	std::string path;
+	//nullptr until the worker has opened it
+	Decoder* decoder;
+};
+
+//Shared with the worker thread
+static std::mutex preparedMutex;
+static PreparedTrack prepared = { -1, "", nullptr };
+static std::vector<Decoder*> staleTracks;	//Tracks no longer needed, deleted on the main thread
+
+/*
+* The playing song being opened on the worker, to carry on in the pipeline once its speed / pitch is changed
+*/
+struct StretchedTrack {
+	//The serial of the track it takes over from
+	int serial;
+	std::string path;
+	//nullptr until the worker has opened it, or if it couldn't be
+	Decoder* decoder;
+	//Set once the worker is done with it
+	bool done;
+};
+
+//Shared with the worker thread, under the prepared mutex
+static StretchedTrack stretching = { -1, "", nullptr, false };
+
+//The serial the following track was last prepared for
+static int preparingSerial = -1;
+
+static Uint32 preparedAdvances = 0;
+static Uint32 coldAdvances = 0;
+
+//The speed / pitch of each song, songs not in here play unchanged
+static std::map<int, PlaybackRate> songRates;
+
+//Skips the silence at the start / end of songs
+static bool skipSilence = true;
+//The serial of the track that was last advanced from early
+static int earlyAdvanceSerial = -1;
+static Sint64 silenceSkippedMs = 0;
+
 
 /*
 * Loads the music from a file
+* The file is memory mapped and streamed from the mapping while it plays
 *
 * @param file, The location of the music
 * @return Mix_Music*, The music from the file
 */
 static Mix_Music* loadMusic(std::string file) {
-	return Mix_LoadMUS(file.c_str());
+	SDL_RWops* mapped = MappedFile::openRW(file);
+
+	//Falls back to SDL's own file reading if the file can't be mapped
+	if (mapped == nullptr)
+		return Mix_LoadMUS(file.c_str());
+
+	//Uses the extension like Mix_LoadMUS does, as not every MP3 starts with a recognizable header
+	std::string extension = file.substr(file.find_last_of('.') + 1);
+	Mix_MusicType type = (SDL_strcasecmp(extension.c_str(), "mp3") == 0 ? MUS_MP3 : MUS_NONE);
+
+	//The mapping is closed along with the music
+	return Mix_LoadMUSType_RW(mapped, type, 1);
+}
+
+/*
+* Gets a song from the library
+*
+* @param songID, The ID of the song
+* @return const SongData*, The song, nullptr if it isn't in the library
+*/
+static const SongData* getSong(int songID) {
+	const std::vector<SongData>* songs = MusicLoader::getSongData();
+	if (songID < 0 || songID >= (int)songs->size()) return nullptr;
+	return &songs->at(songID);
+}
+
+/*
+* Gets where a song should start from, after its leading silence
+*
+* @param songID, The ID of the song
+* @return Sint64, The start in ms, 0 if it hasn't been analyzed
+*/
+static Sint64 getTrimmedStart(int songID) {
+	const SongData* song = getSong(songID);
+	if (!skipSilence || song == nullptr || !song->getAnalyzed()) return 0;
+	return song->getSoundStart();
+}
+
+/*
+* Finds the silence in a song in the background, if it hasn't been found yet
+*
+* @param songID, The ID of the song
+*/
+static void analyzeSong(int songID) {
+	const SongData* song = getSong(songID);
+	if (song != nullptr && !song->getAnalyzed())
+		SilenceAnalyzer::analyze(songID, song->getPath());
+}
+
+/*
+* Gets the speed / pitch a song plays at
+*
+* @param songID, The ID of the song
+* @return PlaybackRate, The rate of the song
+*/
+static PlaybackRate lookupSongRate(int songID) {
+	auto found = songRates.find(songID);
+	if (found == songRates.end())
+		return { 1, 1 };
+	return found->second;
+}
+
+/*
+* Checks if a song has its speed / pitch changed, so it has to play through the pipeline
+*
+* @param songID, The ID of the song
+* @return bool, true if the song is stretched
+*/
+static bool getSongStretched(int songID) {
+	return songRates.find(songID) != songRates.end();
+}
+
+/*
+* Checks if a song should be decoded by us and played through the pipeline straight away
+* Backends that decode the whole song up front are left to SDL_mixer's streaming, so starting a song never stalls the main thread
+* Stretched songs in those formats are moved into the pipeline once the worker has decoded them
+*
+* @param format, The songs format
+* @return bool, true if the song should be decoded
+*/
+static bool getSongDecoded(DecoderFormat format) {
+	return AudioPipeline::loaded() && Decoders::getStreams(format);
+}
+
+/*
+* Picks a random song from the library
+*
+* @return int, The ID of the song, -1 if the library is empty
+*/
+static int rollRandomSongID() {
+	//Gets the songs
+	const std::vector<SongData>* songs = MusicLoader::getSongData();
+	if (songs->empty()) return -1;
+
+	//Uniform randomness
+	std::random_device rd;
+	std::mt19937 gen(rd());
+	std::uniform_int_distribution<int> distribution(0, (int)songs->size() - 1);
+
+	return songs->at(distribution(gen)).getID();
+}
+
+/*
+* Gets the song after another in the library
+*
+* @param songID, The ID of the song
+* @return int, The ID of the following song, -1 if the library is empty
+*/
+static int getListOrderSongID(int songID) {
+	const std::vector<SongData>* songs = MusicLoader::getSongData();
+	if (songs->empty()) return -1;
+
+	for (size_t i = 0; i < songs->size(); i++) {
+		if (songs->at(i).getID() == songID)
+			return songs->at((i + 1) % songs->size()).getID();
+	}
+	//Starts from the top if the song isn't in the library
+	return songs->at(0).getID();
+}
+
+/*
+* Gets the song that follows the current one, without moving on to it
+*
+* @param finished, true if the current song finished on its own, false if it was skipped
+* @return int, The ID of the following song, -1 if there is none
+*/
+static int peekFollowingSongID(bool finished) {
+	//Moving forward through the previously played songs
+	if (songOn != 0)
+		return MusicLoader::getSongIDFromPath(previousSongPaths->at(songOn - 1));
+
+	switch (playMode) {
+	case PlayMode::Queue:
+		return (playQueue->empty() ? -1 : playQueue->front());
+	case PlayMode::ListOrder:
+		return getListOrderSongID(currentSongID);
+	case PlayMode::Repeat:
+		//Skipping still moves on through the library
+		if (finished && currentSongID != -1)
+			return currentSongID;
+		return getListOrderSongID(currentSongID);
+	default:
+		//Rolls the next random song ahead of time so it can be prefetched
+		if (nextRandomSongID == -1)
+			nextRandomSongID = rollRandomSongID();
+		return nextRandomSongID;
+	}
+}
+
+/*
+* Prefetches the song predicted to play next, and decodes its start
+*/
+static void prefetchNextSong() {
+	int nextSongID = MusicPlayer::getPredictedNextSongID();
+	if (nextSongID == -1) return;
+
+	std::string path = MusicLoader::getMusicPathFromID(nextSongID);
+	Prefetcher::prefetch(path);
+	SnippetCache::request(path);
+}
+
+/*
+* Runs on the audio thread after every mixer callback
+*
+* @param len, The length of the mixed audio in bytes
+*/
+static void SDLCALL postMix(void*, Uint8*, int len) {
+	//Only touched by the audio thread
+	static int countedSerial = -1;
+	static Sint64 playedFrames = 0;
+	static Sint64 lastTickFrame = 0;
+
+	//Restarts the count when a new track starts, from where it was started
+	int serial = playingSerial.load(std::memory_order_acquire);
+	if (serial != countedSerial) {
+		countedSerial = serial;
+		playedFrames = startFrame.load(std::memory_order_relaxed);
+		lastTickFrame = playedFrames;
+	}
+
+	//Counts the frames played, reporting the position every tick
+	if (serial != -1 && !paused.load(std::memory_order_relaxed)) {
+		//The pipeline moves through the song at its own speed
+		Sint64 pipelineFrame = AudioPipeline::getSourceFrame();
+		playedFrames = (pipelineFrame >= 0 ? pipelineFrame : playedFrames + len / bytesPerFrame);
+		if (playedFrames - lastTickFrame >= (Sint64)frequency * POSITION_TICK_MS / 1000) {
+			lastTickFrame = playedFrames;
+			AudioEvents::post(AudioEventType::PositionTick, serial, playedFrames * 1000 / frequency);
+		}
+	}
+
+	AudioStats::callbackEnd(len, queuedTracks.load(std::memory_order_relaxed));
 }
 
+/*
+* Runs when a track stops playing, either on the audio thread or inside Mix_HaltMusic
+* Only posts an event, the track is freed by the main loop
+*/
+static void SDLCALL musicFinished() {
+	AudioEvents::post(AudioEventType::TrackFinished, playingSerial.exchange(-1), 0);
+}
+
+/*
+* Starts loading the song that follows the current one on the worker thread
+* NOTE: Main thread only
+*/
+static void prepareFollowingTrack() {
+	int serial = currentTrackSerial;
+	preparingSerial = serial;
+
+	//Finds its silence before it starts
+	int songID = peekFollowingSongID(true);
+	analyzeSong(songID);
+
+	if (songID == -1 || !AudioPipeline::loaded()) return;
+	std::string path = MusicLoader::getMusicPathFromID(songID);
+
+	//Replaces the previous preparation
+	{
+		std::lock_guard<std::mutex> lock(preparedMutex);
+		if (prepared.decoder != nullptr)
+			staleTracks.push_back(prepared.decoder);
+		prepared = { serial, path, nullptr };
+	}
+
+	//Decodes it up front, however long that takes
+	Worker::submit([serial, path]() {
+		Decoder* decoder = Decoders::open(path);
+
+		std::lock_guard<std::mutex> lock(preparedMutex);
+		//Only keeps it if it's still wanted
+		if (prepared.afterSerial == serial && prepared.path == path && prepared.decoder == nullptr)
+			prepared.decoder = decoder;
+		else if (decoder != nullptr)
+			staleTracks.push_back(decoder);
+	});
+}
+
+/*
+* Takes the prepared track, if it was prepared for the song
+* Anything else that was prepared is thrown away
+* NOTE: Main thread only
+*
+* @param path, The path of the song about to play
+* @return Decoder*, The prepared track, nullptr if it wasn't ready
+*/
+static Decoder* takePreparedTrack(std::string path) {
+	std::lock_guard<std::mutex> lock(preparedMutex);
+
+	Decoder* decoder = nullptr;
+	if (prepared.decoder != nullptr) {
+		if (prepared.afterSerial == currentTrackSerial && prepared.path == path)
+			decoder = prepared.decoder;
+		else
+			staleTracks.push_back(prepared.decoder);
+	}
+
+	//A decode still running on the worker will be thrown away
+	prepared = { -1, "", nullptr };
+	return decoder;
+}
+
+/*
+* Opens the playing song on the worker, to move it into the pipeline once it's ready
+* It keeps playing through SDL_mixer until then, so decoding the whole song never stalls the main thread
+* NOTE: Main thread only
+*
+* @param path, The path of the playing song
+*/
+static void stretchPlayingTrack(std::string path) {
+	int serial = currentTrackSerial;
+	{
+		std::lock_guard<std::mutex> lock(preparedMutex);
+		if (stretching.serial == serial && stretching.path == path) return;
+
+		//Replaces the previous one, a decode still running is thrown away when it lands
+		if (stretching.decoder != nullptr)
+			staleTracks.push_back(stretching.decoder);
+		stretching = { serial, path, nullptr, false };
+	}
+
+	Worker::submit([serial, path]() {
+		Decoder* decoder = Decoders::open(path);
+
+		std::lock_guard<std::mutex> lock(preparedMutex);
+		if (stretching.serial == serial && stretching.path == path && !stretching.done) {
+			stretching.decoder = decoder;
+			stretching.done = true;
+		}
+		else if (decoder != nullptr)
+			staleTracks.push_back(decoder);
+	});
+}
+
+/*
+* Deletes the tracks the worker decoded that are no longer needed
+* NOTE: Main thread only
+*/
+static void freeStaleTracks() {
+	std::vector<Decoder*> tracks;
+	{
+		std::lock_guard<std::mutex> lock(preparedMutex);
+		tracks.swap(staleTracks);
+	}
+
+	for (Decoder* decoder : tracks)
+		delete decoder;
+}
+
+/*
+* Stops whatever is playing and hands out the serial for the next track
+* NOTE: Main thread only
+*
+* @param startMs, Where the next track starts from (ms)
+* @return int, The serial of the next track
+*/
+static int beginTrack(Sint64 startMs) {
+	//Unpauses when playing new song
+	paused = false;
+	AudioPipeline::setPaused(false);
+
+	Mix_HaltMusic();
+	AudioPipeline::stop();
+
+	//The audio thread starts counting under the new serial
+	int serial = trackSerialGenerator++;
+	startFrame = startMs * frequency / 1000;
+	playingSerial = serial;
+	return serial;
+}
+
+/*
+* Marks a track as the one playing
+* NOTE: Main thread only
+*
+* @param serial, The serial from beginTrack
+* @param file, The songs filepath
+* @param startMs, Where the track started from (ms)
+*/
+static void trackStarted(int serial, std::string file, Sint64 startMs) {
+	currentTrackSerial = serial;
+	currentDecoded = AudioPipeline::getSourceFrame() >= 0;
+	currentSongID = MusicLoader::getSongIDFromPath(file);
+	positionMs = startMs;
+
+	//Finds where its sound ends, if it wasn't found before it started
+	analyzeSong(currentSongID);
+
+	//Gets the next song ready while this one plays
+	prefetchNextSong();
+}
+
+/*
+* Plays a loaded track, taking ownership of it
+* NOTE: Main thread only
+*
+* @param song, The loaded track
+* @param file, The songs filepath
+* @param startMs, Where to start playing from (ms)
+* @return bool, true if the song was played
+*/
+static bool startSong(Mix_Music* song, std::string file, Sint64 startMs = 0) {
+	int serial = beginTrack(startMs);
+
+	//Attempts to play the song
+	if (Mix_PlayMusic(song, 0) == -1) {
+		printf("Mix_PlayChannel: %s\n", Mix_GetError());
+		playingSerial = -1;
+		Mix_FreeMusic(song);
+		return false;	//Returns 0 on failure
+	}
+	if (startMs > 0)
+		Mix_SetMusicPosition(startMs / 1000.0);
+
+	//Adds the audio to the list
+	music->push_back({ song, serial });
+	queuedTracks = (int)music->size();
+	trackStarted(serial, file, startMs);
+
+	return true;	//Returns 1 on success
+}
+
+/*
+* Plays an opened decoder through the pipeline, taking ownership of it
+* NOTE: Main thread only
+*
+* @param decoder, The opened decoder
+* @param file, The songs filepath
+* @param startMs, Where to start playing from (ms)
+* @return bool, true if the song was played
+*/
+static bool startDecodedSong(Decoder* decoder, std::string file, Sint64 startMs = 0) {
+	PlaybackRate rate = lookupSongRate(MusicLoader::getSongIDFromPath(file));
+	AudioPipeline::setRate(rate.speed, rate.pitch);
+
+	int serial = beginTrack(startMs);
+	if (!AudioPipeline::play(decoder, startMs * frequency / 1000)) {
+		playingSerial = -1;
+		delete decoder;
+		return false;
+	}
+
+	trackStarted(serial, file, startMs);
+	return true;
+}
+
+/*
+* Moves the playing song into the pipeline once the worker has opened it, carrying on from where it is
+* NOTE: Main thread only
+*/
+static void takeStretchedTrack() {
+	StretchedTrack track;
+	{
+		std::lock_guard<std::mutex> lock(preparedMutex);
+		if (!stretching.done) return;
+		track = stretching;
+		stretching = { -1, "", nullptr, false };
+	}
+	if (track.decoder == nullptr) return;
+
+	//The song moved on, or its speed / pitch was put back while it was being opened
+	if (track.serial != currentTrackSerial || currentDecoded || !getSongStretched(currentSongID)) {
+		delete track.decoder;
+		return;
+	}
+
+	bool wasPaused = MusicPlayer::getPaused();
+	if (startDecodedSong(track.decoder, track.path, positionMs) && wasPaused)
+		MusicPlayer::pauseMusic();
+}
+
+/*
+* Moves on to the song that follows the current one
+* NOTE: Main thread only
+*
+* @param finished, true if the current song finished on its own, false if it was skipped
+* @return bool, true if a song was played
+*/
+static bool advance(bool finished) {
+	int songID = peekFollowingSongID(finished);
+	if (songID == -1) return false;
+	std::string path = MusicLoader::getMusicPathFromID(songID);
+
+	//Moves past the song, even if it fails to play
+	bool fromHistory = (songOn != 0);
+	if (fromHistory)
+		songOn--;
+	else if (playMode == PlayMode::Queue)
+		playQueue->pop_front();
+	else if (playMode == PlayMode::Shuffle)
+		nextRandomSongID = -1;
+
+	//Uses the track the worker prepared, loading it here only if it wasn't ready
+	Decoder* decoder = takePreparedTrack(path);
+	if (finished && decoder != nullptr)
+		preparedAdvances++;
+	else if (finished)
+		coldAdvances++;
+
+	bool played = false;
+	if (decoder != nullptr) {
+		Sint64 startMs = getTrimmedStart(songID);
+		played = startDecodedSong(decoder, path, startMs);
+		if (played)
+			silenceSkippedMs += startMs;
+	}
+	else
+		played = MusicPlayer::playSong(path);
+
+	//Repeats aren't saved, the song is already at the front of the buffer
+	if (played && !fromHistory && !(finished && playMode == PlayMode::Repeat))
+		previousSongPaths->insert(previousSongPaths->begin(), path);
+
+	return played;
+}
+
+/*
+* Frees a track that finished playing
+* NOTE: Main thread only
+*
+* @param serial, The serial the track was played under
+*/
+static void freeTrack(int serial) {
+	//The current track is no longer playing
+	if (serial == currentTrackSerial) {
+		currentTrackSerial = -1;
+		currentDecoded = false;
+		currentSongID = -1;
+		positionMs = 0;
+	}
+
+	for (size_t i = 0; i < music->size(); i++) {
+		if (music->at(i).serial == serial) {
+			Mix_Music* song = music->at(i).song;
+			//Removes it from the list
+			music->erase(music->begin() + i);
+			queuedTracks = (int)music->size();
+			//Frees the song!
+			Mix_FreeMusic(song);
+			break;
+		}
+	}
+}
 
 
 /*
@@ -62,8 +660,26 @@ bool MusicPlayer::init() {
 	}
 
 	audio = new std::vector<Mix_Chunk*>();
-	music = new std::vector<Mix_Music*>();
+	music = new std::vector<LoadedMusic>();
 	previousSongPaths = new std::vector<std::string>();
+	playQueue = new std::deque<int>();
+
+	//Gets the format the device was opened with
+	Uint16 format;
+	int channels;
+	if (initialized && Mix_QuerySpec(&frequency, &format, &channels))
+		bytesPerFrame = SDL_AUDIO_BITSIZE(format) / 8 * channels;
+
+	//Timestamps every mixer callback
+	AudioStats::init();
+	Mix_SetPostMix(postMix, nullptr);
+
+	//Finished tracks are reported to the main loop
+	Mix_HookMusicFinished(musicFinished);
+
+	//Songs we decode play through the pipeline
+	if (initialized && AudioPipeline::init())
+		AudioPipeline::hookFinished(musicFinished);
 
 	return initialized;
 }
@@ -73,16 +689,100 @@ bool MusicPlayer::init() {
 */
 void MusicPlayer::close() {
 	haltMusic();
+
+	//Stops the audio thread from calling back
+	if (AudioPipeline::loaded())
+		AudioPipeline::close();
+	Mix_HookMusicFinished(nullptr);
+	Mix_SetPostMix(nullptr, nullptr);
+	if (AudioStats::loaded())
+		AudioStats::close();
+
+	//Frees every remaining track
+	update();
+	for (const LoadedMusic& loadedMusic : *music)
+		Mix_FreeMusic(loadedMusic.song);
+	music->clear();
+
+	//Frees the prepared track
+	takePreparedTrack("");
+	{
+		std::lock_guard<std::mutex> lock(preparedMutex);
+		if (stretching.decoder != nullptr)
+			staleTracks.push_back(stretching.decoder);
+		stretching = { -1, "", nullptr, false };
+	}
+	freeStaleTracks();
+	SnippetCache::clear();
+	Speculator::clear();
+
 	Mix_CloseAudio();
 }
 
+/*
+* Updates the Music Player, called once per frame
+*/
+void MusicPlayer::update() {
+	//Handles everything the audio thread posted since the last frame
+	AudioEvent event;
+	while (AudioEvents::poll(event)) {
+		switch (event.type) {
+		case AudioEventType::TrackFinished:
+			//Moves on when the current song finishes on its own
+			if (event.trackSerial == currentTrackSerial)
+				advance(true);
+			freeTrack(event.trackSerial);
+			break;
+		case AudioEventType::Underrun:
+			lastUnderrunTicks = SDL_GetTicks();
+			break;
+		case AudioEventType::PositionTick:
+			//Ignores ticks from tracks that have since been replaced
+			if (event.trackSerial == currentTrackSerial)
+				positionMs = event.value;
+			break;
+		default:
+			break;
+		}
+	}
+
+	//Stores the silence the worker found in the library
+	SilenceResult silence;
+	while (SilenceAnalyzer::poll(silence)) {
+		if (getSong(silence.songID) != nullptr)
+			MusicLoader::getSongDataMut()->at(silence.songID).setSoundBounds(silence.soundStartMs, silence.soundEndMs, silence.lengthMs);
+	}
+
+	//Moves on early once only silence is left
+	const SongData* song = getSong(currentSongID);
+	if (skipSilence && song != nullptr && song->getAnalyzed() && !paused && currentTrackSerial != earlyAdvanceSerial) {
+		bool trailingSilence = (song->getLength() - song->getSoundEnd() >= MIN_TRAILING_SILENCE_MS);
+		if (trailingSilence && song->getSoundEnd() > 0 && positionMs >= song->getSoundEnd()) {
+			earlyAdvanceSerial = currentTrackSerial;
+			silenceSkippedMs += SDL_max(song->getLength() - positionMs, (Sint64)0);
+			advance(true);
+		}
+	}
+
+	//Carries a stretched song on in the pipeline once it's been opened
+	takeStretchedTrack();
+
+	//Prepares the following song once far enough into the current one
+	if (currentTrackSerial != -1 && preparingSerial != currentTrackSerial && positionMs >= prepareThreshold)
+		prepareFollowingTrack();
+	freeStaleTracks();
+
+	//Periodically dumps the audio stats
+	AudioStats::update();
+}
+
 /*
 * 
 * @return true, The music player is loaded
 * @return false, The music player must be loaded
 */
 bool MusicPlayer::loaded() {
-	return audio != nullptr && music != nullptr && previousSongPaths != nullptr;
+	return audio != nullptr && music != nullptr && previousSongPaths != nullptr && playQueue != nullptr;
 }
 
 
@@ -104,6 +804,7 @@ bool MusicPlayer::setVolumeLinear(float newVolume) {
 	if (0 <= newVolume && newVolume <= 1) {
 		volume = newVolume;
 		changed = (Mix_VolumeMusic(MIX_MAX_VOLUME * volume) != -1);
+		AudioPipeline::setVolume((int)(MIX_MAX_VOLUME * volume));
 	}
 	return changed;
 }
@@ -122,6 +823,20 @@ float MusicPlayer::getVolume() { return volume; }
 */
 int MusicPlayer::getPlayingSongID() { return currentSongID; }
 
+/*
+* Gets how far into the current song the player is
+*
+* @return Sint64, The position in ms, 0 if nothing is playing
+*/
+Sint64 MusicPlayer::getPositionMs() { return positionMs; }
+
+/*
+* Gets when the audio thread last reported an underrun
+*
+* @return Uint32, The SDL_GetTicks() of the last underrun, 0 if there hasn't been one
+*/
+Uint32 MusicPlayer::getLastUnderrunTicks() { return lastUnderrunTicks; }
+
 /*
 * Plays the next song and saves it to the buffer
 * 
@@ -152,29 +867,54 @@ bool MusicPlayer::playSong(std::string file) {
 	SDL_assert(loaded());
 	if (!loaded()) return false;
 
-	//Unpauses when playing new song
-	paused = false;	
+	//Counts whether the song was prefetched in time
+	Prefetcher::recordPlay(file);
 
-	//Loads the song
-	Mix_Music* song = loadMusic(file);
+	//Starts after the leading silence
+	int songID = MusicLoader::getSongIDFromPath(file);
+	Sint64 startMs = getTrimmedStart(songID);
 
-	if (!song) {
-		printf((file + " had an error loading %s \n").c_str(), Mix_GetError());
-		return false;
-	}
+	DecoderFormat format = Decoders::sniff(file);
+	Decoder* decoder = nullptr;
 
-	Mix_HaltMusic();
-	//Attempts to play the song
-	if (Mix_PlayMusic(song, 0) == -1) {
-		printf("Mix_PlayChannel: %s\n", Mix_GetError());
-		return false;	//Returns 0 on failure
+	//Uses the decoder opened while the mouse rested on the song
+	if (AudioPipeline::loaded())
+		decoder = Speculator::take(file);
+
+	//Starts from the cached snippet while the rest is decoded in the background
+	if (decoder == nullptr && AudioPipeline::loaded() && !Decoders::getStreams(format))
+		decoder = SnippetCache::open(file, startMs * frequency / 1000);
+
+	//Streams through our own decoders where they're cheap to open
+	if (decoder == nullptr && getSongDecoded(format)) {
+		decoder = Decoders::open(file);
+		if (decoder == nullptr)
+			printf("%s had an error decoding, falling back to SDL_mixer\n", file.c_str());
 	}
 
-	//Adds the audio to the list
-	music->push_back(song);
-	currentSongID = MusicLoader::getSongIDFromPath(file);
+	bool played = false;
+	if (decoder != nullptr)
+		played = startDecodedSong(decoder, file, startMs);
 
-	return true;	//Returns 1 on success
+	if (!played) {
+		//Loads the song
+		Mix_Music* song = loadMusic(file);
+
+		if (!song) {
+			printf((file + " had an error loading %s \n").c_str(), Mix_GetError());
+			return false;
+		}
+
+		played = startSong(song, file, startMs);
+
+		//Moves into the pipeline to change its speed / pitch once the worker has decoded it
+		if (played && getSongStretched(songID) && AudioPipeline::loaded())
+			stretchPlayingTrack(file);
+	}
+
+	if (played)
+		silenceSkippedMs += startMs;
+	return played;
 }
 
 
@@ -212,16 +952,27 @@ bool MusicPlayer::playRandomSong() {
 	SDL_assert(loaded());
 	if (!loaded()) return false;
 	
-	//Gets the music paths
-	const std::vector<std::string>* musicPaths = MusicLoader::getMusicPaths();
+	//Uses the song that was rolled ahead of time
+	int songID = (nextRandomSongID != -1 ? nextRandomSongID : rollRandomSongID());
+	nextRandomSongID = -1;
+	if (songID == -1) return false;
 
-	//Uniform randomness
-	std::random_device rd;
-	std::mt19937 gen(rd());
-	std::uniform_int_distribution<int> distribution(0, musicPaths->size() - 1);
-	
 	//Plays the random song
-	return playSongSave(musicPaths->at(distribution(gen)));	
+	return playSongSave(songID);
+}
+
+/*
+* Gets the ID of the song that will play when skipping forward
+* Rolls the next random song if it hasn't been picked yet
+*
+* @return int, The ID of the next song, -1 if there is none
+*/
+int MusicPlayer::getPredictedNextSongID() {
+	//Ensures the music player is loaded before attempting
+	SDL_assert(loaded());
+	if (!loaded()) return -1;
+
+	return peekFollowingSongID(false);
 }
 
 /*
@@ -255,18 +1006,29 @@ bool MusicPlayer::playNextSong() {
 	SDL_assert(loaded());
 	if (!loaded()) return false;
 
-	bool played = false;
-	//If it played a previous song
-	if (songOn != 0) {	
-		songOn--;
-		//Skips the saving step
-		played = playSong(previousSongPaths->at(songOn));
-	} 
-	//If the song is not from the buffer
-	else {	
-		played = playRandomSong();	
-	}
-	return played;
+	//Follows the buffer, then the play mode
+	return advance(false);
+}
+
+/*
+* Adds a song to the end of the play queue
+*
+* @param songID, the identifying ID of the song
+* @return true, The song was queued
+* @return false, The song doesn't exist
+*/
+bool MusicPlayer::enqueueSong(int songID) {
+	//Ensures the music player is loaded before attempting
+	SDL_assert(loaded());
+	if (!loaded()) return false;
+
+	if (songID < 0 || songID >= (int)MusicLoader::getSongData()->size()) return false;
+
+	playQueue->push_back(songID);
+	//The following song may have changed
+	preparingSerial = -1;
+	prefetchNextSong();
+	return true;
 }
 
 
@@ -317,6 +1079,7 @@ void MusicPlayer::resumeMusic() {
 
 	paused = false;
 	Mix_ResumeMusic();
+	AudioPipeline::setPaused(false);
 }
 
 /*
@@ -328,29 +1091,176 @@ void MusicPlayer::pauseMusic() {
 
 	paused = true;
 	Mix_PauseMusic();
+	AudioPipeline::setPaused(true);
 }
 
 /*
 * Halts the players music
 */
 void MusicPlayer::haltMusic() {
+	//Stopped on purpose, so the finished track doesn't advance
+	currentTrackSerial = -1;
+	currentDecoded = false;
+	currentSongID = -1;
+	positionMs = 0;
+
 	Mix_HaltMusic();
+	AudioPipeline::stop();
+}
+
+
+/*
+* Sets how songs are picked when one finishes
+*
+* @param mode, The play mode to use
+*/
+void MusicPlayer::setPlayMode(PlayMode mode) {
+	playMode = mode;
+	//The following song may have changed
+	preparingSerial = -1;
+	if (loaded())
+		prefetchNextSong();
+}
+
+/*
+* Switches to the next play mode
+*/
+void MusicPlayer::cyclePlayMode() {
+	switch (playMode) {
+	case PlayMode::Shuffle:		setPlayMode(PlayMode::Queue); break;
+	case PlayMode::Queue:		setPlayMode(PlayMode::ListOrder); break;
+	case PlayMode::ListOrder:	setPlayMode(PlayMode::Repeat); break;
+	default:					setPlayMode(PlayMode::Shuffle); break;
+	}
 }
 
 /*
-* Deletes the music track
+* Sets the speed / pitch a song plays at, applying it straight away if it's playing
+* Songs playing through SDL_mixer are moved into the pipeline to change their speed / pitch
+*
+* @param songID, the identifying ID of the song
+* @param speed, How fast the song plays (0.5 - 2), 1 is unchanged
+* @param pitch, How much the pitch is raised (0.5 - 2), 1 is unchanged
+* @return true, The rate was set
+* @return false, The rate can't be changed
 */
-void MusicPlayer::deleteMusicTrack() {
+bool MusicPlayer::setSongRate(int songID, float speed, float pitch) {
 	//Ensures the music player is loaded before attempting
 	SDL_assert(loaded());
+	if (!loaded() || !AudioPipeline::loaded()) return false;
 
-	//Defaults the current songs ID to -1
-	currentSongID = -1;
+	speed = SDL_min(SDL_max(speed, TimeStretcher::MIN_RATE), TimeStretcher::MAX_RATE);
+	pitch = SDL_min(SDL_max(pitch, TimeStretcher::MIN_RATE), TimeStretcher::MAX_RATE);
+
+	if (SDL_fabs(speed - 1) < 0.001 && SDL_fabs(pitch - 1) < 0.001)
+		songRates.erase(songID);
+	else
+		songRates[songID] = { speed, pitch };
+
+	//Only the playing song needs updating
+	if (songID != currentSongID || currentTrackSerial == -1) return true;
+
+	//Already in the pipeline, it picks the new rate up on the next callback
+	if (currentDecoded) {
+		AudioPipeline::setRate(speed, pitch);
+		return true;
+	}
+
+	//Moves the song into the pipeline, carrying on from where it was
+	if (getSongStretched(songID)) {
+		std::string file = MusicLoader::getMusicPathFromID(songID);
+
+		//Formats that decode the whole song up front are opened on the worker
+		if (!Decoders::getStreams(Decoders::sniff(file))) {
+			stretchPlayingTrack(file);
+			return true;
+		}
+
+		bool wasPaused = getPaused();
+		Decoder* decoder = Decoders::open(file);
+		if (decoder != nullptr && startDecodedSong(decoder, file, positionMs) && wasPaused)
+			pauseMusic();
+	}
+	return true;
+}
+
+/*
+* Sets whether the silence at the start / end of songs is skipped
+*
+* @param skip, Should silence be skipped
+*/
+void MusicPlayer::setSkipSilence(bool skip) { skipSilence = skip; }
+
+/*
+* Sets how far into a song the next one is prepared
+* Lower prepares sooner, but wastes more loads when the user skips
+*
+* @param threshold, The position in ms
+*/
+void MusicPlayer::setPrepareThreshold(Uint32 threshold) { prepareThreshold = threshold; }
 
-	//Deletes the music
-	Mix_Music* song = music->at(0);
-	//Removes it from the list
-	music->erase(music->begin());
-	//Frees the song!
-	Mix_FreeMusic(song);
+/*
+* Gets how songs are picked when one finishes
+*
+* @return PlayMode, The play mode
+*/
+PlayMode MusicPlayer::getPlayMode() { return playMode; }
+
+/*
+* Gets the name of a play mode
+*
+* @param mode, The play mode
+* @return const char*, The name of the mode
+*/
+const char* MusicPlayer::getPlayModeName(PlayMode mode) {
+	switch (mode) {
+	case PlayMode::Shuffle:		return "Shuffle";
+	case PlayMode::Queue:		return "Queue";
+	case PlayMode::ListOrder:	return "List Order";
+	case PlayMode::Repeat:		return "Repeat";
+	}
+	return "Unknown";
 }
+
+/*
+* Gets the speed / pitch a song plays at
+*
+* @param songID, the identifying ID of the song
+* @return PlaybackRate, The rate of the song
+*/
+PlaybackRate MusicPlayer::getSongRate(int songID) { return lookupSongRate(songID); }
+
+/*
+* Checks if the silence at the start / end of songs is skipped
+*
+* @return bool, true if silence is skipped
+*/
+bool MusicPlayer::getSkipSilence() { return skipSilence; }
+
+/*
+* Gets the total amount of silence skipped
+*
+* @return Sint64, The silence skipped (ms)
+*/
+Sint64 MusicPlayer::getSilenceSkippedMs() { return silenceSkippedMs; }
+
+/*
+* Gets the amount of songs waiting in the play queue
+*
+* @return int, The amount of queued songs
+*/
+int MusicPlayer::getQueueLength() { return (playQueue != nullptr ? (int)playQueue->size() : 0); }
+
+/*
+* Gets the amount of auto advances that used the track prepared by the worker
+*
+* @return Uint32, The amount of prepared advances
+*/
+Uint32 MusicPlayer::getPreparedAdvances() { return preparedAdvances; }
+
+/*
+* Gets the amount of auto advances that had to load the track on the main thread
+*
+* @return Uint32, The amount of cold advances
+*/
+Uint32 MusicPlayer::getColdAdvances() { return coldAdvances; }
@@ -7,6 +7,29 @@
 
 #include "MusicPlayer.h"
 
+/*
+* How the player picks the song to play when one finishes
+*/
+enum class PlayMode {
+	//Random songs from the library
+	Shuffle,
+	//The songs queued by the user, stops when the queue is empty
+	Queue,
+	//The library in order, wrapping at the end
+	ListOrder,
+	//The same song again
+	Repeat,
+};
+
+/*
+* How fast a song plays, and how much its pitch is raised
+* 1 is unchanged
+*/
+struct PlaybackRate {
+	float speed;
+	float pitch;
+};
+
 
 /*
 * Plays music given, and stores previously played music
@@ -21,6 +44,9 @@ namespace MusicPlayer {
 	//Checks if the musicPlayer is loaded
 	bool loaded();
 
+	//Updates the music player, called once per frame
+	void update();
+
 	//Plays the song and also saves to the previous song buffer
 	bool playSongSave(std::string file);
 
@@ -42,6 +68,9 @@ namespace MusicPlayer {
 	//Plays the next song
 	bool playNextSong();
 
+	//Adds a song to the end of the play queue
+	bool enqueueSong(int songID);
+
 	//Plays the song from a position
 	void skipToPosition(double);
 
@@ -62,6 +91,21 @@ namespace MusicPlayer {
 	//Halts the music completely
 	void haltMusic();
 
+	//Sets how songs are picked when one finishes
+	void setPlayMode(PlayMode);
+
+	//Switches to the next play mode
+	void cyclePlayMode();
+
+	//Sets the speed / pitch a song plays at
+	bool setSongRate(int songID, float speed, float pitch);
+
+	//Sets whether the silence at the start / end of songs is skipped
+	void setSkipSilence(bool);
+
+	//Sets how far into a song (ms) the next one is prepared
+	void setPrepareThreshold(Uint32);
+
 	/// Getters 
 
 	//Checks if it's paused
@@ -73,6 +117,36 @@ namespace MusicPlayer {
 	//Gets the ID of the currently playing song
 	int getPlayingSongID();
 
-	//Deletes the most recent music trick
-	void deleteMusicTrack();
+	//Gets the ID of the song that will play next
+	int getPredictedNextSongID();
+
+	//Gets how far into the current song the player is (ms)
+	Sint64 getPositionMs();
+
+	//Gets when the audio thread last reported an underrun
+	Uint32 getLastUnderrunTicks();
+
+	//Gets how songs are picked when one finishes
+	PlayMode getPlayMode();
+
+	//Gets the name of a play mode
+	const char* getPlayModeName(PlayMode);
+
+	//Gets the speed / pitch a song plays at
+	PlaybackRate getSongRate(int songID);
+
+	//Checks if the silence at the start / end of songs is skipped
+	bool getSkipSilence();
+
+	//Gets the total amount of silence skipped (ms)
+	Sint64 getSilenceSkippedMs();
+
+	//Gets the amount of songs waiting in the play queue
+	int getQueueLength();
+
+	//Gets the amount of auto advances that used the prepared track
+	Uint32 getPreparedAdvances();
+
+	//Gets the amount of auto advances that had to load on the main thread
+	Uint32 getColdAdvances();
 };
@@ -0,0 +1,122 @@
+#include "Prefetcher.h"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+
+#include "MappedFile.h"
+#include "Globals/Worker.h"
+
+//How many prefetched tracks are remembered
+#define REMEMBERED_TRACKS 8
+
+//Prefetch the first 4MB by default
+static Sint64 prefetchSize = 4 * 1024 * 1024;
+
+//The tracks being prefetched, and the ones that are done (most recent first)
+static std::deque<std::string> pendingPaths;
+static std::deque<std::string> prefetchedPaths;
+static std::mutex pathsMutex;
+
+static Uint32 hits = 0;
+static Uint32 late = 0;
+static Uint32 misses = 0;
+
+
+/*
+* Checks if the path is in the list
+*
+* @param paths, The list to look through
+* @param path, The path to look for
+* @return bool, true if the path was found
+*/
+static bool contains(const std::deque<std::string>& paths, const std::string& path) {
+	return std::find(paths.begin(), paths.end(), path) != paths.end();
+}
+
+/*
+* Removes the path from the list
+*
+* @param paths, The list to remove from
+* @param path, The path to remove
+*/
+static void remove(std::deque<std::string>& paths, const std::string& path) {
+	paths.erase(std::remove(paths.begin(), paths.end(), path), paths.end());
+}
+
+/*
+* Prefetches the start of a track in the background
+* Tracks that are already prefetched, or being prefetched, are skipped
+*
+* @param path, The path to the track
+* @return bool, true if the track is (or will be) prefetched
+*/
+bool Prefetcher::prefetch(std::string path) {
+	if (path.empty() || !Worker::loaded()) return false;
+
+	{
+		std::lock_guard<std::mutex> lock(pathsMutex);
+		if (contains(pendingPaths, path) || contains(prefetchedPaths, path)) return true;
+		pendingPaths.push_back(path);
+	}
+
+	Sint64 bytes = prefetchSize;
+	return Worker::submit([path, bytes]() {
+		bool prefetched = MappedFile::prefetch(path, bytes);
+
+		std::lock_guard<std::mutex> lock(pathsMutex);
+		remove(pendingPaths, path);
+		if (prefetched) {
+			prefetchedPaths.push_front(path);
+			if (prefetchedPaths.size() > REMEMBERED_TRACKS)
+				prefetchedPaths.pop_back();
+		}
+	});
+}
+
+/*
+* Records that a track started playing
+* Counts whether it was prefetched in time, still being prefetched, or not prefetched
+*
+* @param path, The path to the track
+*/
+void Prefetcher::recordPlay(std::string path) {
+	std::lock_guard<std::mutex> lock(pathsMutex);
+
+	if (contains(prefetchedPaths, path))
+		hits++;
+	else if (contains(pendingPaths, path))
+		late++;
+	else
+		misses++;
+}
+
+/*
+* Sets how many bytes from the start of a track are prefetched
+*
+* @param bytes, The amount of bytes
+*/
+void Prefetcher::setPrefetchSize(Sint64 bytes) {
+	if (bytes > 0) prefetchSize = bytes;
+}
+
+/*
+* Gets the amount of plays that were prefetched in time
+*
+* @return Uint32, The amount of hits
+*/
+Uint32 Prefetcher::getHits() { return hits; }
+
+/*
+* Gets the amount of plays that were still being prefetched
+*
+* @return Uint32, The amount of late prefetches
+*/
+Uint32 Prefetcher::getLate() { return late; }
+
+/*
+* Gets the amount of plays that weren't prefetched
+*
+* @return Uint32, The amount of misses
+*/
+Uint32 Prefetcher::getMisses() { return misses; }
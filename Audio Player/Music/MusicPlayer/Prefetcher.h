@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+
+#include "SDL.h"
+
+/*
+* Reads the start of the track predicted to play next into the OS cache in the background
+* So switching tracks never waits on cold storage
+*/
+namespace Prefetcher {
+	//Prefetches the start of a track in the background
+	bool prefetch(std::string path);
+
+	//Records that a track started playing, counting whether it was prefetched
+	void recordPlay(std::string path);
+
+	/// Setters
+
+	//Sets how many bytes from the start of a track are prefetched
+	void setPrefetchSize(Sint64);
+
+	/// Getters
+
+	//Gets the amount of plays that were prefetched in time
+	Uint32 getHits();
+
+	//Gets the amount of plays that were still being prefetched
+	Uint32 getLate();
+
+	//Gets the amount of plays that weren't prefetched
+	Uint32 getMisses();
+};
@@ -0,0 +1,299 @@
+#include "SilenceAnalyzer.h"
+
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <vector>
+
+#include "SDL_mixer.h"
+#include "SDL_assert.h"
+
+#include "Globals/Worker.h"
+#include "Music/MusicDecoder/Decoder.h"
+
+//SSE2 is used for the RMS scan when the compiler targets it
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SILENCE_SSE2
+#include <emmintrin.h>
+#endif
+
+//The length of each window the RMS level is measured over (ms)
+#define WINDOW_MS 10
+//The frames decoded in one go
+#define DECODE_FRAMES 16384
+
+//Read by the worker thread
+static std::atomic<float> threshold(-60);
+static std::atomic<bool> useSIMD(SDL_HasSSE2() == SDL_TRUE);
+
+//Songs waiting on the worker, main thread only
+static std::vector<int> pendingSongs;
+
+//Shared with the worker thread
+static std::mutex resultMutex;
+static std::vector<SilenceResult> results;
+
+
+#ifdef SILENCE_SSE2
+/*
+* Sums the squares of 16 bit samples, 8 at a time
+* A pair of squares is at most 2^31, so each 32 bit lane is widened as unsigned and the sum is exact
+*
+* @param samples, The samples
+* @param count, The amount of samples
+* @return Uint64, The sum of squares
+*/
+static Uint64 sumSquaresSSE2(const Sint16* samples, int count) {
+	__m128i zero = _mm_setzero_si128();
+	__m128i total = _mm_setzero_si128();
+
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m128i loaded = _mm_loadu_si128((const __m128i*)(samples + i));
+		//Squares and adds neighbouring pairs into 4 32 bit lanes
+		__m128i squares = _mm_madd_epi16(loaded, loaded);
+		//Widens into 2 64 bit lanes so long windows can't overflow
+		total = _mm_add_epi64(total, _mm_unpacklo_epi32(squares, zero));
+		total = _mm_add_epi64(total, _mm_unpackhi_epi32(squares, zero));
+	}
+
+	Uint64 lanes[2];
+	_mm_storeu_si128((__m128i*)lanes, total);
+	Uint64 sum = lanes[0] + lanes[1];
+
+	//The leftover samples
+	for (; i < count; i++)
+		sum += (Uint64)((Sint32)samples[i] * samples[i]);
+	return sum;
+}
+#endif
+
+/*
+* Sums the squares of 16 bit samples
+*
+* @param samples, The samples
+* @param count, The amount of samples
+* @return Uint64, The sum of squares
+*/
+Uint64 SilenceAnalyzer::sumSquares(const Sint16* samples, int count) {
+#ifdef SILENCE_SSE2
+	if (useSIMD.load(std::memory_order_relaxed))
+		return sumSquaresSSE2(samples, count);
+#endif
+
+	Uint64 sum = 0;
+	for (int i = 0; i < count; i++)
+		sum += (Uint64)((Sint32)samples[i] * samples[i]);
+	return sum;
+}
+
+/*
+* Gets the level a window has to be louder than
+*
+* @return double, The threshold as a 16 bit amplitude
+*/
+static double getThresholdAmplitude() {
+	return 32768.0 * pow(10.0, threshold.load() / 20.0);
+}
+
+/*
+* Checks if a window is louder than the threshold
+* Compares sums of squares so the scan never takes a log
+*
+* @param samples, The samples in the window
+* @param count, The amount of samples, the last window may be shorter
+* @param amplitude, The threshold as a 16 bit amplitude
+* @return bool, true if the window isn't silent
+*/
+static bool getLoud(const Sint16* samples, int count, double amplitude) {
+	return (double)SilenceAnalyzer::sumSquares(samples, count) > amplitude * amplitude * count;
+}
+
+/*
+* Finds where the sound starts / ends in interleaved 16 bit audio
+* Scans windows in from each end until one is louder than the threshold
+*
+* @param samples, The interleaved samples
+* @param frames, The amount of frames
+* @param channels, The amount of channels
+* @param frequency, The sample rate
+* @return SilenceResult, The bounds (the songID is left as -1)
+*/
+SilenceResult SilenceAnalyzer::findSoundBounds(const Sint16* samples, int frames, int channels, int frequency) {
+	SDL_assert(channels > 0 && frequency > 0);
+
+	SilenceResult result = { -1, 0, 0, (int)((Sint64)frames * 1000 / frequency) };
+	int windowFrames = SDL_max(frequency * WINDOW_MS / 1000, 1);
+	int windows = (frames + windowFrames - 1) / windowFrames;
+
+	double amplitude = getThresholdAmplitude();
+	auto getWindowLoud = [&](int window) {
+		int start = window * windowFrames;
+		return getLoud(samples + (Sint64)start * channels, SDL_min(windowFrames, frames - start) * channels, amplitude);
+	};
+
+	//Scans in from the start
+	int first = 0;
+	while (first < windows && !getWindowLoud(first))
+		first++;
+
+	//All silent
+	if (first == windows)
+		return result;
+
+	//Scans in from the end
+	int last = windows - 1;
+	while (last > first && !getWindowLoud(last))
+		last--;
+
+	result.soundStartMs = (int)((Sint64)first * windowFrames * 1000 / frequency);
+	result.soundEndMs = (int)((Sint64)SDL_min((last + 1) * windowFrames, frames) * 1000 / frequency);
+	return result;
+}
+
+/*
+* Finds where the sound starts / ends while decoding a song
+* Each block is scanned as it's read, so only one block of the song is held at a time
+* Gives the same bounds as findSoundBounds on the whole song
+*
+* @param decoder, The opened decoder
+* @param channels, The amount of channels
+* @param frequency, The sample rate
+* @return SilenceResult, The bounds (the songID is left as -1)
+*/
+static SilenceResult scanDecoder(Decoder* decoder, int channels, int frequency) {
+	SDL_assert(channels > 0 && frequency > 0);
+
+	//Blocks are a whole amount of windows, so only the last window of the song can be short
+	int windowFrames = SDL_max(frequency * WINDOW_MS / 1000, 1);
+	int blockFrames = (DECODE_FRAMES / windowFrames + 1) * windowFrames;
+	std::vector<Sint16> block((size_t)blockFrames * channels);
+
+	double amplitude = getThresholdAmplitude();
+	Sint64 frames = 0, window = 0, first = -1, last = -1;
+	int filled;
+	do {
+		//Fills the block, backends may return less than asked for before the end
+		filled = 0;
+		int got;
+		while (filled < blockFrames && (got = decoder->readFrames(block.data() + (size_t)filled * channels, blockFrames - filled)) > 0)
+			filled += got;
+
+		for (int start = 0; start < filled; start += windowFrames, window++) {
+			if (getLoud(block.data() + (size_t)start * channels, SDL_min(windowFrames, filled - start) * channels, amplitude)) {
+				if (first < 0) first = window;
+				last = window;
+			}
+		}
+		frames += filled;
+	} while (filled == blockFrames);
+
+	SilenceResult result = { -1, 0, 0, (int)(frames * 1000 / frequency) };
+
+	//All silent
+	if (first < 0)
+		return result;
+
+	result.soundStartMs = (int)(first * windowFrames * 1000 / frequency);
+	result.soundEndMs = (int)(SDL_min((last + 1) * windowFrames, frames) * 1000 / frequency);
+	return result;
+}
+
+
+/*
+* Analyzes a song on the worker thread
+* Songs already being analyzed are skipped, and nothing is analyzed without the worker
+*
+* @param songID, The ID of the song
+* @param path, The path to the song
+* @return bool, true if the song is being analyzed
+*/
+bool SilenceAnalyzer::analyze(int songID, std::string path) {
+	//Without the worker the song plays through its silence
+	if (!Worker::loaded()) return false;
+
+	for (int pending : pendingSongs) {
+		if (pending == songID) return true;
+	}
+
+	bool submitted = Worker::submit([songID, path]() {
+		SilenceResult result = { songID, 0, 0, 0 };
+
+		//Scans the song in the format of the device as it's decoded
+		Decoder* decoder = Decoders::open(path);
+		int frequency, channels;
+		Uint16 format;
+		if (decoder != nullptr && Mix_QuerySpec(&frequency, &format, &channels)) {
+			result = scanDecoder(decoder, channels, frequency);
+			result.songID = songID;
+		}
+		delete decoder;
+
+		std::lock_guard<std::mutex> lock(resultMutex);
+		results.push_back(result);
+	});
+
+	if (submitted)
+		pendingSongs.push_back(songID);
+	return submitted;
+}
+
+/*
+* Takes a finished result
+* NOTE: Main thread only
+*
+* @param result, Filled with the result
+* @return bool, true if there was a result
+*/
+bool SilenceAnalyzer::poll(SilenceResult& result) {
+	std::lock_guard<std::mutex> lock(resultMutex);
+	if (results.empty()) return false;
+
+	result = results.front();
+	results.erase(results.begin());
+
+	//No longer pending
+	for (size_t i = 0; i < pendingSongs.size(); i++) {
+		if (pendingSongs[i] == result.songID) {
+			pendingSongs.erase(pendingSongs.begin() + i);
+			break;
+		}
+	}
+	return true;
+}
+
+
+/*
+* Sets the level below which audio counts as silent
+*
+* @param dBFS, The level in decibels relative to full scale (negative)
+*/
+void SilenceAnalyzer::setThreshold(float dBFS) { threshold = SDL_min(dBFS, 0.0f); }
+
+/*
+* Uses the SIMD scan when the CPU supports it
+* Turning it off is only useful to check it against the scalar version
+*
+* @param enabled, Should SIMD be used
+*/
+void SilenceAnalyzer::setUseSIMD(bool enabled) { useSIMD = enabled && SDL_HasSSE2(); }
+
+/*
+* Gets the level below which audio counts as silent
+*
+* @return float, The level in dBFS
+*/
+float SilenceAnalyzer::getThreshold() { return threshold.load(); }
+
+/*
+* Checks if the SIMD scan is being used
+*
+* @return bool, true if SIMD is used
+*/
+bool SilenceAnalyzer::getUseSIMD() {
+#ifdef SILENCE_SSE2
+	return useSIMD.load();
+#else
+	return false;
+#endif
+}
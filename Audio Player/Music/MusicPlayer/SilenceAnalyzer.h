@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+
+#include "SDL.h"
+
+/*
+* Where the sound in a song starts / ends
+*/
+struct SilenceResult {
+	int songID;
+	//Where the sound starts / ends (ms)
+	int soundStartMs;
+	int soundEndMs;
+	//The length of the song (ms), 0 if it couldn't be decoded
+	int lengthMs;
+};
+
+/*
+* Finds the silence at the start / end of songs on the worker thread
+* A window of audio counts as silent when its RMS level is below the threshold
+*/
+namespace SilenceAnalyzer {
+	//Analyzes a song in the background, the result is picked up with poll
+	bool analyze(int songID, std::string path);
+
+	//Takes a finished result, main thread only
+	bool poll(SilenceResult& result);
+
+	//Finds where the sound starts / ends in interleaved 16 bit audio
+	SilenceResult findSoundBounds(const Sint16* samples, int frames, int channels, int frequency);
+
+	//Sums the squares of 16 bit samples
+	Uint64 sumSquares(const Sint16* samples, int count);
+
+	/// Setters
+
+	//Sets the level below which audio counts as silent (dBFS)
+	void setThreshold(float);
+
+	//Uses the SIMD scan when the CPU supports it
+	void setUseSIMD(bool);
+
+	/// Getters
+
+	//Gets the level below which audio counts as silent (dBFS)
+	float getThreshold();
+
+	//Checks if the SIMD scan is being used
+	bool getUseSIMD();
+};
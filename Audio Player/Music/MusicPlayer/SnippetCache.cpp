@@ -0,0 +1,252 @@
+#include "SnippetCache.h"
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "SDL_mixer.h"
+
+#include "MappedFile.h"
+#include "Globals/Worker.h"
+#include "Music/MusicDecoder/MixerDecoder.h"
+#include "Music/MusicDecoder/SnippetDecoder.h"
+
+//How many snippets are kept
+#define CACHED_SNIPPETS 16
+//How much of the file is first decoded per second of snippet, enough for a 320kbps MP3
+#define SNIPPET_BYTES_PER_SECOND (40 * 1024)
+//The most of the file decoded for a snippet, enough to get past embedded cover art
+#define SNIPPET_MAX_FILE_BYTES (8 * 1024 * 1024)
+//Dropped from the end of a snippet cut short by the file, where the last frame may be incomplete (ms)
+#define TRUNCATION_GUARD_MS 100
+
+/*
+* The decoded start of a song
+*/
+struct Snippet {
+	std::string path;
+	std::shared_ptr<const std::vector<Sint16>> samples;
+};
+
+//Decode the first 2 seconds by default
+static int snippetMs = 2000;
+
+//The snippets being decoded, and the ones that are done (most recent first)
+static std::deque<std::string> pendingPaths;
+static std::deque<Snippet> snippets;
+static std::mutex snippetsMutex;
+
+static Uint32 hits = 0;
+static Uint32 misses = 0;
+
+
+/*
+* Decodes the start of a song into the format of the device
+* Only as much of the file as the snippet needs is handed to the codec, read in growing steps
+* A step that falls short (a low bitrate, cover art before the audio) doubles the amount read and decodes again
+* NOTE: Worker thread
+*
+* @param path, The path to the song
+* @param milliseconds, How much to decode
+* @return std::shared_ptr<const std::vector<Sint16>>, The interleaved frames, nullptr if nothing decoded
+*/
+static std::shared_ptr<const std::vector<Sint16>> decodeSnippet(std::string path, int milliseconds) {
+	int frequency, channels;
+	Uint16 format;
+	if (Mix_QuerySpec(&frequency, &format, &channels) == 0) return nullptr;
+
+	//Reads from the mapping, falling back to SDL's own file reading
+	SDL_RWops* file = MappedFile::openRW(path);
+	if (file == nullptr)
+		file = SDL_RWFromFile(path.c_str(), "rb");
+	if (file == nullptr) return nullptr;
+	Sint64 fileBytes = SDL_RWsize(file);
+
+	int wanted = (int)((Sint64)frequency * milliseconds / 1000);
+	std::vector<Sint16>* samples = new std::vector<Sint16>((size_t)wanted * channels);
+	int frames = 0;
+	bool truncated = true;
+
+	std::vector<Uint8> start;
+	size_t stepBytes = (size_t)SDL_max((Sint64)milliseconds * SNIPPET_BYTES_PER_SECOND / 1000, (Sint64)SNIPPET_BYTES_PER_SECOND);
+	while (frames < wanted && truncated && start.size() < SNIPPET_MAX_FILE_BYTES) {
+		//Reads on from where the last step stopped
+		size_t previous = start.size();
+		start.resize(SDL_min(SDL_max(stepBytes, previous * 2), (size_t)SNIPPET_MAX_FILE_BYTES));
+		size_t read = SDL_RWread(file, start.data() + previous, 1, start.size() - previous);
+		start.resize(previous + read);
+		truncated = (fileBytes > (Sint64)start.size());
+		if (read == 0) break;
+
+		//Decodes the start as if it were the whole file
+		MixerDecoder decoder("Snippet");
+		if (!decoder.openRW(SDL_RWFromConstMem(start.data(), (int)start.size()))) continue;
+		frames = decoder.readFrames(samples->data(), wanted);
+	}
+	SDL_RWclose(file);
+
+	//The file ran out before the snippet did
+	if (truncated && frames < wanted)
+		frames = SDL_max(frames - frequency * TRUNCATION_GUARD_MS / 1000, 0);
+	samples->resize((size_t)frames * channels);
+
+	if (frames == 0) {
+		delete samples;
+		return nullptr;
+	}
+	return std::shared_ptr<const std::vector<Sint16>>(samples);
+}
+
+/*
+* Finds a songs snippet
+* NOTE: Hold the snippets mutex
+*
+* @param path, The path to the song
+* @return std::deque<Snippet>::iterator, The snippet, end() if it isn't cached
+*/
+static std::deque<Snippet>::iterator findSnippet(const std::string& path) {
+	return std::find_if(snippets.begin(), snippets.end(), [&](const Snippet& snippet) { return snippet.path == path; });
+}
+
+
+/*
+* Decodes the start of a song in the background, ahead of other work on the worker
+* Songs already cached or being decoded are skipped, as are songs that are cheap to open
+*
+* @param path, The path to the song
+* @return bool, true if the snippet is (or will be) cached
+*/
+bool SnippetCache::request(std::string path) {
+	if (path.empty() || !Worker::loaded()) return false;
+	if (Decoders::getStreams(Decoders::sniff(path))) return false;
+
+	{
+		std::lock_guard<std::mutex> lock(snippetsMutex);
+		if (findSnippet(path) != snippets.end() || std::find(pendingPaths.begin(), pendingPaths.end(), path) != pendingPaths.end()) return true;
+		pendingPaths.push_back(path);
+	}
+
+	int milliseconds = snippetMs;
+	return Worker::submit([path, milliseconds]() {
+		std::shared_ptr<const std::vector<Sint16>> samples = decodeSnippet(path, milliseconds);
+
+		std::lock_guard<std::mutex> lock(snippetsMutex);
+		pendingPaths.erase(std::remove(pendingPaths.begin(), pendingPaths.end(), path), pendingPaths.end());
+		if (samples != nullptr) {
+			snippets.push_front({ path, samples });
+			//Forgets the least recently used
+			if (snippets.size() > CACHED_SNIPPETS)
+				snippets.pop_back();
+		}
+	}, JobPriority::High);
+}
+
+/*
+* Opens a song from its snippet, the full decoder is opened on the worker
+* Counts whether the song had a snippet
+*
+* @param path, The path to the song
+* @param startFrame, The frame the song starts from
+* @return Decoder*, The decoder owned by the caller, nullptr if it isn't cached or starts past the snippet
+*/
+Decoder* SnippetCache::open(std::string path, Sint64 startFrame) {
+	int frequency, channels;
+	Uint16 format;
+	if (Mix_QuerySpec(&frequency, &format, &channels) == 0) return nullptr;
+
+	std::shared_ptr<const std::vector<Sint16>> samples;
+	{
+		std::lock_guard<std::mutex> lock(snippetsMutex);
+		auto found = findSnippet(path);
+		if (found != snippets.end()) {
+			samples = found->samples;
+			//Moves it to the front as the most recently used
+			Snippet snippet = *found;
+			snippets.erase(found);
+			snippets.push_front(snippet);
+		}
+	}
+
+	if (samples == nullptr || startFrame >= (Sint64)samples->size() / channels) {
+		misses++;
+		return nullptr;
+	}
+
+	SnippetDecoder* decoder = new SnippetDecoder(samples, channels);
+	if (!decoder->open(path)) {
+		delete decoder;
+		misses++;
+		return nullptr;
+	}
+
+	hits++;
+	return decoder;
+}
+
+/*
+* Frees every snippet, playing songs keep theirs until they're done
+*/
+void SnippetCache::clear() {
+	std::lock_guard<std::mutex> lock(snippetsMutex);
+	snippets.clear();
+}
+
+/*
+* Sets how much of the start of a song is decoded
+*
+* @param milliseconds, The length of a snippet (ms)
+*/
+void SnippetCache::setSnippetLength(int milliseconds) {
+	if (milliseconds > 0) snippetMs = milliseconds;
+}
+
+/*
+* Checks if a songs snippet is cached
+*
+* @param path, The path to the song
+* @return bool, true if it's cached
+*/
+bool SnippetCache::getCached(std::string path) {
+	std::lock_guard<std::mutex> lock(snippetsMutex);
+	return findSnippet(path) != snippets.end();
+}
+
+/*
+* Gets the amount of cached snippets
+*
+* @return int, The amount of snippets
+*/
+int SnippetCache::getCachedCount() {
+	std::lock_guard<std::mutex> lock(snippetsMutex);
+	return (int)snippets.size();
+}
+
+/*
+* Gets the memory held by the snippets
+*
+* @return Sint64, The size of the samples in bytes
+*/
+Sint64 SnippetCache::getCachedBytes() {
+	std::lock_guard<std::mutex> lock(snippetsMutex);
+
+	Sint64 bytes = 0;
+	for (const Snippet& snippet : snippets)
+		bytes += (Sint64)(snippet.samples->size() * sizeof(Sint16));
+	return bytes;
+}
+
+/*
+* Gets the amount of plays that started from a snippet
+*
+* @return Uint32, The amount of hits
+*/
+Uint32 SnippetCache::getHits() { return hits; }
+
+/*
+* Gets the amount of plays that had no snippet
+*
+* @return Uint32, The amount of misses
+*/
+Uint32 SnippetCache::getMisses() { return misses; }
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string>
+
+#include "SDL.h"
+
+#include "Music/MusicDecoder/Decoder.h"
+
+/*
+* Keeps the pre-decoded first seconds of the songs likely to play next
+* So a song can start from memory straight away while its full decoder opens in the background
+*/
+namespace SnippetCache {
+	//Decodes the start of a song in the background
+	bool request(std::string path);
+
+	//Opens a song from its snippet, nullptr if it isn't cached or starts past it
+	Decoder* open(std::string path, Sint64 startFrame);
+
+	//Frees every snippet
+	void clear();
+
+	/// Setters
+
+	//Sets how much of the start of a song is decoded (ms)
+	void setSnippetLength(int);
+
+	/// Getters
+
+	//Checks if a songs snippet is cached
+	bool getCached(std::string path);
+
+	//Gets the amount of cached snippets
+	int getCachedCount();
+
+	//Gets the memory held by the snippets
+	Sint64 getCachedBytes();
+
+	//Gets the amount of plays that started from a snippet
+	Uint32 getHits();
+
+	//Gets the amount of plays that had no snippet
+	Uint32 getMisses();
+};
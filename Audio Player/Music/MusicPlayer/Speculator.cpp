@@ -0,0 +1,208 @@
+#include "Speculator.h"
+
+#include <mutex>
+
+#include "SnippetCache.h"
+#include "Globals/Worker.h"
+#include "Music/MusicLoader/MusicLoader.h"
+
+/*
+* The song being opened speculatively
+*/
+struct Speculation {
+	int songID;
+	std::string path;
+	//Bumped on every new speculation so stale jobs can tell they're no longer wanted
+	int generation;
+	//nullptr until the worker has opened it
+	Decoder* decoder;
+};
+
+//The mouse must rest on a song for 150ms by default
+static Uint32 dwell = 150;
+
+//Shared with the worker thread
+static std::mutex speculationMutex;
+static Speculation speculation = { -1, "", 0, nullptr };
+
+static Uint32 speculated = 0;
+static Uint32 hits = 0;
+static Uint32 late = 0;
+static Uint32 misses = 0;
+static Uint32 cancelled = 0;
+
+//The song a speculation was last taken for, so its click isn't counted as a miss
+static int takenSongID = -1;
+
+
+/*
+* Drops the current speculation
+* NOTE: Hold the speculation mutex
+*
+* @return bool, true if there was one
+*/
+static bool dropSpeculation() {
+	bool dropped = (speculation.songID != -1);
+
+	//A job still on the worker sees the new generation and deletes its decoder
+	delete speculation.decoder;
+	speculation = { -1, "", speculation.generation + 1, nullptr };
+	return dropped;
+}
+
+
+/*
+* Starts opening a song on the worker, replacing any other speculation
+* It waits behind every other job, as the song may never be clicked
+* Only formats that stream are opened, which reads just their headers, the rest only get their snippet decoded
+*
+* @param songID, The ID of the song
+* @return bool, true if the song is being opened
+*/
+bool Speculator::speculate(int songID) {
+	if (!Worker::loaded() || songID < 0 || songID >= (int)MusicLoader::getSongData()->size()) return false;
+	std::string path = MusicLoader::getMusicPathFromID(songID);
+
+	int generation;
+	{
+		std::lock_guard<std::mutex> lock(speculationMutex);
+		if (speculation.songID == songID) return true;
+		if (dropSpeculation())
+			cancelled++;
+
+		speculation.songID = songID;
+		speculation.path = path;
+		generation = speculation.generation;
+	}
+	speculated++;
+
+	SnippetCache::request(path);
+	return Worker::submit([generation, path]() {
+		//Skips the work if the mouse left before the job started
+		auto getWanted = [generation]() {
+			std::lock_guard<std::mutex> lock(speculationMutex);
+			return speculation.generation == generation;
+		};
+		if (!getWanted()) return;
+
+		//Opening a format that doesn't stream decodes the whole song, its snippet covers the click instead
+		if (!Decoders::getStreams(Decoders::sniff(path)) || !getWanted()) return;
+
+		Decoder* decoder = Decoders::open(path);
+
+		std::lock_guard<std::mutex> lock(speculationMutex);
+		if (speculation.generation == generation)
+			speculation.decoder = decoder;
+		else
+			delete decoder;
+	}, JobPriority::Low);
+}
+
+/*
+* Cancels the speculation for a song
+*
+* @param songID, The ID of the song the mouse left
+*/
+void Speculator::cancel(int songID) {
+	std::lock_guard<std::mutex> lock(speculationMutex);
+	if (speculation.songID != songID) return;
+
+	dropSpeculation();
+	cancelled++;
+}
+
+/*
+* Takes the speculatively opened decoder for a song
+* Counts whether the speculation was ready in time
+*
+* @param path, The path to the song about to play
+* @return Decoder*, The decoder owned by the caller, nullptr if it isn't ready
+*/
+Decoder* Speculator::take(std::string path) {
+	std::lock_guard<std::mutex> lock(speculationMutex);
+	if (speculation.songID == -1 || speculation.path != path) return nullptr;
+
+	//Songs that don't stream are ready once their snippet is
+	Decoder* decoder = speculation.decoder;
+	if (decoder != nullptr || SnippetCache::getCached(path))
+		hits++;
+	else
+		late++;
+	takenSongID = speculation.songID;
+
+	//The speculation is used up, a job still running is thrown away
+	speculation.decoder = nullptr;
+	dropSpeculation();
+	return decoder;
+}
+
+/*
+* Records a click on a song, after it has been played
+* Clicks on songs that were never speculated are misses, the mouse didn't rest long enough
+*
+* @param songID, The ID of the clicked song
+*/
+void Speculator::recordClick(int songID) {
+	if (songID != takenSongID)
+		misses++;
+	takenSongID = -1;
+}
+
+/*
+* Frees the speculation
+* NOTE: Main thread only
+*/
+void Speculator::clear() {
+	std::lock_guard<std::mutex> lock(speculationMutex);
+	dropSpeculation();
+}
+
+/*
+* Sets how long the mouse must rest on a song before it's speculated
+* Shorter dwells speculate sooner, but cancel more speculations as the mouse passes over songs
+*
+* @param milliseconds, The dwell (ms)
+*/
+void Speculator::setDwell(Uint32 milliseconds) { dwell = milliseconds; }
+
+/*
+* Gets how long the mouse must rest on a song before it's speculated
+*
+* @return Uint32, The dwell (ms)
+*/
+Uint32 Speculator::getDwell() { return dwell; }
+
+/*
+* Gets the amount of songs speculated
+*
+* @return Uint32, The amount of speculations
+*/
+Uint32 Speculator::getSpeculated() { return speculated; }
+
+/*
+* Gets the amount of clicks that started from a speculated decoder or snippet
+*
+* @return Uint32, The amount of hits
+*/
+Uint32 Speculator::getHits() { return hits; }
+
+/*
+* Gets the amount of clicks on a song still being speculated
+*
+* @return Uint32, The amount of late speculations
+*/
+Uint32 Speculator::getLate() { return late; }
+
+/*
+* Gets the amount of clicks on a song that wasn't speculated
+*
+* @return Uint32, The amount of misses
+*/
+Uint32 Speculator::getMisses() { return misses; }
+
+/*
+* Gets the amount of speculations cancelled before they were clicked
+*
+* @return Uint32, The amount of cancelled speculations
+*/
+Uint32 Speculator::getCancelled() { return cancelled; }
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+
+#include "SDL.h"
+
+#include "Music/MusicDecoder/Decoder.h"
+
+/*
+* Opens the song the mouse rests on in the background, before it's clicked
+* Only one song is speculated at a time, moving to another song or leaving it cancels the speculation
+*/
+namespace Speculator {
+	//Starts opening a song on the worker, the mouse has dwelled on it
+	bool speculate(int songID);
+
+	//Cancels the speculation for a song, the mouse has left it
+	void cancel(int songID);
+
+	//Takes the speculatively opened decoder for a song, nullptr if it isn't ready
+	Decoder* take(std::string path);
+
+	//Records a click on a song, counting whether it was speculated
+	void recordClick(int songID);
+
+	//Frees the speculation, main thread only
+	void clear();
+
+	/// Setters
+
+	//Sets how long the mouse must rest on a song before it's speculated (ms)
+	void setDwell(Uint32);
+
+	/// Getters
+
+	//Gets how long the mouse must rest on a song before it's speculated (ms)
+	Uint32 getDwell();
+
+	//Gets the amount of songs speculated
+	Uint32 getSpeculated();
+
+	//Gets the amount of clicks that started from a speculated decoder or snippet
+	Uint32 getHits();
+
+	//Gets the amount of clicks on a song still being speculated
+	Uint32 getLate();
+
+	//Gets the amount of clicks on a song that wasn't speculated
+	Uint32 getMisses();
+
+	//Gets the amount of speculations cancelled before they were clicked
+	Uint32 getCancelled();
+};
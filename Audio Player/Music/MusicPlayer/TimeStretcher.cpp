@@ -0,0 +1,350 @@
+#include "TimeStretcher.h"
+
+#include <cmath>
+
+#include "SDL_assert.h"
+
+//SSE is used for the correlation when the compiler targets it
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define TIMESTRETCH_SSE
+#include <xmmintrin.h>
+#endif
+
+//Lengths of the WSOLA windows (ms)
+#define SEQUENCE_MS 40
+#define OVERLAP_MS 8
+#define SEEK_MS 15
+
+static bool useSIMD = (SDL_HasSSE() == SDL_TRUE);
+
+
+/*
+* Multiplies two arrays together and sums the result
+*
+* @param a, The first array
+* @param b, The second array
+* @param count, The length of the arrays
+* @return float, The dot product
+*/
+static float dotScalar(const float* a, const float* b, int count) {
+	float sum = 0;
+	for (int i = 0; i < count; i++)
+		sum += a[i] * b[i];
+	return sum;
+}
+
+#ifdef TIMESTRETCH_SSE
+/*
+* Multiplies two arrays together and sums the result, 8 floats at a time
+*
+* @param a, The first array
+* @param b, The second array
+* @param count, The length of the arrays
+* @return float, The dot product
+*/
+static float dotSSE(const float* a, const float* b, int count) {
+	//Two accumulators to hide the latency of the adds
+	__m128 sum0 = _mm_setzero_ps();
+	__m128 sum1 = _mm_setzero_ps();
+
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+		sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+	}
+
+	//Adds the 4 lanes together
+	float lanes[4];
+	_mm_storeu_ps(lanes, _mm_add_ps(sum0, sum1));
+	float sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+
+	//The leftover floats
+	for (; i < count; i++)
+		sum += a[i] * b[i];
+	return sum;
+}
+#endif
+
+/*
+* Multiplies two arrays together and sums the result, using SIMD when enabled
+*
+* @param a, The first array
+* @param b, The second array
+* @param count, The length of the arrays
+* @return float, The dot product
+*/
+static float dot(const float* a, const float* b, int count) {
+#ifdef TIMESTRETCH_SSE
+	if (useSIMD)
+		return dotSSE(a, b, count);
+#endif
+	return dotScalar(a, b, count);
+}
+
+
+/*
+* Constructor
+*
+* @param channels, The amount of interleaved channels
+* @param sampleRate, The sample rate of the audio
+*/
+TimeStretcher::TimeStretcher(int channels, int sampleRate) {
+	SDL_assert(channels > 0 && sampleRate > 0);
+
+	this->channels = channels;
+	sequenceFrames = sampleRate * SEQUENCE_MS / 1000;
+	overlapFrames = sampleRate * OVERLAP_MS / 1000;
+	seekFrames = sampleRate * SEEK_MS / 1000;
+
+	//Enough input for the slowest resampling at the fastest speed
+	int skipFrames = (int)((sequenceFrames - overlapFrames) * MAX_RATE / MIN_RATE) + 2;
+	int requiredFrames = SDL_max(seekFrames + sequenceFrames, skipFrames);
+	input.resize((size_t)(requiredFrames + MAX_PUT_FRAMES) * channels);
+
+	midBuffer.resize((size_t)overlapFrames * channels);
+	stretched.resize((size_t)sequenceFrames * 2 * channels);
+	output.resize((size_t)(MAX_PUT_FRAMES + sequenceFrames) * 4 * channels);
+
+	speed = 1;
+	pitch = 1;
+	tempo = 1;
+	clear();
+}
+
+/*
+* Sets the speed and pitch, both clamped to MIN_RATE - MAX_RATE
+*
+* @param newSpeed, How fast the audio plays, 1 is unchanged
+* @param newPitch, How much the pitch is raised, 1 is unchanged
+*/
+void TimeStretcher::setRate(float newSpeed, float newPitch) {
+	speed = SDL_min(SDL_max(newSpeed, MIN_RATE), MAX_RATE);
+	pitch = SDL_min(SDL_max(newPitch, MIN_RATE), MAX_RATE);
+	//The resampling speeds the audio up by the pitch, so WSOLA makes up the rest
+	tempo = (double)speed / pitch;
+}
+
+/*
+* Throws away all buffered audio
+*/
+void TimeStretcher::clear() {
+	inputFrames = 0;
+	stretchedFrames = 0;
+	outputFrames = 0;
+	midValid = false;
+	skipFraction = 0;
+	resamplePosition = 0;
+}
+
+
+/*
+* Finds the offset where the input best continues the last sequence
+* Scores each offset by its correlation with the tail of the last sequence, normalized by the inputs energy
+*
+* @return int, The offset in frames
+*/
+int TimeStretcher::seekBestOverlap() const {
+	int count = overlapFrames * channels;
+
+	//The energy of the first candidate, slid along with the offset after
+	double norm = 0;
+	for (int i = 0; i < count; i++)
+		norm += (double)input[i] * input[i];
+
+	int bestOffset = 0;
+	double bestScore = -1e30;
+	for (int offset = 0; offset < seekFrames; offset++) {
+		const float* candidate = input.data() + (size_t)offset * channels;
+
+		double score = dot(midBuffer.data(), candidate, count) / std::sqrt(SDL_max(norm, 0.0) + 1e-9);
+		if (score > bestScore) {
+			bestScore = score;
+			bestOffset = offset;
+		}
+
+		//Moves the energy along by one frame
+		for (int c = 0; c < channels; c++) {
+			norm -= (double)candidate[c] * candidate[c];
+			norm += (double)candidate[count + c] * candidate[count + c];
+		}
+	}
+	return bestOffset;
+}
+
+/*
+* Stretches one sequence of the input
+* The start of the sequence is crossfaded with the tail of the last, the middle is copied, and the tail is kept for the next
+*/
+void TimeStretcher::processSequence() {
+	int offset = (midValid ? seekBestOverlap() : 0);
+	const float* source = input.data() + (size_t)offset * channels;
+	float* destination = stretched.data() + (size_t)stretchedFrames * channels;
+
+	int overlapCount = overlapFrames * channels;
+	int middleCount = (sequenceFrames - overlapFrames * 2) * channels;
+
+	//Crossfades into the new sequence
+	if (midValid) {
+		for (int frame = 0; frame < overlapFrames; frame++) {
+			float fadeIn = (float)frame / overlapFrames;
+			for (int c = 0; c < channels; c++) {
+				int i = frame * channels + c;
+				destination[i] = midBuffer[i] * (1 - fadeIn) + source[i] * fadeIn;
+			}
+		}
+	}
+	else {
+		SDL_memcpy(destination, source, overlapCount * sizeof(float));
+	}
+
+	//Copies the middle
+	SDL_memcpy(destination + overlapCount, source + overlapCount, middleCount * sizeof(float));
+
+	//Keeps the tail for the next crossfade
+	SDL_memcpy(midBuffer.data(), source + overlapCount + middleCount, overlapCount * sizeof(float));
+	midValid = true;
+
+	stretchedFrames += sequenceFrames - overlapFrames;
+
+	//Skips through the input at the tempo
+	skipFraction += (sequenceFrames - overlapFrames) * tempo;
+	int skip = (int)skipFraction;
+	skipFraction -= skip;
+
+	SDL_assert(skip <= inputFrames);
+	inputFrames -= skip;
+	SDL_memmove(input.data(), input.data() + (size_t)skip * channels, (size_t)inputFrames * channels * sizeof(float));
+}
+
+/*
+* Resamples the stretched audio into the output, changing the pitch
+*/
+void TimeStretcher::resample() {
+	float* destination = output.data() + (size_t)outputFrames * channels;
+
+	//Nothing to resample, copies it straight over
+	if (pitch == 1) {
+		SDL_memcpy(destination, stretched.data(), (size_t)stretchedFrames * channels * sizeof(float));
+		outputFrames += stretchedFrames;
+		stretchedFrames = 0;
+		resamplePosition = 0;
+		return;
+	}
+
+	//Linear interpolation between the frames either side of the position
+	while (resamplePosition + 1 < stretchedFrames) {
+		int frame = (int)resamplePosition;
+		float fraction = (float)(resamplePosition - frame);
+		const float* from = stretched.data() + (size_t)frame * channels;
+
+		for (int c = 0; c < channels; c++)
+			destination[c] = from[c] + (from[channels + c] - from[c]) * fraction;
+
+		destination += channels;
+		outputFrames++;
+		resamplePosition += pitch;
+	}
+
+	//Drops the frames the resampler has moved past
+	int consumed = SDL_min((int)resamplePosition, stretchedFrames);
+	stretchedFrames -= consumed;
+	resamplePosition -= consumed;
+	SDL_memmove(stretched.data(), stretched.data() + (size_t)consumed * channels, (size_t)stretchedFrames * channels * sizeof(float));
+}
+
+
+/*
+* Puts frames in to be stretched, and stretches as much as possible
+*
+* @param frames, The interleaved frames
+* @param frameCount, The amount of frames, no more than getInputSpace()
+*/
+void TimeStretcher::putSamples(const float* frames, int frameCount) {
+	SDL_assert(frameCount <= getInputSpace());
+	frameCount = SDL_min(frameCount, getInputSpace());
+
+	SDL_memcpy(input.data() + (size_t)inputFrames * channels, frames, (size_t)frameCount * channels * sizeof(float));
+	inputFrames += frameCount;
+
+	int skipFrames = (int)((sequenceFrames - overlapFrames) * tempo) + 2;
+	int requiredFrames = SDL_max(seekFrames + sequenceFrames, skipFrames);
+	//The most frames a single sequence can produce after resampling
+	int sequenceOutput = (int)((sequenceFrames - overlapFrames) / MIN_RATE) + 2;
+	int outputCapacity = (int)(output.size() / channels);
+
+	//Stretches while there is enough input, and room for what it produces
+	while (inputFrames >= requiredFrames && outputFrames + sequenceOutput <= outputCapacity) {
+		processSequence();
+		resample();
+	}
+}
+
+/*
+* Takes stretched frames out
+*
+* @param frames, Filled with the interleaved frames
+* @param maxFrames, The most frames to take
+* @return int, The amount of frames taken
+*/
+int TimeStretcher::receiveSamples(float* frames, int maxFrames) {
+	int count = SDL_min(maxFrames, outputFrames);
+
+	SDL_memcpy(frames, output.data(), (size_t)count * channels * sizeof(float));
+	outputFrames -= count;
+	SDL_memmove(output.data(), output.data() + (size_t)count * channels, (size_t)outputFrames * channels * sizeof(float));
+
+	return count;
+}
+
+
+/*
+* Gets the amount of frames that can be put in right now
+*
+* @return int, The amount of frames
+*/
+int TimeStretcher::getInputSpace() const {
+	return SDL_min((int)(input.size() / channels) - inputFrames, MAX_PUT_FRAMES);
+}
+
+/*
+* Gets the amount of frames ready to be received
+*
+* @return int, The amount of frames
+*/
+int TimeStretcher::getOutputFrames() const { return outputFrames; }
+
+/*
+* Gets the speed
+*
+* @return float, How fast the audio plays, 1 is unchanged
+*/
+float TimeStretcher::getSpeed() const { return speed; }
+
+/*
+* Gets the pitch
+*
+* @return float, How much the pitch is raised, 1 is unchanged
+*/
+float TimeStretcher::getPitch() const { return pitch; }
+
+
+/*
+* Uses the SIMD correlation when the CPU supports it
+* Turning it off is only useful to compare against the scalar version
+*
+* @param enabled, Should SIMD be used
+*/
+void TimeStretcher::setUseSIMD(bool enabled) { useSIMD = enabled && SDL_HasSSE(); }
+
+/*
+* Checks if the SIMD correlation is being used
+*
+* @return bool, true if SIMD is used
+*/
+bool TimeStretcher::getUseSIMD() {
+#ifdef TIMESTRETCH_SSE
+	return useSIMD;
+#else
+	return false;
+#endif
+}
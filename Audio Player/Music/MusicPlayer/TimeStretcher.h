@@ -0,0 +1,100 @@
+#pragma once
+
+#include <vector>
+
+#include "SDL.h"
+
+/*
+* Changes the speed and pitch of interleaved float audio independently
+* The speed is changed with WSOLA (waveform similarity overlap-add), the pitch by resampling the stretched audio
+* Buffers are allocated up front so putting / receiving never allocates, making it safe to use on the audio thread
+*/
+class TimeStretcher {
+public:
+	//The most frames that can be put in at once
+	static const int MAX_PUT_FRAMES = 4096;
+
+	//The range the speed and pitch are clamped to
+	static constexpr float MIN_RATE = 0.5f;
+	static constexpr float MAX_RATE = 2.0f;
+private:
+	int channels;
+
+	//The length of each sequence copied from the input
+	int sequenceFrames;
+	//The length of the crossfade between sequences
+	int overlapFrames;
+	//How far ahead the best crossfade position is searched for
+	int seekFrames;
+
+	float speed;
+	float pitch;
+	//The speed WSOLA runs at, so the resampling brings it back to the speed asked for
+	double tempo;
+	//The fraction of a frame left over after skipping input
+	double skipFraction;
+
+	//Input waiting to be stretched
+	std::vector<float> input;
+	int inputFrames;
+
+	//The tail of the last sequence, crossfaded into the next
+	std::vector<float> midBuffer;
+	bool midValid;
+
+	//Stretched audio waiting to be resampled
+	std::vector<float> stretched;
+	int stretchedFrames;
+	//The position of the resampler within the stretched audio
+	double resamplePosition;
+
+	//Audio ready to be received
+	std::vector<float> output;
+	int outputFrames;
+
+	//Finds the offset where the input best continues the last sequence
+	int seekBestOverlap() const;
+
+	//Stretches one sequence of the input
+	void processSequence();
+
+	//Resamples the stretched audio into the output
+	void resample();
+public:
+	//Constructor
+	TimeStretcher(int channels, int sampleRate);
+
+	//Sets the speed and pitch, 1 is unchanged
+	void setRate(float speed, float pitch);
+
+	//Puts frames in to be stretched
+	void putSamples(const float* frames, int frameCount);
+
+	//Takes stretched frames out
+	int receiveSamples(float* frames, int maxFrames);
+
+	//Throws away all buffered audio
+	void clear();
+
+	/// Getters
+
+	//Gets the amount of frames that can be put in right now
+	int getInputSpace() const;
+
+	//Gets the amount of frames ready to be received
+	int getOutputFrames() const;
+
+	//Gets the speed
+	float getSpeed() const;
+
+	//Gets the pitch
+	float getPitch() const;
+
+	/// SIMD
+
+	//Uses the SIMD correlation when the CPU supports it
+	static void setUseSIMD(bool);
+
+	//Checks if the SIMD correlation is being used
+	static bool getUseSIMD();
+};